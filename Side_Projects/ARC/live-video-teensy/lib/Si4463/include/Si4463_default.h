@@ -1,67 +0,0 @@
-// AUTOGENERATED FILE
-// compileHeaders.py v1
-
-#ifndef H_RADIO_DEFAULT_CONFIG
-#define H_RADIO_DEFAULT_CONFIG
-
-// Original file: 422Mc110_2GFSK_100000U.h
-// Register values generated using Silicon Labs WDS (Copyright 2017 Silicon Laboratories, Inc.)
-
-// INPUT DATA
-/*
-// Crys_freq(Hz): 30000000    Crys_tol(ppm): 0.5    IF_mode: 2    High_perf_Ch_Fil: 1    OSRtune: 0    Ch_Fil_Bw_AFC: 1    ANT_DIV: 0    PM_pattern: 0
-// MOD_type: 3    Rsymb(sps): 100000    Fdev(Hz): 50000    RXBW(Hz): 150000    Manchester: 0    AFC_en: 1    Rsymb_error: 0.0    Chip-Version: 2
-// RF Freq.(MHz): 422    API_TC: 29    fhst: 100000    inputBW: 0    BERT: 0    RAW_dout: 0    D_source: 0    Hi_pfm_div: 1
-// API_ARR_Det_en: 0    Fdev_error: 0    API_ETSI: 0
-//
-// # RX IF frequency is  -468750 Hz
-// # WB filter 2 (BW = 206.12 kHz);  NB-filter 2 (BW = 206.12 kHz)
-//
-// Modulation index: 1
-*/
-
-// Property values
-#define DRF_MODEM_TX_RAMP_DELAY_12 0x11, 0x20, 0x0C, 0x18, 0x01, 0x00, 0x08, 0x03, 0x80, 0x00, 0x10, 0x20, 0x00, 0xE8, 0x00, 0x4B
-#define DRF_MODEM_BCR_NCO_OFFSET_2_12 0x11, 0x20, 0x0C, 0x24, 0x06, 0xD3, 0xA0, 0x06, 0xD4, 0x02, 0x00, 0x00, 0x00, 0x23, 0xC6, 0xD4
-#define DRF_MODEM_AFC_LIMITER_1_3 0x11, 0x20, 0x03, 0x30, 0x00, 0xD3, 0xE0
-#define DRF_MODEM_AGC_CONTROL_1 0x11, 0x20, 0x01, 0x35, 0xE0
-#define DRF_MODEM_AGC_WINDOW_SIZE_12 0x11, 0x20, 0x0C, 0x38, 0x11, 0x10, 0x10, 0x80, 0x1A, 0x40, 0x00, 0x00, 0x28, 0x0C, 0xA4, 0x23
-#define DRF_MODEM_RAW_CONTROL_10 0x11, 0x20, 0x0A, 0x45, 0x03, 0x01, 0x15, 0x02, 0x00, 0xFF, 0x06, 0x01, 0x18, 0x40
-#define DRF_MODEM_SPIKE_DET_2 0x11, 0x20, 0x02, 0x54, 0x04, 0x07
-#define DRF_MODEM_DSA_CTRL1_5 0x11, 0x20, 0x05, 0x5B, 0x40, 0x04, 0x08, 0x78, 0x20
-#define DRF_MODEM_CHFLT_RX1_CHFLT_COE13_7_0_12 0x11, 0x21, 0x0C, 0x00, 0xFF, 0xC4, 0x30, 0x7F, 0xF5, 0xB5, 0xB8, 0xDE, 0x05, 0x17, 0x16, 0x0C
-#define DRF_MODEM_CHFLT_RX1_CHFLT_COE1_7_0_12 0x11, 0x21, 0x0C, 0x0C, 0x03, 0x00, 0x15, 0xFF, 0x00, 0x00, 0xFF, 0xC4, 0x30, 0x7F, 0xF5, 0xB5
-#define DRF_MODEM_CHFLT_RX2_CHFLT_COE7_7_0_12 0x11, 0x21, 0x0C, 0x18, 0xB8, 0xDE, 0x05, 0x17, 0x16, 0x0C, 0x03, 0x00, 0x15, 0xFF, 0x00, 0x00
-#define DRF_SYNTH_PFDCP_CPFF_7 0x11, 0x23, 0x07, 0x00, 0x34, 0x04, 0x0B, 0x04, 0x07, 0x70, 0x03
-#define DRF_PA_MODE_4 0x11, 0x22, 0x01, 0x3, 0x1D
-
-// Configuration array
-const unsigned char DEFAULT_CONFIG_ARR[] = {
-	0x10,
-	DRF_MODEM_TX_RAMP_DELAY_12,
-	0x10,
-	DRF_MODEM_BCR_NCO_OFFSET_2_12,
-	0x7,
-	DRF_MODEM_AFC_LIMITER_1_3,
-	0x5,
-	DRF_MODEM_AGC_CONTROL_1,
-	0x10,
-	DRF_MODEM_AGC_WINDOW_SIZE_12,
-	0xe,
-	DRF_MODEM_RAW_CONTROL_10,
-	0x6,
-	DRF_MODEM_SPIKE_DET_2,
-	0x9,
-	DRF_MODEM_DSA_CTRL1_5,
-	0x10,
-	DRF_MODEM_CHFLT_RX1_CHFLT_COE13_7_0_12,
-	0x10,
-	DRF_MODEM_CHFLT_RX1_CHFLT_COE1_7_0_12,
-	0x10,
-	DRF_MODEM_CHFLT_RX2_CHFLT_COE7_7_0_12,
-	0xb,
-	DRF_SYNTH_PFDCP_CPFF_7,
-	0x5,
-	DRF_PA_MODE_4,
-};
-#endif
\ No newline at end of file
@@ -16,24 +16,18 @@
 
 // data flow constants
 #define MSG_CHUNK_SIZE 255
-#define MSG_SIZE (MSG_CHUNK_SIZE * 32)              // 8160 (should be * 32)
+#define MSG_SIZE (MSG_CHUNK_SIZE * 32)              // 8160, payload of a full stream frame
 #define MSG_CHUNK_DATA_SIZE (MSG_CHUNK_SIZE - NPAR) // 245
-#define MSG_THRESH (MSG_SIZE)
 
-// Serial communication with Pi
-uint8_t buf[MSG_SIZE * 3];
+// the radio streams the video: frames go out back to back with no preamble gap to refill between them
+// the ring holds data from the Pi until the radio sends it
+uint8_t ring[MSG_SIZE * 3];
+// data from the Pi waiting to be Reed Solomon coded, added to the stream a whole codeword at a time
+uint8_t chunk[MSG_CHUNK_SIZE];
+int chunkLen = 0;
 uint8_t codeword[255];
 
-// radio variables
-bool hasTransmission = false;
-bool firstTX = true;
-
-int top = 0;
-int toSend = 0;
-int sent = 0;
-int bytesThisMessage = 0;
-
-uint32_t txTimeout = millis();
+uint32_t rxTimeout = millis();
 
 // testing
 uint32_t debugTimer = millis();
@@ -134,23 +128,17 @@ void setup()
       ;
   }
 
-  if (MSG_THRESH > MSG_SIZE)
+  // full frames carry MSG_SIZE bytes, a whole number of codewords, frames cut short by a slow Pi realign on the
+  // offset in their stream header
+  if (!radio.startStream(ring, sizeof(ring), MSG_SIZE + Si4463::STREAM_HEADER_LEN))
   {
-    Serial.println("Sending threshold greater than message size!");
+    Serial.println("Stream failed to start");
     Serial.flush();
+    beep(1000);
     while (1)
       ;
   }
 
-  // using buf because just need a valid arr
-  // only need to extract the header
-  // vHeader.fill(buf, MSG_SIZE);
-  // vHeader.encode(buf, MSG_SIZE);
-  // this header should be valid for every packet
-  // memcpy(vHeaderBuf, buf, GSData::headerLen);
-  // reset buf for good measure
-  // memset(buf, 0, MSG_SIZE);
-
   // write GSM header
   // GSData::encodeGSMHeader(GSMHeader, GSData::gsmHeaderSize, 400000);
 
@@ -160,210 +148,80 @@ void setup()
   Serial.print(MSG_CHUNK_DATA_SIZE);
   Serial.print(",");
   Serial.println(MSG_CHUNK_SIZE);
-  Serial.print("Message size is: ");
+  Serial.print("Frame size is: ");
   Serial.print(MSG_SIZE);
   Serial.println(" bytes");
-  Serial.print("Threshold is: ");
-  Serial.print(MSG_THRESH);
-  Serial.println(" bytes");
   Serial.println("Setup complete");
   pattern(beep, 100, 3);
 }
 
 void loop()
 {
-  // debugTimer = micros();
-  // reading from Raspi
-  while (Serial1.available() > 0 && top + NPAR + 1 < MSG_SIZE * 3)
-  // while (Wire.available() > 0 && top + NPAR + 1 < MSG_SIZE * 3)
+  // reading from Raspi, only as much as the stream can take so nothing read is dropped
+  uint16_t space = radio.streamSpace();
+  while (Serial1.available() > 0)
   {
-    txTimeout = millis();
-    buf[top] = Serial1.read();
-    // buf[top] = Wire.read();
-    top++;
-
-    if (bytesThisMessage + toSend < MSG_SIZE && hasTransmission)
+    if (disableRS)
     {
-      toSend++;
+      // pass it straight through
+      if (space == 0)
+        break;
+      int n = Serial1.available();
+      if (n > (int)sizeof(chunk))
+        n = sizeof(chunk);
+      if (n > space)
+        n = space;
+      for (int i = 0; i < n; i++)
+        chunk[i] = Serial1.read();
+      space -= radio.writeStream(chunk, n);
     }
-
-    // if (top == MSG_SIZE + 3)
-    // {
-    //   Serial.println();
-    //   Serial.println("Read: Sniffing beginning of next packet: ");
-    //   Serial.print(top);
-    //   Serial.print(" ");
-    //   Serial.println(toSend);
-    //   Serial.print(buf[bytesThisMessage], HEX);
-    //   Serial.print(" ");
-    //   Serial.print(buf[bytesThisMessage + 1], HEX);
-    //   Serial.print(" ");
-    //   Serial.println(buf[bytesThisMessage + 2], HEX);
-    // }
-
-    // add RS once we have MSG_CHUNK_SIZE bytes
-    if (top != 0 && ((top - (MSG_CHUNK_SIZE * (top / MSG_CHUNK_SIZE))) % MSG_CHUNK_DATA_SIZE) == 0 && !disableRS)
+    else
     {
-      // (top - (MSG_CHUNK_SIZE * (top / MSG_CHUNK_SIZE))) the number of bytes not part of an already coded message
-      // Serial.println("RS");
-      // Serial.print("top ");
-      // Serial.print(top);
-      // Serial.print("\t");
-      // Serial.print(MSG_CHUNK_DATA_SIZE);
-      // Serial.print("\ttoSend ");
-      // Serial.print(toSend);
-      // Serial.print("\thasTX ");
-      // Serial.println(hasTransmission);
-      rs.encode_data(buf + (top - MSG_CHUNK_DATA_SIZE), MSG_CHUNK_DATA_SIZE, codeword);
-      // for (int i = 0; i < MSG_CHUNK_DATA_SIZE; i++)
-      // {
-      //   Serial.print((buf + (top - MSG_CHUNK_DATA_SIZE))[i], HEX);
-      //   Serial.print(" ");
-      // }
-      // Serial.println();
-      // for (int i = 0; i < sizeof(codeword); i++)
-      // {
-      //   Serial.print(codeword[i], HEX);
-      //   Serial.print(" ");
-      // }
-      // Serial.println();
-      memcpy(buf + (top - MSG_CHUNK_DATA_SIZE), codeword, sizeof(codeword));
-      top += NPAR;
-      if (bytesThisMessage + toSend + NPAR <= MSG_SIZE && hasTransmission)
+      // the byte completing a chunk is only read once its codeword fits in the stream
+      if (chunkLen == MSG_CHUNK_DATA_SIZE - 1 && space < MSG_CHUNK_SIZE)
+        break;
+      chunk[chunkLen++] = Serial1.read();
+      // add RS once we have MSG_CHUNK_DATA_SIZE bytes
+      if (chunkLen == MSG_CHUNK_DATA_SIZE)
       {
-        toSend += NPAR;
+        rs.encode_data(chunk, MSG_CHUNK_DATA_SIZE, codeword);
+        space -= radio.writeStream(codeword, sizeof(codeword));
+        chunkLen = 0;
       }
     }
+    rxTimeout = millis();
   }
 
-  if (top >= MSG_SIZE * 3)
+  // the Pi stopped partway through a codeword, send what it has uncoded rather than holding it
+  if (chunkLen > 0 && millis() - rxTimeout > 1000 && space >= (uint16_t)chunkLen)
   {
-    Serial.print("Buffer overrun!\ttop ");
-    Serial.println(top);
-  }
-  if (toSend >= MSG_SIZE)
-  {
-    Serial.print("Sending too many bytes!\ttoSend ");
-    Serial.println(toSend);
+    radio.writeStream(chunk, chunkLen);
+    chunkLen = 0;
   }
 
-  // Refill fifo here
-  if (hasTransmission && toSend > 0)
-  {
-    uint16_t added = radio.writeTXBuf(buf + bytesThisMessage, toSend);
-    if (added != toSend)
-    {
-      Serial.println("");
-      Serial.println("E ");
-      Serial.print(added);
-      Serial.print(" ");
-      Serial.println(toSend);
-      while (1)
-        ;
-    }
-    // Serial.write(buf + bytesThisMessage, toSend);
-    sent = toSend;
-    bytesThisMessage += toSend;
-    toSend = 0;
-  }
-
-  // Start a new transmission
-  if ((top >= MSG_THRESH || (millis() - txTimeout > 1000 && top > 0 && !firstTX)) && !hasTransmission)
-  {
-    uint32_t timer = micros();
-    // turn on led
-    digitalWrite(LED, HIGH);
-    // TODO: remove temp
-    // if (firstTX)
-    //   Serial.write(GSMHeader, GSData::gsmHeaderSize);
-
-    firstTX = false;
-    hasTransmission = true;
-    toSend = (top > MSG_SIZE) ? MSG_SIZE : top;
-    // Serial.println();
-    // Serial.println(bytesThisMessage);
-    // TEMP: write GSData header for testing with ground station
-    // Serial.write(vHeaderBuf, GSData::headerLen);
-    // write data
-    // Serial.write(buf + bytesThisMessage, toSend);
-    radio.startTX(buf + bytesThisMessage, toSend, MSG_SIZE);
-
-    // set all status vars
-    sent = toSend;
-    bytesThisMessage += toSend;
-
-    Serial.println();
-    Serial.println("Sniffing beginning of packet: ");
-    Serial.print(top);
-    Serial.print(" ");
-    Serial.println(toSend);
-    Serial.print(buf[0], HEX);
-    Serial.print(" ");
-    Serial.print(buf[1], HEX);
-    Serial.print(" ");
-    Serial.println(buf[2], HEX);
-    Serial.print("Elapsed time: ");
-    Serial.println(micros() - timer);
-    toSend = 0;
-  }
-
-  // if (millis() - txTimeout > 100 && top > 0)
-  // {
-  //   top = 0;
-  //   sent = 0;
-  // }
-
-  if ((bytesThisMessage == MSG_SIZE || (millis() - txTimeout > 100 && toSend == 0)) && hasTransmission && radio.state == STATE_IDLE)
-  {
-    // remove sent bytes
-
-    top -= bytesThisMessage;
-    memcpy(buf, buf + bytesThisMessage, top);
-    bytesThisMessage = 0;
-
-    hasTransmission = false;
-
-    // turn off led
-    digitalWrite(LED, LOW);
-  }
+  // the led is on while there is data waiting to be sent
+  digitalWrite(LED, radio.streamSpace() < sizeof(ring) - 1 ? HIGH : LOW);
 
   radio.update();
 
   if (millis() - debugTimer > 100)
   {
     debugTimer = millis();
+    // copy so the counters don't change while printing
+    Si4463Stats stats = radio.stats();
     Serial.print("\r                                                                                                                                            ");
-    Serial.print("\rBuffer state: ");
-    Serial.print("\ttop ");
-    Serial.print(top);
-    Serial.print("\tsent ");
-    Serial.print(sent);
-    Serial.print("\ttoSend ");
-    Serial.print(toSend);
-    Serial.print("\tbytesThisMessage ");
-    Serial.print(bytesThisMessage);
-    Serial.print("\tavailLen ");
-    Serial.print(radio.availLen);
-    Serial.print("\txfrd ");
-    Serial.print(radio.xfrd);
+    Serial.print("\rStream state: ");
+    Serial.print("\tframes ");
+    Serial.print(stats.txPackets);
+    Serial.print("\tbytes ");
+    Serial.print(stats.txBytes);
+    Serial.print("\tunderflows ");
+    Serial.print(stats.txUnderflows);
+    Serial.print("\tbuffered ");
+    Serial.print(sizeof(ring) - 1 - radio.streamSpace());
+    Serial.print("\tchunkLen ");
+    Serial.print(chunkLen);
     Serial.print("\tstate ");
     Serial.print(radio.state);
-    Serial.print("\tTX_FIFO_EMPTY ");
-    Serial.print(radio.gpio0());
   }
-
-  // if (radio.state == STATE_TX && radio.availLen > 0 && radio.availLen == radio.xfrd && radio.xfrd < MSG_SIZE && radio.gpio0())
-  // {
-  //   Serial.print("\nRan out of bits!\tbytesThisMessage ");
-  //   Serial.print(bytesThisMessage);
-  //   Serial.print("\ttop ");
-  //   Serial.print(top);
-  //   Serial.print("\tavailLen ");
-  //   Serial.print(radio.availLen);
-  //   Serial.print("\txfrd ");
-  //   Serial.print(radio.xfrd);
-  //   Serial.print("\tstate ");
-  //   Serial.println(radio.state);
-  //   delay(10000);
-  // }
-}
\ No newline at end of file
+}
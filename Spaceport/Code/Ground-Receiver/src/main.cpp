@@ -106,6 +106,8 @@ Si4463PinConfig pincfgPayload = {
 Si4463 radioTelem(hwcfgTelem, pincfgTelem);
 Si4463 radioAvionics(hwcfgAvionics, pincfgAvionics);
 Si4463 radioPayload(hwcfgPayload, pincfgPayload);
+// the radios share one SPI bus, while one waits for CTS the bus services the FIFOs of the others
+Si4463Bus radioBus(&SPI);
 
 enum InputState
 {
@@ -145,6 +147,8 @@ GSData payloadData(APRSTelem::type, 3, TELEM_DEVICE_ID);
 bool hasPayloadTelem = false;
 
 // video
+// live-video-teensy streams the video, every frame starts with a Si4463StreamHeader
+uint8_t videoFrame[Si4463::MAX_LEN];
 Message avionicsVideoMessage;
 VideoData avionicsVideo;
 GSData avionicsVideoData(VideoData::type, 5, AVIONICS_DEVICE_ID);
@@ -210,6 +214,21 @@ void setup()
   display.invertDisplay(false);
   delay(1000);
 
+  // must be added before begin(), radios that haven't begun are never serviced by the bus
+  radioBus.add(&radioTelem);
+  radioBus.add(&radioAvionics);
+  radioBus.add(&radioPayload);
+
+  // video frames arrive back to back, queue them so the radio stays in RX while one is being forwarded
+  if (!radioAvionics.setRXQueue(4))
+  {
+    log("Error: could not allocate the avionics video RX queue");
+    while (1)
+      ;
+  }
+  // move the FIFO bytes with DMA so update() isn't stuck on SPI transfers
+  radioAvionics.setAsyncSPI(true);
+
   // if (!radioTelem.begin(CONFIG_422Mc80_4GFSK_009600H, sizeof(CONFIG_422Mc80_4GFSK_009600H)))
   // {
   //   log("Error: telemetry radio failed to begin");
@@ -445,16 +464,24 @@ void loop()
 
   if (handshakeSuccess && radioAvionics.avail())
   {
-    // get the message
-    avionicsVideo.size = radioAvionics.readRXBuf(avionicsVideo.data, radioAvionics.length);
-    // re-encode it to be multiplexed
-    avionicsVideoMessage.encode(&avionicsVideo);
-    // update metrics
-    avionicsVideoMetrics.update(avionicsVideoMessage.size, millis(), radioAvionics.RSSI());
-    // set the flag to transmit data
-    hasAvionicsVideo = true;
-    // reset avail flag
-    radioAvionics.available = false;
+    // get the next stream frame, its payload is the video
+    Si4463RXPacket info;
+    uint16_t len = radioAvionics.readRXQueue(videoFrame, sizeof(videoFrame), &info);
+    Si4463StreamHeader header;
+    if (Si4463::readStreamHeader(videoFrame, len, header))
+    {
+      uint16_t payload = len - Si4463::STREAM_HEADER_LEN;
+      if (payload > VideoData::maxSize)
+        payload = VideoData::maxSize;
+      memcpy(avionicsVideo.data, videoFrame + Si4463::STREAM_HEADER_LEN, payload);
+      avionicsVideo.size = payload;
+      // re-encode it to be multiplexed
+      avionicsVideoMessage.encode(&avionicsVideo);
+      // update metrics
+      avionicsVideoMetrics.update(avionicsVideoMessage.size, millis(), info.rssi);
+      // set the flag to transmit data
+      hasAvionicsVideo = true;
+    }
   }
 
   // if (handshakeSuccess && radioPayload.avail())
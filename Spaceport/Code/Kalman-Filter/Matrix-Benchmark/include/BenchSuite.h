@@ -0,0 +1,10 @@
+#ifndef BENCH_SUITE_H
+#define BENCH_SUITE_H
+
+// Times the matrix operations and Kalman filter steps the flight code uses and prints min/median/p99 per call and heap
+// allocations per call. On the Teensy times are ARM DWT cycle counts, natively they are nanoseconds. The operations are
+// checked against the validation vectors first. The lazy expressions from MatrixExpr.h are checked against the eager
+// operators and timed next to them, by themselves and inside a full filter step.
+void runBenchSuite();
+
+#endif // BENCH_SUITE_H
@@ -0,0 +1,440 @@
+#include "BenchSuite.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "StaticMatrix.h" // from Teensy-Based-Avionics
+#include "AvionicsKF.h"   // from Teensy-Based-Avionics
+#include "BenchUtils.h"   // from Teensy-Based-Avionics/test
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <MMFS.h>
+#else
+#include <chrono>
+#endif
+
+// Timer and printing, the only parts that differ between the Teensy and the host
+
+#ifdef ARDUINO
+static const char *timeUnit = "cyc";
+// the cycle counter is exact, one call per sample
+static const int callsPerSample = 1;
+static inline uint32_t benchTime() { return ARM_DWT_CYCCNT; }
+#else
+static const char *timeUnit = "ns";
+// reading the clock costs about as much as the small operations, so each sample averages a batch of calls
+static const int callsPerSample = 16;
+static inline uint32_t benchTime()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+static void benchPrintf(const char *format, ...)
+{
+    char buf[160];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+#ifdef ARDUINO
+    Serial.print(buf);
+#else
+    fputs(buf, stdout);
+#endif
+}
+
+// Tells the compiler x was read and may have changed, so loop-invariant work isn't hoisted out of the timing loops
+template <typename T>
+static inline void clobber(T &x)
+{
+    asm volatile("" : : "r"(&x) : "memory");
+}
+
+static const int numSamples = 1001;
+static uint32_t samples[numSamples];
+// cost of reading the timer around an empty call, taken off every sample
+static uint32_t timerOverhead = 0;
+
+static int compareSamples(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+// times op numSamples times into samples, sorted, and returns the allocations per call
+template <typename Op>
+static double sample(Op op)
+{
+    // warm up the caches and branch predictor
+    for (int i = 0; i < 10; i++)
+        op();
+
+    uint32_t startAllocations = allocations;
+    for (int i = 0; i < numSamples; i++)
+    {
+        uint32_t start = benchTime();
+        for (int j = 0; j < callsPerSample; j++)
+            op();
+        uint32_t t = benchTime() - start;
+        samples[i] = t > timerOverhead ? (t - timerOverhead) / callsPerSample : 0;
+    }
+    double allocs = (double)(allocations - startAllocations) / numSamples / callsPerSample;
+
+    qsort(samples, numSamples, sizeof(samples[0]), compareSamples);
+    return allocs;
+}
+
+// times op numSamples times, prints the spread per call and returns the median
+template <typename Op>
+static uint32_t bench(const char *name, const char *type, int size, Op op)
+{
+    double allocs = sample(op);
+    benchPrintf("%-22s %-7s %4d | %9lu %9lu %9lu | %6.1f\n", name, type, size,
+                (unsigned long)samples[0], (unsigned long)samples[numSamples / 2], (unsigned long)samples[numSamples * 99 / 100], allocs);
+    return samples[numSamples / 2];
+}
+
+// uniform in [0, 1)
+static double benchRandom()
+{
+    return (benchNext() >> 8) / 16777216.0;
+}
+
+template <int R, int C, typename T>
+static mmfs::StaticMatrix<R, C, T> randomMatrix()
+{
+    mmfs::StaticMatrix<R, C, T> m;
+    for (int i = 0; i < R * C; i++)
+        m.data[i] = (T)benchRandom();
+    return m;
+}
+
+// symmetric positive definite, like a covariance
+template <int N, typename T>
+static mmfs::StaticMatrix<N, N, T> randomSPD()
+{
+    mmfs::StaticMatrix<N, N, T> a = randomMatrix<N, N, T>();
+    return a * a.transpose() + mmfs::StaticMatrix<N, N, T>::diagonal(N);
+}
+
+template <int N, typename T>
+static void benchStatic(const char *type)
+{
+    mmfs::StaticMatrix<N, N, T> a = randomSPD<N, T>();
+    mmfs::StaticMatrix<N, N, T> b = randomMatrix<N, N, T>();
+    mmfs::StaticMatrix<N, N, T> out;
+
+    bench("multiply", type, N, [&]()
+          { clobber(a); clobber(b); out = a * b; clobber(out); });
+    bench("transpose", type, N, [&]()
+          { clobber(a); out = a.transpose(); clobber(out); });
+    bench("add", type, N, [&]()
+          { clobber(a); clobber(b); out = a + b; clobber(out); });
+    bench("inverse", type, N, [&]()
+          { clobber(a); mmfs::invert(a, out); clobber(out); });
+    bench("cholesky solve", type, N, [&]()
+          {
+        clobber(a);
+        clobber(b);
+        mmfs::StaticMatrix<N, N, T> l = a;
+        mmfs::choleskyFactor(l);
+        out = b;
+        mmfs::choleskySolveRight(l, out);
+        clobber(out); });
+}
+
+#ifdef ARDUINO
+static mmfs::Matrix randomHeapMatrix(int rows, int cols)
+{
+    double *arr = new double[rows * cols];
+    for (int i = 0; i < rows * cols; i++)
+        arr[i] = benchRandom() + (i % (cols + 1) == 0 ? cols : 0);
+    return mmfs::Matrix(rows, cols, arr);
+}
+
+// the MMFS heap Matrix, what the filter math used before StaticMatrix
+static void benchHeap(int n)
+{
+    mmfs::Matrix a = randomHeapMatrix(n, n);
+    mmfs::Matrix b = randomHeapMatrix(n, n);
+
+    bench("multiply", "heap", n, [&]()
+          { mmfs::Matrix out = a * b; });
+    bench("transpose", "heap", n, [&]()
+          { mmfs::Matrix out = a.transpose(); });
+    bench("add", "heap", n, [&]()
+          { mmfs::Matrix out = a + b; });
+    bench("inverse", "heap", n, [&]()
+          { mmfs::Matrix out = a.inverse(); });
+}
+#endif
+
+// Validation vectors the matrix operations have to reproduce: a hand checked product and transpose, the lazy expressions
+// against the eager operators and the two filter modes against each other
+static int validationFailures = 0;
+
+static void check(const char *name, bool ok)
+{
+    if (!ok)
+        validationFailures++;
+    benchPrintf("  %-34s %s\n", name, ok ? "pass" : "FAIL");
+}
+
+template <typename T>
+static bool matches(const T *a, const T *b, int n, double tolerance)
+{
+    for (int i = 0; i < n; i++)
+    {
+        double scale = fabs((double)b[i]) > 1 ? fabs((double)b[i]) : 1;
+        if (!(fabs((double)a[i] - (double)b[i]) <= tolerance * scale))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+static void validateType(const char *type)
+{
+    benchPrintf("%s\n", type);
+    const mmfs::StaticMatrix<2, 3, T> a = {{1, 2, 3, 4, 5, 6}};
+    const mmfs::StaticMatrix<3, 2, T> b = {{7, 8, 9, 10, 11, 12}};
+    const T product[] = {58, 64, 139, 154};
+    const T transposed[] = {1, 4, 2, 5, 3, 6};
+    check("2x3 * 3x2 known product", matches((a * b).data, product, 4, 0));
+    check("2x3 known transpose", matches(a.transpose().data, transposed, 6, 0));
+}
+
+// the lazy expressions against the eager operators, including destinations that appear in their own expression
+template <int N, int M, typename T>
+static void validateExpressions(const char *name, double tolerance)
+{
+    using mmfs::lazy;
+    using mmfs::transpose;
+    mmfs::StaticMatrix<N, N, T> f = randomMatrix<N, N, T>();
+    mmfs::StaticMatrix<N, N, T> q = randomSPD<N, T>();
+    mmfs::StaticMatrix<M, N, T> h = randomMatrix<M, N, T>();
+    mmfs::StaticMatrix<M, M, T> r = randomSPD<M, T>();
+    mmfs::StaticMatrix<N, N, T> p = randomSPD<N, T>();
+    mmfs::StaticMatrix<N, N, T> expected, out;
+    mmfs::StaticMatrix<N, M, T> k, expectedK;
+    mmfs::StaticMatrix<M, M, T> s, expectedS;
+    bool ok = true;
+
+    expected = f * p * f.transpose() + q;
+    out = lazy(f) * p * transpose(f) + q;
+    ok &= matches(out.data, expected.data, N * N, tolerance);
+
+    expectedK = p * h.transpose();
+    expectedS = h * expectedK + r;
+    k = lazy(p) * transpose(h);
+    s = lazy(h) * k + r;
+    ok &= matches(k.data, expectedK.data, N * M, tolerance);
+    ok &= matches(s.data, expectedS.data, M * M, tolerance);
+
+    expected = (mmfs::StaticMatrix<N, N, T>::identity() - k * h) * p;
+    out = p;
+    out -= lazy(k) * (lazy(h) * out);
+    ok &= matches(out.data, expected.data, N * N, tolerance);
+
+    // the destination read across elements has to go through a temporary
+    expected = f * p;
+    out = p;
+    out = lazy(f) * out;
+    ok &= matches(out.data, expected.data, N * N, tolerance);
+    expected = p + p.transpose() * (T)0.5;
+    out = p;
+    out += transpose(out) * (T)0.5;
+    ok &= matches(out.data, expected.data, N * N, tolerance);
+    expected = mmfs::StaticMatrix<N, N, T>::identity() - p;
+    out = p;
+    out = mmfs::identity<N, T>() - out;
+    ok &= matches(out.data, expected.data, N * N, tolerance);
+
+    check(name, ok);
+}
+
+// runs the validation vectors, returns whether they all passed
+static bool validate()
+{
+    validationFailures = 0;
+    benchPrintf("Validating the matrix operations\n");
+    validateType<double>("double");
+    validateType<float>("float");
+
+    // the full filter runs on the lazy expressions and the decoupled one on closed form scalars, they have to agree
+    mmfs::AvionicsKF full(mmfs::KF_FULL), decoupled(mmfs::KF_DECOUPLED);
+    double a[6] = {0}, b[6] = {0};
+    double control[3] = {0.3, -0.2, 50};
+    bool ok = true;
+    for (int i = 0; i < 500; i++)
+    {
+        double measurement[3] = {benchRandom(), benchRandom(), 25 * (i * 0.01) * (i * 0.01)};
+        full.iterate(0.01, a, measurement, control);
+        decoupled.iterate(0.01, b, measurement, control);
+    }
+    ok = matches(a, b, 6, 1e-9);
+    benchPrintf("filter\n");
+    check("AvionicsKF full vs decoupled", ok);
+
+    benchPrintf("expressions\n");
+    validateExpressions<6, 3, double>("6 state, 3 measurement lazy vs eager", 1e-12);
+    validateExpressions<15, 6, double>("15 state, 6 measurement lazy vs eager", 1e-12);
+    validateExpressions<15, 6, float>("15 state float lazy vs eager", 1e-4);
+
+    benchPrintf("%d validation failures\n\n", validationFailures);
+    return validationFailures == 0;
+}
+
+// The covariance predict, gain and covariance update of an N state filter with M measurements, each written with the
+// eager operators (a temporary per operator) and as a fused lazy expression
+template <int N, int M>
+static void benchExpressions()
+{
+    using mmfs::lazy;
+    using mmfs::transpose;
+    mmfs::StaticMatrix<N, N> f = mmfs::StaticMatrix<N, N>::identity() + randomMatrix<N, N, double>() * 0.01;
+    mmfs::StaticMatrix<N, N> q = mmfs::StaticMatrix<N, N>::diagonal(0.1);
+    mmfs::StaticMatrix<M, N> h = randomMatrix<M, N, double>();
+    mmfs::StaticMatrix<M, M> r = mmfs::StaticMatrix<M, M>::diagonal(1);
+    mmfs::StaticMatrix<N, N> p = randomSPD<N, double>();
+    mmfs::StaticMatrix<N, N> out;
+    mmfs::StaticMatrix<N, M> k;
+    mmfs::StaticMatrix<M, M> s;
+
+    uint32_t eager = bench("F P Ft + Q (eager)", "double", N, [&]()
+                           { clobber(f); clobber(p); out = f * p * f.transpose() + q; clobber(out); });
+    uint32_t fused = bench("F P Ft + Q (fused)", "double", N, [&]()
+                           { clobber(f); clobber(p); out = lazy(f) * p * transpose(f) + q; clobber(out); });
+    benchPrintf("  fused speedup %.2fx\n", fused ? (double)eager / fused : 0.0);
+
+    eager = bench("P Ht, H K + R (eager)", "double", N, [&]()
+                  { clobber(p); k = p * h.transpose(); s = h * k + r; clobber(k); clobber(s); });
+    fused = bench("P Ht, H K + R (fused)", "double", N, [&]()
+                  { clobber(p); k = lazy(p) * transpose(h); s = lazy(h) * k + r; clobber(k); clobber(s); });
+    benchPrintf("  fused speedup %.2fx\n", fused ? (double)eager / fused : 0.0);
+
+    // p is left alone so it doesn't drift between samples
+    eager = bench("(I - K H) P (eager)", "double", N, [&]()
+                  { clobber(k); clobber(p); out = (mmfs::StaticMatrix<N, N>::identity() - k * h) * p; clobber(out); });
+    fused = bench("P - K (H P) (fused)", "double", N, [&]()
+                  { clobber(k); clobber(p); out = p; out -= lazy(k) * (lazy(h) * out); clobber(out); });
+    benchPrintf("  fused speedup %.2fx\n", fused ? (double)eager / fused : 0.0);
+}
+
+// AvionicsKF's full step written with the eager operators, what it was before the lazy expressions
+struct EagerFullKF
+{
+    typedef mmfs::AvionicsKF KF;
+    KF::StateMatrix F = KF::StateMatrix::identity();
+    mmfs::StaticMatrix<KF::STATE_SIZE, KF::CTRL_SIZE> G = mmfs::StaticMatrix<KF::STATE_SIZE, KF::CTRL_SIZE>::zeros();
+    KF::StateMatrix P = KF::StateMatrix::identity();
+
+    void iterate(double dt, double *state, const double *measurement, const double *control)
+    {
+        for (int i = 0; i < KF::CTRL_SIZE; i++)
+        {
+            F(i, i + KF::CTRL_SIZE) = dt;
+            G(i, i) = 0.5 * dt * dt;
+            G(i + KF::CTRL_SIZE, i) = dt;
+        }
+        mmfs::StaticMatrix<KF::STATE_SIZE, 1> X;
+        mmfs::StaticMatrix<KF::CTRL_SIZE, 1> U;
+        mmfs::StaticMatrix<KF::MEAS_SIZE, 1> Z;
+        for (int i = 0; i < KF::STATE_SIZE; i++)
+            X.data[i] = state[i];
+        for (int i = 0; i < KF::CTRL_SIZE; i++)
+            U.data[i] = control[i];
+        for (int i = 0; i < KF::MEAS_SIZE; i++)
+            Z.data[i] = measurement[i];
+
+        X = F * X + G * U;
+        P = F * P * F.transpose() + KF::Q;
+        mmfs::StaticMatrix<KF::STATE_SIZE, KF::MEAS_SIZE> K = P * KF::H.transpose();
+        mmfs::StaticMatrix<KF::MEAS_SIZE, KF::MEAS_SIZE> S = KF::H * K + KF::R;
+        if (mmfs::choleskyFactor(S))
+        {
+            mmfs::choleskySolveRight(S, K);
+            X += K * (Z - KF::H * X);
+            P = (KF::StateMatrix::identity() - K * KF::H) * P;
+        }
+
+        for (int i = 0; i < KF::STATE_SIZE; i++)
+            state[i] = X.data[i];
+    }
+};
+
+// one filter step on a synthetic boost, the state carries over between samples like it would in flight
+template <typename Step>
+static uint32_t benchFilter(const char *name, Step step)
+{
+    double state[6] = {0};
+    double control[3] = {0.3, -0.2, 50};
+    double measurement[3] = {0, 0, 0};
+    int n = 0;
+    const double dt = 0.01;
+
+    return bench(name, "double", 6, [&]()
+                 {
+        n++;
+        measurement[2] = 25 * (n * dt) * (n * dt) + benchRandom();
+        step(dt, state, measurement, control);
+        clobber(state); });
+}
+
+static uint32_t benchFilter(const char *name, mmfs::AvionicsKFMode mode, bool split)
+{
+    mmfs::AvionicsKF kf(mode);
+    return benchFilter(name, [&](double dt, double *state, const double *measurement, const double *control)
+                       {
+        if (split)
+        {
+            kf.predict(dt, state, control);
+            for (int i = 0; i < 3; i++)
+                kf.update(i, state, measurement[i]);
+        }
+        else
+            kf.iterate(dt, state, measurement, control); });
+}
+
+void runBenchSuite()
+{
+#ifdef ARDUINO
+    enableCycleCounter();
+#endif
+
+    validate();
+
+    benchPrintf("%-22s %-7s %4s | %9s %9s %9s | %6s\n", "operation", "type", "n", "min", "median", "p99", "allocs");
+    benchPrintf("(times in %s per call, allocs per call)\n", timeUnit);
+
+    // the smallest timed empty sample is the cost of the measurement itself
+    timerOverhead = 0;
+    bench("timer overhead", "-", 0, []() {});
+    timerOverhead = samples[0] * callsPerSample;
+
+    // the flight filter's 6x6 and the 15x15 of a planned error state attitude filter
+    benchStatic<6, double>("double");
+    benchStatic<6, float>("float");
+    benchStatic<15, double>("double");
+    benchStatic<15, float>("float");
+#ifdef ARDUINO
+    benchHeap(6);
+    benchHeap(15);
+#endif
+
+    // the expression layer against a temporary per operator
+    benchExpressions<6, 3>();
+    benchExpressions<15, 6>();
+
+    EagerFullKF eager;
+    uint32_t eagerTime = benchFilter("AvionicsKF full eager", [&](double dt, double *state, const double *measurement, const double *control)
+                                     { eager.iterate(dt, state, measurement, control); });
+    uint32_t fullTime = benchFilter("AvionicsKF full", mmfs::KF_FULL, false);
+    benchPrintf("  fused speedup %.2fx\n", fullTime ? (double)eagerTime / fullTime : 0.0);
+    benchFilter("AvionicsKF decoupled", mmfs::KF_DECOUPLED, false);
+    benchFilter("AvionicsKF sequential", mmfs::KF_FULL, true);
+    benchFilter("AvionicsKF seq decoup", mmfs::KF_DECOUPLED, true);
+}
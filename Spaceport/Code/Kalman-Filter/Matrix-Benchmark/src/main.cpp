@@ -1,5 +1,7 @@
 #include <Arduino.h>
 #include <MMFS.h>
+#include "StaticMatrix.h" // from Teensy-Based-Avionics
+#include "BenchSuite.h"
 
 // Helper function to generate a random matrix 
 mmfs::Matrix randomMatrix(int rows, int cols) {
@@ -34,6 +36,79 @@ void benchmark_inverse(int matrix_size, int iterations) {
     Serial.println(" microseconds");
 }
 
+// Random symmetric positive definite matrix, shaped like an innovation covariance S = H P Ht + R
+template <int N>
+mmfs::StaticMatrix<N, N> randomSPD() {
+    mmfs::StaticMatrix<N, N> a;
+    for (int i = 0; i < N * N; i++) {
+        a.data[i] = random(1, 10000) / 10000.0;
+    }
+    return a * a.transpose() + mmfs::StaticMatrix<N, N>::diagonal(N);
+}
+
+// Tells the compiler x was read and may have changed, so loop-invariant work isn't hoisted out of the timing loops
+template <typename T>
+void clobber(T &x) {
+    asm volatile("" : : "r"(&x) : "memory");
+}
+
+// Benchmarks the Kalman gain K = P Ht S^-1 for a filter with MEAS measurements and STATE states, using
+// mmfs::Matrix::inverse(), StaticMatrix invert(), and a Cholesky factor and solve of S (what AvionicsKF uses)
+template <int MEAS, int STATE>
+void benchmark_gain(int iterations) {
+    mmfs::StaticMatrix<MEAS, MEAS> S = randomSPD<MEAS>();
+    mmfs::StaticMatrix<STATE, MEAS> PHt;
+    for (int i = 0; i < STATE * MEAS; i++) {
+        PHt.data[i] = random(1, 10000) / 10000.0;
+    }
+
+    double *sArr = new double[MEAS * MEAS];
+    double *phtArr = new double[STATE * MEAS];
+    memcpy(sArr, S.data, sizeof(S.data));
+    memcpy(phtArr, PHt.data, sizeof(PHt.data));
+    mmfs::Matrix heapS(MEAS, MEAS, sArr);
+    mmfs::Matrix heapPHt(STATE, MEAS, phtArr);
+
+    unsigned long startTime = micros();
+    for (int i = 0; i < iterations; i++) {
+        mmfs::Matrix K = heapPHt * heapS.inverse();
+    }
+    double heapTime = (double)(micros() - startTime) / iterations;
+
+    mmfs::StaticMatrix<STATE, MEAS> invK;
+    startTime = micros();
+    for (int i = 0; i < iterations; i++) {
+        clobber(S);
+        clobber(PHt);
+        mmfs::StaticMatrix<MEAS, MEAS> Sinv;
+        mmfs::invert(S, Sinv);
+        invK = PHt * Sinv;
+        clobber(invK);
+    }
+    double inverseTime = (double)(micros() - startTime) / iterations;
+
+    mmfs::StaticMatrix<STATE, MEAS> solveK;
+    startTime = micros();
+    for (int i = 0; i < iterations; i++) {
+        clobber(S);
+        clobber(PHt);
+        mmfs::StaticMatrix<MEAS, MEAS> L = S;
+        mmfs::choleskyFactor(L);
+        solveK = PHt;
+        mmfs::choleskySolveRight(L, solveK);
+        clobber(solveK);
+    }
+    double solveTime = (double)(micros() - startTime) / iterations;
+
+    double maxDiff = 0;
+    for (int i = 0; i < STATE * MEAS; i++) {
+        maxDiff = max(maxDiff, fabs(invK.data[i] - solveK.data[i]));
+    }
+
+    Serial.printf("%4d %5d | %9.2f %9.2f %9.2f | %7.1fx %7.1fx | %.1e\n", MEAS, STATE,
+                  heapTime, inverseTime, solveTime, heapTime / solveTime, inverseTime / solveTime, maxDiff);
+}
+
 // Arduino setup function
 void setup() {
     Serial.begin(115200);  
@@ -43,6 +118,21 @@ void setup() {
     for (int i = 2; i <= 30; i++) {
         benchmark_inverse(i, 1000);
     }
+
+    // Gain computation, heap inverse vs fixed size inverse vs Cholesky solve (us per gain)
+    Serial.printf("%4s %5s | %9s %9s %9s | %8s %8s | %7s\n", "meas", "state", "heap inv", "inv", "solve", "vs heap", "vs inv", "maxDiff");
+    // AvionicsKF: GPS/baro position into position/velocity
+    benchmark_gain<3, 6>(1000);
+    // attitude estimation: quaternion states, then the 9 and 15 state error state filters with accel/mag updates
+    benchmark_gain<3, 7>(1000);
+    benchmark_gain<6, 9>(1000);
+    benchmark_gain<6, 15>(1000);
+    benchmark_gain<9, 15>(1000);
+    benchmark_gain<12, 24>(1000);
+    benchmark_gain<30, 30>(100);
+
+    Serial.println();
+    runBenchSuite();
 }
 
 void loop() {
@@ -0,0 +1,10 @@
+// Entry point for the native build, so the suite can be run on a development machine before going on the board
+// Build and run with: pio run -e native -t exec
+
+#include "BenchSuite.h"
+
+int main()
+{
+    runBenchSuite();
+    return 0;
+}
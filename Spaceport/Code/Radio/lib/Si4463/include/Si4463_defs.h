@@ -15,6 +15,23 @@ enum Si4463State : uint8_t
     STATE_RX_COMPLETE, // finished RX
 };
 
+// queued command states
+enum Si4463CmdStatus : uint8_t
+{
+    CMD_IDLE,   // not queued
+    CMD_QUEUED, // waiting for the commands ahead of it
+    CMD_SENT,   // sent to the radio, waiting for CTS
+    CMD_DONE,   // response received
+    CMD_FAILED, // CTS timed out or the radio was shut down
+};
+
+// stream frame header flags
+enum Si4463StreamFlag : uint8_t
+{
+    STREAM_START = 0b00000001, // first frame of the stream
+    STREAM_END = 0b00000010,   // last frame of the stream
+};
+
 // modulations
 enum Si4463Mod : uint8_t
 {
@@ -62,6 +79,21 @@ enum Si4463Band : uint8_t
     BAND_900 = 0b00001000,
 };
 
+// packet handler CRC polynomials, used with PKT_CRC_CONFIG
+enum Si4463CRC : uint8_t
+{
+    CRC_NONE = 0x00,
+    CRC_ITU_T_8 = 0x01,
+    CRC_IEC_16 = 0x02,
+    CRC_BAICHEVA_16 = 0x03,
+    CRC_IBM_16 = 0x04,
+    CRC_CCITT_16 = 0x05,
+    CRC_KOOPMAN_32 = 0x06,
+    CRC_IEEE_802_3_32 = 0x07,
+    CRC_CASTAGNOLI_32 = 0x08,
+    CRC_DNP_16 = 0x09,
+};
+
 // output power presets
 enum Si4463Power : uint8_t
 {
@@ -132,6 +164,39 @@ enum Si4463FRR : uint8_t
     FRR_NO_CHANGE = 0xFF, // does not modify this FRR's mode
 };
 
+// interrupt sources, used with INT_CTL_ENABLE
+enum Si4463Int : uint8_t
+{
+    INT_PH = 0b00000001,
+    INT_MODEM = 0b00000010,
+    INT_CHIP = 0b00000100,
+};
+
+// packet handler interrupts, used with INT_CTL_PH_ENABLE and the PH_PEND/PH_STATUS bytes of GET_INT_STATUS
+enum Si4463PHInt : uint8_t
+{
+    PH_RX_FIFO_ALMOST_FULL = 0b00000001,
+    PH_TX_FIFO_ALMOST_EMPTY = 0b00000010,
+    PH_ALT_CRC_ERROR = 0b00000100,
+    PH_CRC_ERROR = 0b00001000,
+    PH_PACKET_RX = 0b00010000,
+    PH_PACKET_SENT = 0b00100000,
+    PH_FILTER_MISS = 0b01000000,
+    PH_FILTER_MATCH = 0b10000000,
+};
+
+// chip interrupts, used with INT_CTL_CHIP_ENABLE and the CHIP_PEND/CHIP_STATUS bytes of GET_INT_STATUS
+enum Si4463ChipInt : uint8_t
+{
+    CHIP_WUT = 0b00000001,
+    CHIP_LOW_BATT = 0b00000010,
+    CHIP_READY = 0b00000100,
+    CHIP_CMD_ERROR = 0b00001000,
+    CHIP_STATE_CHANGE = 0b00010000,
+    CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR = 0b00100000,
+    CHIP_CAL = 0b01000000,
+};
+
 // commands
 enum Si4463Cmd : uint8_t
 {
@@ -0,0 +1,120 @@
+#ifndef SI4463_FREQ
+#define SI4463_FREQ
+
+#include "Si4463_defs.h"
+
+/*
+Si4463 Frequency Configuration
+- int8_t band : index of the band used (see Si4463FreqPlan), -1 if the frequency cannot be tuned to
+- uint8_t channel : the channel needed to reach the frequency from the band base frequency
+- uint32_t freq : the frequency actually tuned to (Hz), may differ from the requested frequency by less than one channel step
+- uint8_t fInt : value for FREQ_CONTROL_INTE
+- uint32_t fFrac : value for FREQ_CONTROL_FRAC
+- uint16_t stepSize : value for FREQ_CONTROL_CHANNEL_STEP_SIZE
+*/
+struct Si4463FreqConfig
+{
+    int8_t band;
+    uint8_t channel;
+    uint32_t freq;
+    uint8_t fInt;
+    uint32_t fFrac;
+    uint16_t stepSize;
+};
+
+/*
+Compile time frequency math for the Si4463, everything here is constexpr so fixed frequencies and data rates cost nothing at runtime
+The radio is always tuned to a base frequency for the band and then uses the channel number to reach the requested frequency,
+so switching frequency within a band only needs a new channel in START_TX/START_RX
+Ex. constexpr Si4463FreqConfig f433 = Si4463FreqPlan::config(433e6);
+*/
+class Si4463FreqPlan
+{
+public:
+    // crystal frequency
+    static constexpr uint32_t XO_FREQ = 30000000; // Hz
+    // spacing between channels
+    static constexpr uint32_t CHANNEL_STEP = 100000; // Hz
+    // number of bands
+    static constexpr int NUM_BANDS = 6;
+
+    // band tables, indexed by band
+    // nominal band frequency used to pick the band (MHz)
+    static constexpr uint16_t bandMHz(int band)
+    {
+        return band == 0 ? 150 : band == 1 ? 225 : band == 2 ? 300 : band == 3 ? 450 : band == 4 ? 600 : 900;
+    }
+    // output divider for the band
+    static constexpr uint8_t bandDiv(int band)
+    {
+        return band == 0 ? 24 : band == 1 ? 16 : band == 2 ? 12 : band == 3 ? 8 : band == 4 ? 6 : 4;
+    }
+    // base frequency that channels are counted from (MHz), all are arbitrary except 422 is 2Mhz above bottom of 70cm ham band
+    static constexpr uint16_t bandBaseMHz(int band)
+    {
+        return band == 0 ? 144 : band == 1 ? 286 : band == 2 ? 352 : band == 3 ? 422 : band == 4 ? 572 : 852;
+    }
+    // MODEM_CLKGEN_BAND value for the band
+    static constexpr Si4463Band bandConfig(int band)
+    {
+        return band == 0 ? BAND_150 : band == 1 ? BAND_225 : band == 2 ? BAND_300 : band == 3 ? BAND_450 : band == 4 ? BAND_600 : BAND_900;
+    }
+
+    // whether the radio can tune to freq at all
+    static constexpr bool tunable(uint32_t freq)
+    {
+        return (freq / 1000000 >= 142 && freq / 1000000 <= 175) ||
+               (freq / 1000000 >= 284 && freq / 1000000 <= 525) ||
+               (freq / 1000000 >= 850 && freq / 1000000 <= 1050);
+    }
+
+    // finds the band for freq, the closer of the two nominal band frequencies it falls between, -1 if none
+    static constexpr int bandIndex(uint32_t freq, int i = 0)
+    {
+        return !tunable(freq) || i >= NUM_BANDS - 1 ? -1
+               : (freq / 1000000 > bandMHz(i) && freq / 1000000 < bandMHz(i + 1))
+                   ? ((int64_t)freq - bandMHz(i) * 1000000LL < bandMHz(i + 1) * 1000000LL - (int64_t)freq ? i : i + 1)
+                   : bandIndex(freq, i + 1);
+    }
+
+    // see API reference FREQ_CONTROL_INTE for math, the PLL target is base * div / (2 * XO)
+    static constexpr uint64_t pllNum(int band) { return (uint64_t)bandBaseMHz(band) * 1000000ULL * bandDiv(band); }
+    static constexpr uint64_t pllDen() { return 2ULL * XO_FREQ; }
+    // subtract one since fraction part is between 1-2
+    static constexpr uint8_t fInt(int band) { return (uint8_t)((pllNum(band) / pllDen() - 1) & 0x7F); }
+    static constexpr uint32_t fFrac(int band) { return (uint32_t)((((pllNum(band) % pllDen()) + pllDen()) << 19) / pllDen()) & 0x00FFFFFF; }
+    // CHANNEL_STEP in PLL units, rounded
+    static constexpr uint16_t stepSize(int band) { return (uint16_t)(((uint64_t)CHANNEL_STEP * bandDiv(band) * (1ULL << 19) + pllDen() / 2) / pllDen()); }
+
+    // channel to reach freq from the band base, 0 if freq is below the base
+    static constexpr uint8_t channel(uint32_t freq, int band)
+    {
+        return freq < bandBaseMHz(band) * 1000000UL ? 0 : (freq - bandBaseMHz(band) * 1000000UL) / CHANNEL_STEP > 255 ? 255 : (uint8_t)((freq - bandBaseMHz(band) * 1000000UL) / CHANNEL_STEP);
+    }
+    // frequency actually tuned to on a channel
+    static constexpr uint32_t tunedFreq(int band, uint8_t channel) { return bandBaseMHz(band) * 1000000UL + (uint32_t)channel * CHANNEL_STEP; }
+
+    // full frequency config for freq
+    static constexpr Si4463FreqConfig config(uint32_t freq) { return config(freq, bandIndex(freq)); }
+    static constexpr Si4463FreqConfig config(uint32_t freq, int band)
+    {
+        return band == -1 ? Si4463FreqConfig{-1, 0, 0, 0, 0, 0}
+                          : Si4463FreqConfig{(int8_t)band, channel(freq, band), tunedFreq(band, channel(freq, band)), fInt(band), fFrac(band), stepSize(band)};
+    }
+
+    // symbol rate for each Si4463DataRate, 0 if unknown
+    static constexpr uint32_t symbolRate(Si4463DataRate dataRate)
+    {
+        return dataRate == DR_500b ? 500 : dataRate == DR_4_8k ? 4800 : dataRate == DR_9_6k ? 9600 : dataRate == DR_40k ? 40000 : dataRate == DR_100k ? 100000 : dataRate == DR_120k ? 120000 : dataRate == DR_250k ? 250000 : dataRate == DR_500k ? 500000 : 0;
+    }
+    // frequency deviation for modulation index = 0.5, see datasheet for math: 2^19 * div / (2 * XO) * dataRate / 4, rounded
+    // for 4-FSK the inner deviation is specified, but it still needs to be multiplied by 3 to line up with WDS
+    static constexpr uint32_t fDev(int band, Si4463DataRate dataRate, bool fourLevel)
+    {
+        return (uint32_t)(((1ULL << 19) * bandDiv(band) * symbolRate(dataRate) * (fourLevel ? 3 : 1) + pllDen() * 2) / (pllDen() * 4)) & 0x0001FFFF;
+    }
+    // time to send one byte (ms), truncated
+    static constexpr uint32_t byteDelay(Si4463DataRate dataRate) { return symbolRate(dataRate) == 0 ? 0 : 8000 / symbolRate(dataRate); }
+};
+
+#endif
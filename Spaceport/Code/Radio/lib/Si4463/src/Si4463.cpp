@@ -1,5 +1,8 @@
 #include "Si4463.h"
 
+Si4463 *Si4463::irqRadios[Si4463::MAX_IRQ_RADIOS] = {nullptr};
+volatile bool Si4463::spiBusy = false;
+
 Si4463::Si4463()
 {
     // update internal variables with hardware configuration
@@ -46,8 +49,24 @@ Si4463::Si4463(Si4463HardwareConfig hConfig, Si4463PinConfig pConfig)
 
 Si4463::~Si4463()
 {
+    if (this->ownBuf)
+        delete[] this->buf;
     if (this->WDS_CONFIG != nullptr)
         delete[] this->WDS_CONFIG;
+    if (this->rxQueue != nullptr)
+        delete[] this->rxQueue;
+    if (this->rxQueueInfo != nullptr)
+        delete[] this->rxQueueInfo;
+    for (int i = 0; i < this->numProfiles; i++)
+        delete[] this->profiles[i].props;
+    if (this->profileBase != nullptr)
+        delete[] this->profileBase;
+    // stop flagging this radio from the interrupt
+    if (this->irqSlot != -1)
+    {
+        detachInterrupt(digitalPinToInterrupt(this->_irq));
+        irqRadios[this->irqSlot] = nullptr;
+    }
 }
 
 bool Si4463::begin()
@@ -62,8 +81,20 @@ bool Si4463::begin()
     pinMode(_gp2, INPUT);
     pinMode(_gp3, INPUT);
     this->_cts = this->_irq;
+    // look up the GPIO registers once, update() and every SPI transaction read or write these
+    this->csPin.attach(this->_cs);
+    this->irqPin.attach(this->_irq);
+    this->gpioPins[0].attach(this->_gp0);
+    this->gpioPins[1].attach(this->_gp1);
+    this->gpioPins[2].attach(this->_gp2);
+    this->gpioPins[3].attach(this->_gp3);
 
     this->spi->begin();
+#if defined(__IMXRT1062__)
+    // asyncComplete() is run from yield() once a DMA transfer finishes
+    this->spiEvent.setContext(this);
+    this->spiEvent.attach(Si4463::asyncComplete);
+#endif
 
     if (!this->shutdown(true))
         return false;
@@ -73,6 +104,8 @@ bool Si4463::begin()
 
     // complete power on sequence
     this->powerOn();
+    // the chip is back to its defaults, so nothing sent before applies
+    this->shadowLen = 0;
 
     // clear pending interrupts
     uint8_t cIntArgs[3] = {0, 0, 0};
@@ -98,6 +131,10 @@ bool Si4463::begin()
     if (partNo != PART_NO)
         return false; // ERROR: did not receive the correct part number
 
+    // coalesce the properties below into as few SET_PROPERTY commands as possible
+    if (this->batchConfig)
+        this->beginBatch();
+
 #ifndef RF4463F30
     // set the global config, this is the defaults, but apparently a reserved field needs to be set manually
     this->setProperty(G_GLOBAL, P_GLOBAL_CONFIG, 0b01010000);
@@ -114,28 +151,45 @@ bool Si4463::begin()
     // disable interrupts
     this->setProperty(G_INT_CTL, P_INT_CTL_ENABLE, 0x00);
 
-    // set TX and RX thresholds
-    this->setTXThreshold(TX_THRESH);
-    this->setRXThreshold(RX_THRESH);
+    // what switchProfile() restores the properties a profile doesn't set to
+    this->recordProfileBase();
 
     // Set properties from WDS first
     this->applyRadioConfig();
+
+    // set TX and RX thresholds
+    // after the WDS config (the reverse of the old order), handleTX() and handleRX() move txThresh/rxThresh bytes per
+    // FIFO interrupt, so a WDS config that also set PKT_TX/RX_THRESHOLD would leave the radio and the driver disagreeing
+    // on how much room there is. None of the configs in include/ set them, so for those the order changes nothing.
+    this->setTXThreshold(TX_THRESH);
+    this->setRXThreshold(RX_THRESH);
     // set modem (frequency related) config
     this->setModemConfig(this->mod, this->dataRate, this->freq);
     // set power level (127 = ~20 dBm)
     this->setPower(this->pwr);
     // turn on AFC
     this->setAFC(true);
-
-    // set defaults for gpio pins
-    this->setPins(PIN_TX_FIFO_EMPTY, PIN_RX_FIFO_FULL, PIN_RX_STATE, PIN_TX_STATE, PIN_CTS, false);
-    this->useSPICTS = false;
-
     // set defaults for FRRs
-    this->setFRRs(FRR_CURRENT_STATE, FRR_LATCHED_RSSI, FRR_INT_MODEM_PEND, FRR_INT_PH_STATUS);
+    this->setFRRs(FRR_CURRENT_STATE, FRR_LATCHED_RSSI, FRR_INT_CHIP_PEND, FRR_INT_PH_STATUS);
 
     this->setPacketConfig(this->mod, this->preambleLen, this->preambleThresh);
 
+    // send everything staged above
+    if (this->batching)
+        this->commitBatch();
+
+    // set defaults for gpio pins
+    if (this->irqMode)
+    {
+        // nIRQ is needed for interrupts, so CTS has to be checked over SPI
+        this->setPins(PIN_TX_FIFO_EMPTY, PIN_RX_FIFO_FULL, PIN_RX_STATE, PIN_TX_STATE, PIN_NIRQ, false);
+    }
+    else
+    {
+        this->setPins(PIN_TX_FIFO_EMPTY, PIN_RX_FIFO_FULL, PIN_RX_STATE, PIN_TX_STATE, PIN_CTS, false);
+        this->useSPICTS = false;
+    }
+
     // TODO: needs update
     // this->performIRCAL();
 
@@ -143,6 +197,11 @@ bool Si4463::begin()
     uint8_t cIdleArgs[1] = {0b00000011};
     this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
 
+    // start servicing the FIFOs from nIRQ
+    if (this->irqMode && !this->attachIRQ())
+        return false;
+
+    this->began = true;
     return true;
 }
 
@@ -154,73 +213,41 @@ bool Si4463::begin(const uint8_t *config, uint32_t length)
     return this->begin();
 }
 
+
 bool Si4463::tx(const uint8_t *message, int len)
 {
     // make sure the packet isn't too long
     if (len > Si4463::MAX_LEN)
         return false; // Error: the packet is too long
 
-    Serial.println(this->state);
     //  prefill fifo in idle state
-    if (this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE)
+    if ((this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE) && this->allocBuf())
     {
-        Serial.println("tx");
         // add the message to the internal buffer
         this->length = len;
         this->availLen = len;
         this->xfrd = 0;
+        this->txSegs = nullptr;
+        this->txCallback = nullptr;
         memcpy(this->buf, message, this->length);
         // reset available since we have just overwritten the internal buffer
         this->available = false;
 
-        //  enter idle state
-        // uint8_t cIdleArgs[1] = {0b00000011};
-        // this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
-
-        // clear fifo
-        uint8_t cClearFIFO[1] = {0b00000011};
-        this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
-
-        // start spi
-        digitalWrite(this->_cs, LOW);
-
-        // write to TX FIFO
-        this->spi->transfer(C_WRITE_TX_FIFO);
-
-        // send length
-        uint8_t mLen[2] = {0};
-        to_bytes(this->length, 0, 0, mLen);
-        this->spi->transfer(mLen[0]);
-        this->spi->transfer(mLen[1]);
-
-        // send message body
-        int count = 0;
-        while (count++ < FIFO_LENGTH - 2 && this->xfrd < this->length)
-        {
-            this->spi->transfer(this->buf[this->xfrd++]);
-            Serial.print((char)this->buf[this->xfrd - 1]);
-        }
-        Serial.println();
-
-        digitalWrite(this->_cs, HIGH);
-
-        // set packet length for variable length packets
-        // this->setProperty(G_PKT, 2, P_PKT_FIELD_2_LENGTH2, mLen);
-
-        // start tx
-        // enter rx state after tx
-        uint8_t txArgs[6] = {this->channel, 0b00110000, 0, 0, 0, 0};
-        this->spi_write(C_START_TX, sizeof(txArgs), txArgs);
-
-        this->state = STATE_TX;
-
-        return true;
+        return this->beginTX();
     }
     return false;
 }
 
 void Si4463::handleTX()
 {
+    if (this->streamRing != nullptr)
+    {
+        // PACKET_SENT is polled with a queued command so update() doesn't wait for CTS
+        bool sent = this->streamOnAir && this->pollInternal(this->txSentCmd) && (this->txSentCmd.res[0] & PH_PACKET_SENT);
+        if (this->serviceStream(!this->TXEmptyFlag && this->gpio0(), sent))
+            this->TXEmptyFlag = true;
+        return;
+    }
     // Serial.println("handleTX1");
     // Serial.println(this->xfrd);
     // Serial.println(this->length);
@@ -232,39 +259,152 @@ void Si4463::handleTX()
         // Serial.println("handleTX");
         // Serial.println(this->xfrd);
         // Serial.println(this->availLen);
-        digitalWrite(this->_cs, LOW);
+        this->writeTXFIFO(this->txThresh);
+    }
+    // if we've sent this->length bytes, the message is complete
+    if (this->xfrd == this->length)
+        this->completeTX();
+}
 
-        // write to the TX FIFO
-        this->spi->transfer(C_WRITE_TX_FIFO);
+bool Si4463::txSegments(const Si4463Segment *segs, uint8_t count, void (*onComplete)(void *), void *ctx)
+{
+    // add up the total length of the message
+    uint32_t totalLen = 0;
+    for (int i = 0; i < count; i++)
+        totalLen += segs[i].len;
+    // make sure the packet isn't too long and we have at least 1 byte
+    if (totalLen > Si4463::MAX_LEN || totalLen == 0)
+        return false; // Error: the packet is too long
 
-        // write remaining data
-        int count = 0;
-        while (count++ < TX_THRESH && this->xfrd < this->availLen)
-        {
-            this->spi->transfer(this->buf[this->xfrd++]);
-            // Serial.print((char)this->buf[this->xfrd - 1]);
-        }
-        // Serial.println();
+    //  prefill fifo in idle state
+    if (this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE)
+    {
+        // bytes are read straight from the segments, buf is not used
+        this->txSegs = segs;
+        this->txSegCount = count;
+        this->txSegIdx = 0;
+        this->txSegOff = 0;
+        this->txCallback = onComplete;
+        this->txCallbackCtx = ctx;
+        this->length = totalLen;
+        this->availLen = totalLen;
+        this->xfrd = 0;
 
-        digitalWrite(this->_cs, HIGH);
+        return this->beginTX();
     }
-    // if we've sent this->length bytes, the message is complete
-    if (this->xfrd == this->length)
+    return false;
+}
+
+bool Si4463::txNoCopy(const uint8_t *message, uint16_t len, void (*onComplete)(void *), void *ctx)
+{
+    // single segment version of txSegments()
+    this->txSingle = {message, len};
+    return this->txSegments(&this->txSingle, 1, onComplete, ctx);
+}
+
+bool Si4463::startStream(uint8_t *ring, uint16_t size, uint16_t frameLen)
+{
+    // each frame needs the header and at least one payload byte
+    if (ring == nullptr || size < 2 || frameLen <= Si4463::STREAM_HEADER_LEN || frameLen > Si4463::MAX_LEN)
+        return false;
+
+    if (this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE)
     {
-        // automatically placed into an idle state
-        this->state = STATE_TX_COMPLETE;
-        // clear internal variables
-        memset(this->buf, 0, this->length);
+        this->streamSize = size;
+        this->streamFrameLen = frameLen;
+        this->streamHead = 0;
+        this->streamTail = 0;
+        this->streamOut = 0;
+        this->streamLoading = false;
+        this->streamStarted = false;
+        this->streamOnAir = false;
+        this->streamEnding = false;
+        this->streamEndOpened = false;
+        this->txSegs = nullptr;
+        this->txCallback = nullptr;
         this->length = 0;
         this->availLen = 0;
         this->xfrd = 0;
+        this->txStarved = false;
+        // reset available since buf is no longer holding a received message
+        this->available = false;
+
+        // clear the FIFO and any PACKET_SENT left over from an earlier transmission
+        uint8_t cClearFIFO[1] = {0b00000011};
+        this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
+        uint8_t cPHArgs[1] = {0xFF ^ PH_PACKET_SENT};
+        uint8_t rPHArgs[2] = {};
+        this->sendCommand(C_GET_PH_STATUS, sizeof(cPHArgs), cPHArgs, sizeof(rPHArgs), rPHArgs);
+        if (this->txSentCmd.done())
+            this->txSentCmd.status = CMD_IDLE;
+        // wait in TX_TUNE so the first frame starts as quickly as the rest
+        uint8_t cTuneArgs[1] = {0b00000101};
+        this->sendCommandC(C_CHANGE_STATE, 1, cTuneArgs);
+
+        // set last so the interrupt never sees a half set up stream
+        this->streamRing = ring;
+        this->state = STATE_TX;
+        return true;
     }
+    return false;
+}
+
+uint16_t Si4463::writeStream(const uint8_t *data, uint16_t len)
+{
+    if (this->streamRing == nullptr || this->streamEnding)
+        return 0;
+
+    uint16_t space = this->streamSpace();
+    if (len > space)
+        len = space;
+    if (len == 0)
+        return 0;
+
+    // copy in up to two pieces, wrapping around the end of the ring
+    uint16_t head = this->streamHead;
+    uint16_t first = this->streamSize - head;
+    if (first > len)
+        first = len;
+    memcpy(this->streamRing + head, data, first);
+    memcpy(this->streamRing, data + first, len - first);
+    this->streamHead = (head + len) % this->streamSize;
+    return len;
+}
+
+uint16_t Si4463::streamSpace()
+{
+    if (this->streamRing == nullptr)
+        return 0;
+    return this->streamSize - 1 - this->streamBuffered();
+}
+
+void Si4463::endStream()
+{
+    if (this->streamRing == nullptr)
+        return;
+    this->streamEnding = true;
+}
+
+bool Si4463::streaming()
+{
+    return this->streamRing != nullptr;
+}
+
+bool Si4463::readStreamHeader(const uint8_t *frame, uint16_t len, Si4463StreamHeader &header)
+{
+    if (frame == nullptr || len < Si4463::STREAM_HEADER_LEN)
+        return false;
+    header.flags = frame[0];
+    // from_bytes() adds to the value
+    header.offset = 0;
+    from_bytes(header.offset, 1, 0, (uint8_t *)frame);
+    return true;
 }
 
 bool Si4463::rx()
 {
-    // make sure we aren't already in RX mode
-    if (this->state == STATE_IDLE)
+    // make sure we aren't already in RX mode, without a queue packets are received into buf
+    if (this->state == STATE_IDLE && (this->rxQueueSlots > 0 || this->allocBuf()))
     {
         // reset availLen
         this->availLen = 0;
@@ -274,17 +414,18 @@ bool Si4463::rx()
         // uint8_t cIdleArgs[1] = {0b00000011};
         // this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
 
-        // clear fifo
-        uint8_t cClearFIFO[1] = {0b00000011};
-        this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
+        // responses from an abandoned packet don't apply to the next one
+        this->resetRXCommands();
+
+        // clear fifo, queued so rx() doesn't wait for CTS
+        this->queueInternal(this->clearFIFOCmd);
 
         // set back to max length for rx mode?
         // uint8_t cLen2[2] = {0x1f, 0xff};
         // this->setProperty(G_PKT, 2, P_PKT_FIELD_2_LENGTH2, cLen2);
 
         // enter RX mode
-        uint8_t rxArgs[7] = {this->channel, 0, 0, 0, 0x08, 0x03, 0x08};
-        this->spi_write(C_START_RX, 7, rxArgs);
+        this->startRX(true);
         this->state = STATE_RX;
         return true;
     }
@@ -322,115 +463,51 @@ void Si4463::handleRX()
         // Serial.println("FIFO STATUS");
         // for (int i = 0; i < sizeof(rClearFIFO); i++)
         //     Serial.println(rClearFIFO[i]);
-        // rssi should be available
+        // rssi should be available, the response is collected by a later update()
         if (this->xfrd == 0)
-            this->rssi = this->readFRR(1);
-        digitalWrite(this->_cs, LOW);
-
-        // read from RX FIFO
-        this->spi->transfer(C_READ_RX_FIFO);
-
-        // holds data received this iteration
-        int lenBytes = 0;
+            this->queueInternal(this->signalCmd);
 
-        // if the internal length and xfrd variables are 0, then this is the first part of the message
+        // read the length (if needed) and message data
+        if (!this->readRXFIFO(this->rxThresh))
+            return; // error, message too long or too short
+    }
+    // the commands below are queued so update() never waits for CTS, each call checks if the last one has come back
+    if (this->length > 0 && (this->length - this->xfrd < this->rxThresh))
+    {
+        // short packets never fill the FIFO past the threshold, so the signal hasn't been read yet
+        // queued before the status checks below, so the response is in before the packet completes
         if (this->xfrd == 0)
+            this->queueInternal(this->signalCmd);
+
+        if (this->crc != CRC_NONE)
         {
-            // so we need to read length
-            uint8_t mLen[2] = {0x00, 0x00};
-            mLen[0] = this->spi->transfer(0x00);
-            mLen[1] = this->spi->transfer(0x00);
-            // convert individual bytes to uint16_t
-            from_bytes(this->length, 0, 0, mLen);
-            // Serial.print("len ");
-            // Serial.println(this->length);
-            lenBytes += 2;
-            // make sure the message is not too long (could be erroneous transmission)
-            if (this->length > Si4463::MAX_LEN || this->length == 0)
+            // wait for the packet handler to check the crc before reading the rest of the packet
+            if (!this->pollInternal(this->phStatusCmd))
+                return;
+            if (this->phStatusCmd.res[0] & PH_CRC_ERROR)
             {
-                this->length = 0;
-                return; // error, message too long or too short
+                this->discardRX();
+                return;
             }
+            if (!(this->phStatusCmd.res[0] & PH_PACKET_RX))
+                return;
+            // the packet passed, so all of it is in the FIFO
+            this->readRXFIFO(this->length - this->xfrd);
+            return;
         }
 
-        // receive message data
-        int count = lenBytes;
-        while (this->xfrd < this->length && count < RX_THRESH)
-        {
-            count++;
-            this->buf[this->xfrd++] = this->spi->transfer(0x00);
-            // Serial.print((char)this->buf[this->xfrd - 1]);
-        }
-        // Serial.println();
-        digitalWrite(this->_cs, HIGH);
-        // Serial.print("count ");
-        // Serial.print(count);
-        // Serial.print("xfrd ");
-        // Serial.println(this->xfrd);
-
-        // if we've transferred length bytes, we've received the whole message
-        if (this->xfrd == this->length && this->length > 0)
-        {
-            // Serial.println("Complete");
-            // automatically placed into an idle state
-            this->state = STATE_RX_COMPLETE;
-            this->available = true;
-            // only reset xfrd and availLen
-            // length and buf need to stay so they can be read
-            this->xfrd = 0;
-            this->availLen = 0;
-        }
-    }
-    if (this->length > 0 && (this->length - this->xfrd < RX_THRESH))
-    {
         // Serial.println("Here2");
         // Serial.println(this->xfrd);
         // Serial.println(this->length);
-        uint8_t cFIFOInfo[1] = {0b00000000};
-        uint8_t rFIFOInfo[2] = {0x00, 0x00};
-        sendCommand(C_FIFO_INFO, 1, cFIFOInfo, 2, rFIFOInfo);
+        if (!this->pollInternal(this->fifoInfoCmd))
+            return;
         // Serial.println("FIFO STATUS");
         // for (int i = 0; i < sizeof(rFIFOInfo); i++)
         //     Serial.println(rFIFOInfo[i]);
 
         // dont need to send an SPI command unless there's actually bytes to read
-        if (rFIFOInfo[0] > 0) // TODO: is there a better way to do this?
-        {
-
-            digitalWrite(this->_cs, LOW);
-
-            // read from RX FIFO
-            this->spi->transfer(C_READ_RX_FIFO);
-
-            // receive message data
-            int count = 0;
-            while (this->xfrd < this->length && count < rFIFOInfo[0])
-            {
-                count++;
-                this->buf[this->xfrd++] = this->spi->transfer(0x00);
-                // Serial.print((char)this->buf[this->xfrd - 1]);
-            }
-            // Serial.println();
-            // Serial.print("count ");
-            // Serial.print(count);
-            // Serial.print("\txfrd ");
-            // Serial.println(this->xfrd);
-
-            digitalWrite(this->_cs, HIGH);
-        }
-
-        // if we've transferred length bytes, we've received the whole message
-        if (this->xfrd == this->length)
-        {
-            // Serial.println("Complete2");
-            // automatically placed into an idle state
-            this->state = STATE_RX_COMPLETE;
-            this->available = true;
-            // this->hasPacket = false;
-            // only reset xfrd
-            // length and buf need to stay so they can be read
-            this->xfrd = 0;
-        }
+        if (this->fifoInfoCmd.res[0] > 0) // TODO: is there a better way to do this?
+            this->readRXFIFO(this->fifoInfoCmd.res[0]);
     }
     // if (!gpio2())
     // {
@@ -438,12 +515,58 @@ void Si4463::handleRX()
     //     this->state = STATE_IDLE;
     //     this->available = false;
     // }
-    // if (rIntArgs[2] & 0b00001000)
-    // {
-    //     Serial.println("Invalid packet! CRC failed.");
-    //     this->state = STATE_IDLE;
-    //     this->available = false;
-    // }
+}
+
+void Si4463::discardRX()
+{
+    this->linkStats.crcErrors++;
+    // drop whatever has been read so far, length and buf are not valid
+    this->xfrd = 0;
+    this->length = 0;
+    this->availLen = 0;
+    this->resetRXCommands();
+    // clear the rest of the packet out of the FIFO without reading it
+    uint8_t cClearFIFO[1] = {0b00000010};
+    this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
+    // the radio goes back to RX on its own after an invalid packet (START_RX RXINVALID_STATE)
+}
+
+void Si4463::signalLatched(Si4463Command *cmd, void *ctx)
+{
+    if (cmd->status != CMD_DONE)
+        return;
+    Si4463 *radio = (Si4463 *)ctx;
+    // latched when the sync word was detected
+    radio->rssi = cmd->res[3];
+    uint16_t afc = 0;
+    from_bytes(afc, 6, 0, cmd->res);
+    radio->linkStats.afc = (int16_t)afc;
+}
+
+void Si4463::recordCTS(uint32_t us)
+{
+    // buckets double in width, so short waits are resolved finely and long ones still fit
+    uint8_t bin = 0;
+    uint32_t limit = Si4463Stats::CTS_HIST_BASE;
+    while (us >= limit && bin < Si4463Stats::CTS_HIST_BINS - 1)
+    {
+        limit <<= 1;
+        bin++;
+    }
+    this->linkStats.ctsWaits[bin]++;
+}
+
+void Si4463::checkFIFOError(uint8_t chipPend)
+{
+    if (!(chipPend & CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR))
+        return;
+    // the TX FIFO can only underflow while transmitting, otherwise it was the RX FIFO
+    if (this->state == STATE_TX || this->state == STATE_TX_COMPLETE)
+        this->linkStats.txUnderflows++;
+    else
+        this->linkStats.rxOverflows++;
+    // clear it without waiting for the response
+    this->queueInternal(this->chipStatusCmd);
 }
 
 bool Si4463::startTX(const uint8_t *data, uint16_t len, uint16_t totalLen)
@@ -453,56 +576,17 @@ bool Si4463::startTX(const uint8_t *data, uint16_t len, uint16_t totalLen)
         return false; // Error: the packet is too long
 
     //  prefill fifo in idle state
-    if (this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE)
+    if ((this->state == STATE_IDLE || this->state == STATE_RX || this->state == STATE_RX_COMPLETE) && this->allocBuf())
     {
         // otherwise add the message to the internal buffer
         this->length = totalLen;
         this->availLen = len;
         this->xfrd = 0;
+        this->txSegs = nullptr;
+        this->txCallback = nullptr;
         memcpy(this->buf, data, this->availLen);
         // Serial.println("tx");
-        //  enter idle state
-        // uint8_t cIdleArgs[1] = {0b00000011};
-        // this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
-
-        // clear fifo
-        uint8_t cClearFIFO[1] = {0b00000011};
-        this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
-
-        // start spi
-        digitalWrite(this->_cs, LOW);
-
-        // write to TX FIFO
-        this->spi->transfer(C_WRITE_TX_FIFO);
-
-        // send length
-        uint8_t mLen[2] = {0};
-        to_bytes(this->length, 0, 0, mLen);
-        this->spi->transfer(mLen[0]);
-        this->spi->transfer(mLen[1]);
-
-        // send message body
-        int count = 0;
-        while (count++ < FIFO_LENGTH - 2 && this->xfrd < this->availLen)
-        {
-            this->spi->transfer(this->buf[this->xfrd++]);
-            // Serial.print((char)this->buf[this->xfrd - 1]);
-        }
-        // Serial.println();
-
-        digitalWrite(this->_cs, HIGH);
-
-        // set packet length for variable length packets
-        // this->setProperty(G_PKT, 2, P_PKT_FIELD_2_LENGTH2, mLen);
-
-        // start tx
-        // enter rx state after tx
-        uint8_t txArgs[6] = {this->channel, 0b00110000, 0, 0, 0, 0};
-        this->spi_write(C_START_TX, sizeof(txArgs), txArgs);
-
-        this->state = STATE_TX;
-
-        return true;
+        return this->beginTX();
     }
     return false;
 }
@@ -520,6 +604,12 @@ uint16_t Si4463::writeTXBuf(const uint8_t *data, uint16_t len)
         // copy from the array into the internal buf
         memcpy(this->buf + this->availLen, data, len);
         this->availLen += len;
+        // in IRQ mode the FIFO interrupt was already used up if we ran out of bytes, so refill here
+        if (this->irqMode && this->txStarved)
+        {
+            this->txStarved = false;
+            this->retryIRQ();
+        }
         // len will be the number of bytes copied
         return len;
     }
@@ -539,8 +629,12 @@ uint16_t Si4463::readRXBuf(uint8_t *data, uint16_t len)
             len = this->xfrd - this->availLen;
         else if ((this->state == STATE_IDLE || this->state == STATE_RX_COMPLETE) && this->availLen + len > this->length)
             len = this->length - this->availLen;
+        // a packet still being received may be going straight into the RX queue
+        const uint8_t *src = this->state == STATE_RX ? this->rxDest() : this->buf;
+        if (src == nullptr)
+            return 0;
         // copy from the internal buf into the array
-        memcpy(data, this->buf + this->availLen, len);
+        memcpy(data, src + this->availLen, len);
         this->availLen += len;
         // len will be the number of bytes copied
         return len;
@@ -551,6 +645,8 @@ uint16_t Si4463::readRXBuf(uint8_t *data, uint16_t len)
 
 void Si4463::update()
 {
+    // send queued commands and collect their responses
+    this->pollCommands();
 #ifndef RF4463F30
 
     if (this->state == STATE_TX_COMPLETE)
@@ -602,6 +698,38 @@ void Si4463::update()
         }
     }
 #endif
+    this->serviceFIFOs();
+    // throttle reading and writing a bit cause the teensy does it faster than the FIFO status pins update
+    if (millis() - this->timer > this->byteDelay)
+    {
+        this->timer = millis();
+        // check if we are transmitting and the FIFO is almost empty
+        // check if we are receving and the FIFO is almost full
+    }
+}
+
+void Si4463::serviceFIFOs()
+{
+    // in IRQ mode the FIFOs are serviced by the interrupt, update() only does what needs commands
+    if (this->irqMode)
+    {
+        // the interrupt leaves the radio alone while update() uses it
+        this->irqHeld = true;
+        this->finishIRQ();
+        // service anything the interrupt skipped or couldn't clear, an edge missed while attaching (nIRQ stays low
+        // until cleared), or a stream frame opened behind the one being sent, which has no interrupt of its own yet
+        if (this->irqPending || !this->irq() || (this->streamRing != nullptr && this->streamLoading && this->xfrd < this->length))
+        {
+            this->irqPending = false;
+            this->serviceIRQ();
+        }
+        this->irqHeld = false;
+        // interrupted while held
+        if (this->irqPending)
+            this->retryIRQ();
+        return;
+    }
+
     if (this->TXEmptyFlag && !this->gpio0())
     {
         this->TXEmptyFlag = false;
@@ -625,13 +753,6 @@ void Si4463::update()
     {
         this->handleRX();
     }
-    // throttle reading and writing a bit cause the teensy does it faster than the FIFO status pins update
-    if (millis() - this->timer > this->byteDelay)
-    {
-        this->timer = millis();
-        // check if we are transmitting and the FIFO is almost empty
-        // check if we are receving and the FIFO is almost full
-    }
 }
 
 bool Si4463::send(Data &data)
@@ -649,6 +770,17 @@ bool Si4463::send(Data &data)
 
 bool Si4463::receive(Data &data)
 {
+    // take the oldest packet from the queue if there is one
+    if (this->rxQueueSlots > 0)
+    {
+        if (this->rxHead == this->rxTail)
+            return false;
+        uint8_t slot = this->rxTail;
+        this->m.fill(this->rxQueue + slot * this->rxQueueSlotLen, this->rxQueueInfo[slot].length)->decode(&data);
+        this->rxTail = (slot + 1) % this->rxQueueSlots;
+        return true;
+    }
+
     // check if we have received the whole message
     if (this->state == STATE_RX_COMPLETE)
     {
@@ -662,158 +794,280 @@ bool Si4463::receive(Data &data)
 
 int Si4463::RSSI() { return this->rssi / 2 - 64 - 70; } // magic formula from datasheet
 
-bool Si4463::avail()
-{
-    // if we are not in receive mode, enter receive mode
-    if (this->state == STATE_IDLE)
-        this->rx();
-    else
-        // otherwise return whether we have fully received a message
-        return this->available;
-    return false;
-}
-
-void Si4463::setModemConfig(Si4463Mod mod, Si4463DataRate dataRate, uint32_t freq)
+void Si4463::handleIRQ()
 {
-    // set modulation
-    this->setProperty(G_MODEM, P_MODEM_MOD_TYPE, mod);
-    this->setProperty(G_MODEM, P_MODEM_MAP_CONTROL, 0x00);
-
-    // figure out which band to use
-
-    // parallel arrays to find correct enum
-    Si4463Band bandConfigs[6] = {BAND_150, BAND_225, BAND_300, BAND_450, BAND_600, BAND_900};
-    float bandDivs[6] = {24.0, 16.0, 12.0, 8.0, 6.0, 4.0};
-    int bands[6] = {150, 225, 300, 450, 600, 900};
-    int bandBases[6] = {144, 286, 352, 422, 572, 852}; // all are arbitrary except 422 is 2Mhz above bottom of 70cm ham band
-
-    int freqBand = freq / 1e6; // purposefully truncated due to integer division
-    // index of correct band
-    int band = -1;
-    // fInt and fFrac (see datasheet for formula)
-    uint8_t fInt = 0;
-    uint32_t fFrac = 0;
-
-    if (!((freqBand >= 142 && freqBand <= 175) ||
-          (freqBand >= 284 && freqBand <= 350) ||
-          (freqBand >= 350 && freqBand <= 420) ||
-          (freqBand >= 420 && freqBand <= 525) ||
-          (freqBand >= 850 && freqBand <= 1050)))
+    // update() is using the radio, or a DMA transfer has the bus, so it is serviced from the main loop instead
+    if (this->irqHeld || Si4463::spiBusy)
     {
-        Serial.println("Error: cannot tune to this frequency");
+        this->irqPending = true;
         return;
     }
+    this->serviceIRQ();
+}
 
-    // loop through each band
-    for (int i = 0; i < 5; i++)
+void Si4463::serviceIRQ()
+{
+    // the FIFO interrupts only come again once the FIFO crosses its threshold, so keep going until it is past it
+    bool moved = true;
+    while (moved)
     {
-        // check if our frequency is above the current band and below the next band
-        if (freqBand > bands[i] && freqBand < bands[i + 1])
+        moved = false;
+        // PH_PEND, CHIP_PEND and PH_STATUS (FRRs B to D in IRQ mode, see attachIRQ()), no need to wait for CTS
+        uint8_t frr[4] = {};
+        this->readFRRs(frr, 1);
+        uint8_t phPend = frr[0] & Si4463::IRQ_PH_ENABLE;
+        if (frr[1] & CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR)
+            this->irqChipPend |= frr[1];
+        // the FIFO thresholds are acted on by their level (PH_STATUS), the packet events by their pending bit
+        uint8_t phStatus = frr[2];
+        uint8_t events = phPend & ~this->irqSeen;
+
+        // cleared before servicing so anything raised in the meantime brings nIRQ low again
+        if (phPend != 0)
         {
-            // find the difference between our frequency and the current band
-            int lowerDiff = freq - bands[i] * 1e6;
-            // find the difference between our frequency and the next band
-            int upperDiff = -1 * (freq - bands[i + 1] * 1e6);
-            // see which difference is smaller
-            if (lowerDiff < upperDiff)
-                band = i;
+            if (this->clearIRQ(phPend))
+                this->irqSeen = 0;
             else
-                band = i + 1;
-
-            // now we know what band we're in, but we need to tune to the band base frequency and then use channels
-            // to get the frequency we want
-            double baseFreq = bandBases[band];
-            // find the channel (100kHz channel step size)
-            this->channel = (uint8_t)(((double)freq / 1e6 - baseFreq) / 0.1);
-            // set the internal frequency to the actual frequency tuned to (may not be the set frequency since step size is 0.1MHz)
-            this->freq = (baseFreq + (double)this->channel * 0.1) * 1e6;
-
-            // see API reference FREQ_CONTROL_INTE for math
-            int combinedIntFrac = baseFreq * 1e6 / (2 * (int)30e6 / (int)bandDivs[band]);               // we want to truncate to find the integer part
-            fInt = combinedIntFrac - 1;                                                                 // subtract one since fraction part is between 1-2
-            float intFracFraction = baseFreq * 1e6 / (2 * 30e6 / bandDivs[band]) - combinedIntFrac + 1; // don't want to truncate to get fractional part
-            fFrac = intFracFraction * pow(2, 19);                                                       // from datasheet math, may truncate, but this is as close as we can get
-            break;
+            {
+                this->irqSeen |= events & (PH_PACKET_SENT | PH_PACKET_RX | PH_CRC_ERROR);
+                this->irqPending = true;
+            }
         }
-    }
+        this->irqEvents |= events & (PH_PACKET_SENT | PH_CRC_ERROR);
 
-    // set frequency
-    // make sure we found the band and computed fInt and fFrac
-    if (band != -1 && !(fInt == 0 && fFrac == 0))
-    {
-        this->setProperty(G_MODEM, P_MODEM_CLKGEN_BAND, bandConfigs[band]);
-        uint8_t freqArgs[4] = {(uint8_t)(fInt & 0b01111111)};                // first bit must be 0
-        fFrac &= 0x00FFFFFF;                                                 // first byte must be 0
-        to_bytes(fFrac, 1, 1, freqArgs);                                     // put fFrac into freqArgs
-        this->setProperty(G_FREQ_CONTROL, 4, P_FREQ_CONTROL_INTE, freqArgs); // set FREQ_CONTROL_INTE and FREQ_CONTROL_FRAC
+        if (this->state == STATE_TX && (phStatus & PH_TX_FIFO_ALMOST_EMPTY))
+        {
+            // a stream only has bytes to write while a frame is loading, update() opens and starts the frames
+            bool loading = this->streamRing == nullptr || this->streamLoading;
+            if (loading && this->xfrd < this->availLen)
+            {
+                this->writeTXFIFO(this->txThresh);
+                moved = true;
+            }
+            else if (this->streamRing == nullptr && this->xfrd < this->length)
+                this->txStarved = true; // writeTXBuf() will refill once more data is added
+        }
+
+        // a bad packet is dropped by update(), nothing more of it is read
+        if (this->state == STATE_RX && !(this->irqEvents & PH_CRC_ERROR))
+        {
+            if (events & PH_PACKET_RX)
+            {
+                // the rest of the packet is in the FIFO, all of it if it never reached the threshold
+                if (this->xfrd == 0)
+                    this->irqSignal = true;
+                uint16_t left = this->xfrd == 0 ? FIFO_LENGTH : this->length - this->xfrd;
+                this->readRXFIFO(left < FIFO_LENGTH ? left : FIFO_LENGTH);
+                moved = true;
+            }
+            else if (phStatus & PH_RX_FIFO_ALMOST_FULL)
+            {
+                // the last byte is left for PACKET_RX, so a packet is never finished before the crc is checked
+                uint16_t count = this->rxThresh;
+                if (this->xfrd > 0 && this->length - this->xfrd <= count)
+                    count = this->length - this->xfrd - 1;
+                if (count > 0)
+                {
+                    if (this->xfrd == 0)
+                        this->irqSignal = true;
+                    this->readRXFIFO(count);
+                    moved = true;
+                }
+            }
+        }
     }
-    else
+}
+
+bool Si4463::clearIRQ(uint8_t pend)
+{
+    // GET_PH_STATUS would overwrite the response to a command the main loop is waiting on
+    if (this->cmdOpen || (this->cmdHead != this->cmdTail && this->cmdQueue[this->cmdTail]->status == CMD_SENT &&
+                          this->cmdQueue[this->cmdTail]->resLen > 0))
+        return false;
+
+    // anything else sent is short (SET_PROPERTY, START_TX, the last clear), so wait for it instead of leaving nIRQ low
+    uint32_t start = micros();
+    while (!this->checkCTS())
     {
-        Serial.println("ERROR: could not find frequency");
-        return; // Error: could not find frequency
+        if (micros() - start > Si4463::CTS_TIMEOUT * 1000)
+            return false;
     }
 
-    // set 100kHz channel step size
-    uint8_t stepSizeArgs[] = {0x1b, 0x4f};
-    this->setProperty(G_FREQ_CONTROL, 2, P_FREQ_CONTROL_CHANNEL_STEP_SIZE2, stepSizeArgs);
+    this->select();
+    this->spi->transfer(C_GET_PH_STATUS);
+    // a 0 bit clears the interrupt, the response isn't needed
+    this->spi->transfer(~pend);
+    this->deselect();
+    this->irqCmd = true;
+    return true;
+}
 
-    // set data rate
-    uint8_t drArgs[7] = {};
-    to_bytes(dataRate, 0, 1, drArgs);
-    this->setProperty(G_MODEM, 7, P_MODEM_DATA_RATE3, drArgs);
+void Si4463::retryIRQ()
+{
+    // the interrupt leaves the radio alone while it is held, so the two never service it at once
+    this->irqHeld = true;
+    this->irqPending = false;
+    this->serviceIRQ();
+    this->irqHeld = false;
+}
 
-    // set frequency deviation, modulation index = 0.5
-    // see datasheet for math, this includes everything but a bitrate dependent factor and 4-FSK correction
-    float fDev = (double)pow(2, 19) * (double)bandDivs[band] / (2.0 * 30e6);
-    if (mod == MOD_4FSK || mod == MOD_4GFSK)
-        // we want the inner deviation when we are using 4-FSK but still need to multiply by 3 for some reason
-        // quote from API docs: "For 4(G)FSK mode (if supported), the specified value is the inner deviation"
-        // could be referring to the specified inner deviation (see below), with the need to multiply by 3 implied
-        // The calculations here line up with what WDS says, so theoretically they are correct
-        fDev *= 3.0;
-    switch (dataRate)
-    {
-    case DR_500b:
-        fDev *= (500.0 / 4.0);               // this adds the desired frequency to fdev, should be dataRate / 2
-        this->byteDelay = 1 / (500.0 / 8e3); // ms/byte
-        break;
-    case DR_4_8k:
-        fDev *= (4800.0 / 4.0);
-        this->byteDelay = 1 / (4800.0 / 8e3);
-        break;
-    case DR_9_6k:
-        fDev *= (9600.0 / 4.0);
-        this->byteDelay = 1 / (9600.0 / 8e3);
-        break;
-    case DR_40k:
-        fDev *= (40e3 / 4.0);
-        this->byteDelay = 1 / (40e3 / 8e3);
-        break;
-    case DR_100k:
-        fDev *= (100e3 / 4.0);
-        this->byteDelay = 1 / (100e3 / 8e3);
-        break;
-    case DR_120k:
-        fDev *= (120e3 / 4.0);
-        this->byteDelay = 1 / (120e3 / 8e3);
-        break;
-    case DR_250k:
-        fDev *= (250e3 / 4.0);
-        this->byteDelay = 1 / (250e3 / 8e3);
-        break;
-    case DR_500k:
-        fDev *= (500e3 / 4.0);
-        this->byteDelay = 1 / (500e3 / 8e3);
-        break;
-    default:
+void Si4463::finishIRQ()
+{
+    // the interrupt doesn't change these while the radio is held
+    uint8_t events = this->irqEvents;
+    this->irqEvents = 0;
+
+    if (this->irqSignal)
+    {
+        this->irqSignal = false;
+        this->queueInternal(this->signalCmd);
+    }
+    // FRR C shows the error until the queued clear is done, so it is only counted once
+    if (this->irqChipPend != 0)
+    {
+        if (this->chipStatusCmd.status != CMD_QUEUED && this->chipStatusCmd.status != CMD_SENT)
+            this->checkFIFOError(this->irqChipPend);
+        this->irqChipPend = 0;
+    }
+
+    if ((events & PH_CRC_ERROR) && this->state == STATE_RX)
+        this->discardRX();
+
+    // nothing raises an interrupt while a stream is quiet, so the next frame (or STREAM_END) is started from here
+    // writeStream() and endStream() only leave the bytes and flags for this, they never start a frame themselves
+    if (this->state == STATE_TX && this->streamRing != nullptr)
+        this->serviceStream(false, events & PH_PACKET_SENT);
+    // if we've transferred length bytes, we've sent the whole message
+    else if (this->state == STATE_TX && this->xfrd == this->length)
+        this->completeTX();
+
+    if ((events & PH_PACKET_SENT) && this->state == STATE_TX_COMPLETE)
+        this->state = STATE_IDLE;
+}
+
+bool Si4463::setRXQueue(uint8_t depth, uint16_t slotLen)
+{
+    // can't change the queue while receiving into it
+    if (this->state == STATE_RX)
+        return false;
+
+    if (this->rxQueue != nullptr)
+        delete[] this->rxQueue;
+    if (this->rxQueueInfo != nullptr)
+        delete[] this->rxQueueInfo;
+    this->rxQueue = nullptr;
+    this->rxQueueInfo = nullptr;
+    this->rxQueueSlots = 0;
+    this->rxHead = 0;
+    this->rxTail = 0;
+
+    if (depth == 0)
+        return true;
+    if (depth == 255 || slotLen == 0 || slotLen > Si4463::MAX_LEN)
+        return false;
+
+    this->rxQueue = new uint8_t[(depth + 1) * slotLen];
+    this->rxQueueInfo = new Si4463RXPacket[depth + 1];
+    this->rxQueueSlotLen = slotLen;
+    this->rxQueueSlots = depth + 1;
+    return true;
+}
+
+uint8_t Si4463::rxQueued()
+{
+    if (this->rxQueueSlots == 0)
+        return 0;
+    return (this->rxHead + this->rxQueueSlots - this->rxTail) % this->rxQueueSlots;
+}
+
+uint16_t Si4463::readRXQueue(uint8_t *data, uint16_t len, Si4463RXPacket *info)
+{
+    if (this->rxQueueSlots == 0 || this->rxHead == this->rxTail)
+        return 0;
+
+    uint8_t slot = this->rxTail;
+    if (len > this->rxQueueInfo[slot].length)
+        len = this->rxQueueInfo[slot].length;
+    memcpy(data, this->rxQueue + slot * this->rxQueueSlotLen, len);
+    if (info != nullptr)
+        *info = this->rxQueueInfo[slot];
+    // free the slot for the radio
+    this->rxTail = (slot + 1) % this->rxQueueSlots;
+    return len;
+}
+
+const Si4463Stats &Si4463::stats()
+{
+    return this->linkStats;
+}
+
+void Si4463::resetStats()
+{
+    this->linkStats = {};
+}
+
+bool Si4463::avail()
+{
+    // with a queue, the radio stays in RX so just check for queued packets
+    if (this->rxQueueSlots > 0)
+    {
+        if (this->state == STATE_IDLE)
+            this->rx();
+        return this->rxHead != this->rxTail;
+    }
+    // if we are not in receive mode, enter receive mode
+    if (this->state == STATE_IDLE)
+        this->rx();
+    else
+        // otherwise return whether we have fully received a message
+        return this->available;
+    return false;
+}
+
+void Si4463::setModemConfig(Si4463Mod mod, Si4463DataRate dataRate, uint32_t freq)
+{
+    // set modulation
+    this->setProperty(G_MODEM, P_MODEM_MOD_TYPE, mod);
+    this->setProperty(G_MODEM, P_MODEM_MAP_CONTROL, 0x00);
+
+    // look up the band, channel, and PLL settings (all integer math, constant folded for fixed frequencies)
+    Si4463FreqConfig f = Si4463FreqPlan::config(freq);
+    if (f.band == -1)
+    {
+        Serial.println("Error: cannot tune to this frequency");
+        return; // Error: could not find frequency
+    }
+    uint32_t rate = Si4463FreqPlan::symbolRate(dataRate);
+    if (rate == 0)
+    {
         Serial.println("ERROR: could not find data rate");
         return; // Error: data rate is not part of the Si4463DataRate enum (should never happen)
     }
+    this->band = f.band;
+    this->channel = f.channel;
+    // set the internal frequency to the actual frequency tuned to (may not be the set frequency since step size is 0.1MHz)
+    this->freq = f.freq;
+    this->byteDelay = Si4463FreqPlan::byteDelay(dataRate); // ms/byte
+
+    // set frequency
+    this->setProperty(G_MODEM, P_MODEM_CLKGEN_BAND, Si4463FreqPlan::bandConfig(f.band));
+    uint8_t freqArgs[4] = {f.fInt};
+    to_bytes(f.fFrac, 1, 1, freqArgs);                                   // put fFrac into freqArgs
+    this->setProperty(G_FREQ_CONTROL, 4, P_FREQ_CONTROL_INTE, freqArgs); // set FREQ_CONTROL_INTE and FREQ_CONTROL_FRAC
 
-    // first 7 bits should be 0
+    // set 100kHz channel step size
+    uint8_t stepSizeArgs[2] = {};
+    to_bytes(f.stepSize, 0, 0, stepSizeArgs);
+    this->setProperty(G_FREQ_CONTROL, 2, P_FREQ_CONTROL_CHANNEL_STEP_SIZE2, stepSizeArgs);
+
+    // set data rate
+    uint8_t drArgs[7] = {};
+    to_bytes(dataRate, 0, 1, drArgs);
+    this->setProperty(G_MODEM, 7, P_MODEM_DATA_RATE3, drArgs);
+
+    // set frequency deviation, modulation index = 0.5
     uint8_t fDevArgs[3] = {};
-    // add 0.5 to fDev for quick rounding trick
-    to_bytes((uint32_t)(fDev + 0.5) & 0x0001FFFF, 0, 1, fDevArgs);
+    to_bytes(Si4463FreqPlan::fDev(f.band, dataRate, mod == MOD_4FSK || mod == MOD_4GFSK), 0, 1, fDevArgs);
     this->setProperty(G_MODEM, 3, P_MODEM_FREQ_DEV3, fDevArgs);
 
     // sets AFC to provide feedback to the PLL (does not turn on AFC)
@@ -823,6 +1077,65 @@ void Si4463::setModemConfig(Si4463Mod mod, Si4463DataRate dataRate, uint32_t fre
     this->setProperty(G_FREQ_CONTROL, P_FREQ_CONTROL_VCOCNT_RX_ADJ, 0xFE);
 }
 
+bool Si4463::setChannel(uint8_t channel)
+{
+    // can't change channel while the chip is still transmitting
+    if (this->state == STATE_TX || this->state == STATE_TX_COMPLETE || this->band == -1)
+        return false;
+
+    this->channel = channel;
+    this->freq = Si4463FreqPlan::tunedFreq(this->band, channel);
+
+    // otherwise the new channel is used by the next START_TX/START_RX
+    if (this->state == STATE_RX)
+    {
+        // any partially received packet is lost
+        this->xfrd = 0;
+        this->length = 0;
+        this->availLen = 0;
+        // START_RX retunes immediately, even if already in RX
+        this->startRX();
+    }
+    return true;
+}
+
+bool Si4463::setFrequency(uint32_t freq)
+{
+    Si4463FreqConfig f = Si4463FreqPlan::config(freq);
+    if (f.band == -1)
+        return false;
+
+    // same band, so only the channel needs to change
+    if (f.band == this->band)
+        return this->setChannel(f.channel);
+
+    // different band needs a full modem reconfiguration
+    if (this->state == STATE_TX || this->state == STATE_TX_COMPLETE)
+        return false;
+    this->setModemConfig(this->mod, this->dataRate, freq);
+    if (this->state == STATE_RX)
+        this->startRX();
+    return true;
+}
+
+void Si4463::setCRC(Si4463CRC crc)
+{
+    this->crc = crc;
+    // otherwise it is applied by begin()
+    if (this->began)
+        this->applyCRC();
+}
+
+void Si4463::applyCRC()
+{
+    // seed with all ones so leading zeros are still checked
+    uint8_t crcConfig = this->crc == CRC_NONE ? 0x00 : (0b10000000 | this->crc);
+    this->setProperty(G_PKT, P_PKT_CRC_CONFIG, crcConfig);
+    // the crc covers the length field (start) and the payload, and is sent and checked after the payload
+    this->setProperty(G_PKT, P_PKT_FIELD_1_CRC_CONFIG, this->crc == CRC_NONE ? 0x00 : 0b10000010);
+    this->setProperty(G_PKT, P_PKT_FIELD_2_CRC_CONFIG, this->crc == CRC_NONE ? 0x00 : 0b00101010);
+}
+
 void Si4463::setPower(uint8_t pwr)
 {
     // setProperty(G_PA, P_PA_MODE, 0b000001000); // this is the default
@@ -848,6 +1161,11 @@ void Si4463::setPacketConfig(Si4463Mod mod, uint8_t preambleLength, uint8_t prea
         // set sync to 4-level if needed
         this->setProperty(G_SYNC, P_SYNC_CONFIG, 0x09);
     }
+    else
+    {
+        // 2-level sync (default), set in case the radio was switched from a 4-level profile
+        this->setProperty(G_SYNC, P_SYNC_CONFIG, 0x01);
+    }
     // setup all packet fields
     this->setProperty(G_PKT, P_PKT_CONFIG1, pktConfArgs);
     // turn on data whitening for fields 1 and 2
@@ -857,8 +1175,8 @@ void Si4463::setPacketConfig(Si4463Mod mod, uint8_t preambleLength, uint8_t prea
     // enable variable length packets
     this->setProperty(G_PKT, P_PKT_LEN, 0b00111010);
     this->setProperty(G_PKT, P_PKT_LEN_FIELD_SOURCE, 0x01);
-    // turn off crc
-    this->setProperty(G_PKT, P_PKT_CRC_CONFIG, 0x00);
+    // set up crc (or turn it off)
+    this->applyCRC();
     // set the length of field 1 to be 2 bytes
     uint8_t lengthFieldLen1[2] = {0x00, 0x02};
     this->setProperty(G_PKT, 2, P_PKT_FIELD_1_LENGTH2, lengthFieldLen1);
@@ -912,6 +1230,8 @@ void Si4463::setTXThreshold(uint8_t size)
     // limit size to 64 bytes
     if (size > 64)
         size = 64;
+    // the number of bytes written each time the FIFO runs low
+    this->txThresh = size;
     this->setProperty(G_PKT, P_PKT_TX_THRESHOLD, size);
 }
 
@@ -920,6 +1240,8 @@ void Si4463::setRXThreshold(uint8_t size)
     // limit size to 64 bytes
     if (size > 64)
         size = 64;
+    // the number of bytes read each time the FIFO fills up
+    this->rxThresh = size;
     this->setProperty(G_PKT, P_PKT_RX_THRESHOLD, size);
 }
 
@@ -938,29 +1260,63 @@ void Si4463::setAFC(bool enabled)
     this->setProperty(G_MODEM, 2, P_MODEM_AFC_GAIN2, afcGainArgs);
 }
 
+void Si4463::setIRQMode(bool enabled)
+{
+    this->irqMode = enabled;
+}
+
+void Si4463::setAsyncSPI(bool enabled)
+{
+#if defined(__IMXRT1062__)
+    this->asyncSPI = enabled;
+#else
+    if (enabled)
+        Serial.println("ERROR: async SPI is only supported on the Teensy 4.x");
+#endif
+}
+
 bool Si4463::gpio0()
 {
-    return digitalRead(this->_gp0);
+    return this->gpioPins[0].read();
 }
 
 bool Si4463::gpio1()
 {
-    return digitalRead(this->_gp1);
+    return this->gpioPins[1].read();
 }
 
 bool Si4463::gpio2()
 {
-    return digitalRead(this->_gp2);
+    return this->gpioPins[2].read();
 }
 
 bool Si4463::gpio3()
 {
-    return digitalRead(this->_gp3);
+    return this->gpioPins[3].read();
 }
 
 bool Si4463::irq()
 {
-    return digitalRead(this->_irq);
+    return this->irqPin.read();
+}
+
+void Si4463IOPin::attach(uint8_t pin)
+{
+    this->pin = pin;
+#if defined(__IMXRT1062__) && !defined(SI4463_DIGITAL_PINS)
+    // unconnected pins (ex. gpio2 and 3 on some boards) can be past the end of the pin table, read them as low
+    static volatile uint32_t unconnected = 0;
+    if (pin >= CORE_NUM_DIGITAL)
+    {
+        this->in = this->set = this->clear = &unconnected;
+        this->mask = 0;
+        return;
+    }
+    this->in = portInputRegister(pin);
+    this->set = portSetRegister(pin);
+    this->clear = portClearRegister(pin);
+    this->mask = digitalPinToBitMask(pin);
+#endif
 }
 
 bool Si4463::shutdown(bool shutdown)
@@ -969,6 +1325,8 @@ bool Si4463::shutdown(bool shutdown)
     {
         digitalWrite(this->_sdn, HIGH);
         this->useSPICTS = true;
+        // the radio won't answer any queued commands now
+        this->cancelCommands();
     }
     else
     {
@@ -1010,13 +1368,22 @@ int Si4463::readFRR(int index)
 
 void Si4463::setProperty(Si4463Group group, Si4463Property start, uint8_t data)
 {
+    if (this->batching)
+    {
+        this->stageProperty(group, start, data);
+        return;
+    }
     // three args plus length of the data
     uint8_t cmdArgs[3 + 1] = {group, 1, start, data};
     this->sendCommandC(C_SET_PROPERTY, 3 + 1, cmdArgs);
+    this->shadowProperty(group, start, data);
 }
 
 void Si4463::getProperty(Si4463Group group, Si4463Property start, uint8_t &data)
 {
+    // staged values haven't been sent to the radio yet
+    if (this->batching && this->findStaged(group, start, data))
+        return;
     // three command args, reading 1 byte of data
     uint8_t cmdArgs[3] = {group, 1, start};
     this->sendCommand(C_GET_PROPERTY, 3, cmdArgs, 1, &data);
@@ -1027,6 +1394,12 @@ void Si4463::setProperty(Si4463Group group, const uint8_t num, Si4463Property st
     // make sure we're not exceed the max number of properties the chip can set at a time
     if (num > MAX_NUM_PROPS)
         return;
+    if (this->batching)
+    {
+        for (int i = 0; i < num; i++)
+            this->stageProperty(group, start + i, data[i]);
+        return;
+    }
     // three args plus length of data
     uint8_t cmdArgs[3 + num] = {group, num, start};
     // add data to cmdArgs
@@ -1034,6 +1407,8 @@ void Si4463::setProperty(Si4463Group group, const uint8_t num, Si4463Property st
         cmdArgs[3 + i] = data[i];
 
     this->sendCommandC(C_SET_PROPERTY, 3 + num, cmdArgs);
+    for (int i = 0; i < num; i++)
+        this->shadowProperty(group, start + i, data[i]);
 }
 
 void Si4463::getProperty(Si4463Group group, const uint8_t num, Si4463Property start, uint8_t *data)
@@ -1041,14 +1416,26 @@ void Si4463::getProperty(Si4463Group group, const uint8_t num, Si4463Property st
     // make sure we're not exceeding the max number of properties we can get at a time
     if (num > MAX_NUM_PROPS)
         return;
+
+    // avoid the round trip if every property is already staged
+    bool allStaged = this->batching;
+    for (int i = 0; allStaged && i < num; i++)
+        allStaged = this->findStaged(group, start + i, data[i]);
+    if (allStaged)
+        return;
+
     // three args, reading num bytes of data
     uint8_t cmdArgs[3] = {group, num, start};
     this->sendCommand(C_GET_PROPERTY, 3, cmdArgs, num, data);
+
+    // staged values haven't been sent to the radio yet, so they take priority
+    for (int i = 0; this->batching && i < num; i++)
+        this->findStaged(group, start + i, data[i]);
 }
 
 void Si4463::setProperty(uint8_t *data, uint8_t size)
 {
-    digitalWrite(this->_cs, LOW);
+    this->selectCmd();
 
     for (int i = 0; i < size; i++)
     {
@@ -1060,15 +1447,20 @@ void Si4463::setProperty(uint8_t *data, uint8_t size)
     }
     Serial.println();
 
-    digitalWrite(this->_cs, HIGH);
+    this->deselect();
 
     this->waitCTS();
+
+    // [cmd, group, num, start, data...]
+    if (size >= 4 && data[0] == C_SET_PROPERTY)
+        for (int i = 0; i < data[2] && 4 + i < size; i++)
+            this->shadowProperty(data[1], data[3] + i, data[4 + i]);
 }
 
 void Si4463::readFRRs(uint8_t data[4], uint8_t start)
 {
     // CS needs to stay low throughout reading FRRs
-    digitalWrite(this->_cs, LOW);
+    this->select();
 
     // figure out which FRR to read from first
     uint8_t cmd = C_FRR_A_READ;
@@ -1085,7 +1477,7 @@ void Si4463::readFRRs(uint8_t data[4], uint8_t start)
     for (int i = 0; i < 4; i++)
         data[i] = this->spi->transfer(0x00);
 
-    digitalWrite(this->_cs, HIGH);
+    this->deselect();
 }
 
 void Si4463::powerOn()
@@ -1141,10 +1533,11 @@ void Si4463::waitCTS(uint32_t timeout)
 {
     // blocking while loop (should yield to other functions)
     uint32_t start = millis();
+    uint32_t startUs = micros();
 #if (FORCE_SPI_CTS == 1)
     while (!this->checkCTS() && millis() - start < timeout)
     {
-        delayMicroseconds(10);
+        this->waitIdle(10);
         yield();
     }
 #else
@@ -1152,19 +1545,23 @@ void Si4463::waitCTS(uint32_t timeout)
     if (!useSPICTS)
         while (!this->CTS() && millis() - start < timeout)
         {
+            this->waitIdle(0);
             yield();
         }
     else
         while (!this->checkCTS() && millis() - start < timeout)
         {
-            delayMicroseconds(10);
+            this->waitIdle(10);
             yield();
         }
 #endif
     if (millis() - start >= timeout)
     {
+        this->linkStats.ctsTimeouts++;
         Serial.print("ERROR: CTS timeout");
     }
+    else
+        this->recordCTS(micros() - startUs);
 }
 
 bool Si4463::checkCTS()
@@ -1173,13 +1570,13 @@ bool Si4463::checkCTS()
     // CS low through entire SPI command
 
     // SPI version
-    digitalWrite(this->_cs, LOW);
+    this->select();
 
     // send the command
     this->spi->transfer(C_READ_CMD_BUFF);
     uint8_t cts = this->spi->transfer(0x00);
 
-    digitalWrite(this->_cs, HIGH);
+    this->deselect();
     return cts == 0xff;
 }
 
@@ -1188,6 +1585,8 @@ bool Si4463::CTS()
     // GPIO version
     if (this->_cts != -1)
     {
+        if (this->_cts == this->_irq)
+            return this->irq();
         return digitalRead(this->_cts);
     }
     Serial.print("ERROR: CTS pin not configured: ");
@@ -1197,6 +1596,8 @@ bool Si4463::CTS()
 
 void Si4463::sendCommand(Si4463Cmd cmd, uint8_t argcCmd, uint8_t *argvCmd, uint8_t argcRes, uint8_t *argvRes)
 {
+    // the interrupt can't send anything until the response is read
+    this->cmdOpen = true;
     // send the cmd with its args
     this->spi_write(cmd, argcCmd, argvCmd);
     // read command response
@@ -1205,6 +1606,8 @@ void Si4463::sendCommand(Si4463Cmd cmd, uint8_t argcCmd, uint8_t *argvCmd, uint8
 
 void Si4463::sendCommandR(Si4463Cmd cmd, uint8_t argcRes, uint8_t *argvRes)
 {
+    // the interrupt can't send anything until the response is read
+    this->cmdOpen = true;
     // send the cmd with no args
     this->spi_write(cmd, 0, {});
     // read command response
@@ -1222,157 +1625,884 @@ void Si4463::sendCommandC(Si4463Cmd cmd, uint8_t argcCmd, uint8_t *argvCmd)
 void Si4463::setRadioConfig(const uint8_t *config, uint32_t length)
 {
     // copy config into internal array
+    if (this->WDS_CONFIG != nullptr)
+        delete[] this->WDS_CONFIG;
     this->WDS_CONFIG = new uint8_t[length];
     memcpy(this->WDS_CONFIG, config, length);
     this->configLen = length;
 }
 
 // private methods
-void Si4463::spi_write(uint8_t cmd, uint8_t argc, uint8_t *argv)
+void Si4463::startRX(bool queued)
 {
-    // CS low through entire SPI command
-    digitalWrite(this->_cs, LOW);
-
-    // send the command
-    this->spi->transfer(cmd);
-    // send the args
-    for (int i = 0; i < argc; i++)
+    // with a queue, go straight back to RX after a valid packet instead of waiting for it to be read
+    uint8_t rxValidState = this->rxQueueSlots > 0 ? 0x08 : 0x03;
+    uint8_t rxArgs[7] = {this->channel, 0, 0, 0, 0x08, rxValidState, 0x08};
+    if (queued && this->startRXCmd.status != CMD_QUEUED && this->startRXCmd.status != CMD_SENT)
     {
-        this->spi->transfer(argv[i]);
+        memcpy(this->startRXCmd.args, rxArgs, sizeof(rxArgs));
+        this->queueInternal(this->startRXCmd);
     }
-
-    digitalWrite(this->_cs, HIGH);
+    else
+        this->spi_write(C_START_RX, sizeof(rxArgs), rxArgs);
 }
 
-void Si4463::spi_read(uint8_t argc, uint8_t *argv)
+bool Si4463::queueCommand(Si4463Command &cmd)
 {
-    // CS low through entire SPI command
-    uint8_t pos = 0;
+    // the radio can't take commands before begin(), and a command can only be in the queue once
+    if (!this->began || cmd.status == CMD_QUEUED || cmd.status == CMD_SENT)
+        return false;
+    if (cmd.argc > Si4463Command::MAX_ARGS || cmd.resLen > Si4463Command::MAX_RES)
+        return false;
 
-    uint8_t cts = 0x00;
-    uint32_t start = millis();
-    while (cts != 0xFF)
-    {
-        digitalWrite(this->_cs, LOW);
-        this->spi->transfer(C_READ_CMD_BUFF);
-        cts = this->spi->transfer(0x00);
-        if (cts != 0xFF)
-        {
-            digitalWrite(this->_cs, HIGH);
-            delayMicroseconds(1);
-        }
-        if (millis() - start > CTS_TIMEOUT)
-        {
-            Serial.println("ERROR: spi_read(), CTS took too long");
-            return;
-        }
-    }
+    uint8_t next = (this->cmdHead + 1) % (Si4463::CMD_QUEUE_LEN + 1);
+    if (next == this->cmdTail)
+        return false; // queue is full
 
-    // read in the args (CTS must already have been received)
-    while (pos < argc)
-    {
-        argv[pos++] = this->spi->transfer(0x00);
-    }
+    cmd.status = CMD_QUEUED;
+    this->cmdQueue[this->cmdHead] = &cmd;
+    this->cmdHead = next;
 
-    digitalWrite(this->_cs, HIGH);
+    // send it straight away if nothing is ahead of it
+    this->pollCommands();
+    return true;
 }
 
-void Si4463::from_bytes(uint16_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+uint8_t Si4463::commandsQueued()
 {
-    int iterNum = 2 - bytePos;
-    if (MSB)
-    {
-        for (int i = iterNum - 1; i >= 0; i--)
-        {
-            val += arr[pos++] << (i * 8); // starts shifted all the way left, then moves right
-        }
-    }
-    else
-    {
-        for (int i = 0; i < iterNum; i++)
-        {
-            val += arr[pos++] << (i * 8); // starts shifted all the way right, then moves left
-        }
-    }
+    return (this->cmdHead + Si4463::CMD_QUEUE_LEN + 1 - this->cmdTail) % (Si4463::CMD_QUEUE_LEN + 1);
 }
 
-void Si4463::from_bytes(uint32_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+void Si4463::flushCommands()
 {
-    int iterNum = 4 - bytePos;
-    if (MSB)
+    // every command either completes or times out, so this always ends
+    while (this->cmdHead != this->cmdTail)
     {
-        for (int i = iterNum - 1; i >= 0; i--)
+        this->pollCommands();
+        if (this->cmdHead != this->cmdTail)
         {
-            val += arr[pos++] << (i * 8);
+            this->waitIdle(this->useSPICTS ? 10 : 0);
+            yield();
         }
     }
-    else
+}
+
+void Si4463::pollCommands()
+{
+    while (this->cmdHead != this->cmdTail)
     {
-        for (int i = 0; i < iterNum; i++)
+        Si4463Command *cmd = this->cmdQueue[this->cmdTail];
+        if (cmd->status == CMD_QUEUED)
         {
-            val += arr[pos++] << (i * 8);
+            // CTS won't be back until the next call at the earliest
+            this->sendQueued(cmd);
+            return;
         }
+        if (!this->finishQueued(cmd))
+            return; // still busy
     }
 }
 
-void Si4463::from_bytes(uint64_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+void Si4463::sendQueued(Si4463Command *cmd)
 {
-    int iterNum = 8 - bytePos;
-    if (MSB)
+    this->selectCmd();
+    this->spi->transfer(cmd->cmd);
+    for (int i = 0; i < cmd->argc; i++)
+        this->spi->transfer(cmd->args[i]);
+    // updated before the transaction ends so the interrupt never sees a half sent command
+    cmd->sentAt = micros();
+    cmd->status = CMD_SENT;
+    this->deselect();
+}
+
+bool Si4463::finishQueued(Si4463Command *cmd)
+{
+    uint32_t waited = micros() - cmd->sentAt;
+    bool timedOut = waited > Si4463::CTS_TIMEOUT * 1000;
+
+    // the CTS pin is cheaper to check than the command buffer
+    if (!this->useSPICTS && !timedOut && !this->CTS())
+        return false;
+
+    this->select();
+    // the interrupt may have finished it already (it can't run during the transaction)
+    if (this->cmdHead == this->cmdTail || this->cmdQueue[this->cmdTail] != cmd || cmd->status != CMD_SENT)
     {
-        for (int i = iterNum - 1; i >= 0; i--)
-        {
-            val += arr[pos++] << (i * 8);
-        }
+        this->deselect();
+        return cmd->done();
     }
-    else
+
+    this->spi->transfer(C_READ_CMD_BUFF);
+    bool ready = this->spi->transfer(0x00) == 0xFF;
+    if (ready)
     {
-        for (int i = 0; i < iterNum; i++)
-        {
-            val += arr[pos++] << (i * 8);
-        }
+        for (int i = 0; i < cmd->resLen; i++)
+            cmd->res[i] = this->spi->transfer(0x00);
+        cmd->status = CMD_DONE;
     }
-}
-
-void Si4463::to_bytes(uint16_t val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
-{
-    int iterNum = 2 - bytePos;
-    if (MSB)
+    else if (timedOut)
     {
-        for (int i = iterNum - 1; i >= 0; i--)
-        {
-            // isolate the leftmost byte, moving one step right each iteration
-            // then shift the current byte all the way to the right so it fits in a uint8_t
-            arr[pos++] = (val & ((uint16_t)0x00ff << (i * 8))) >> (i * 8);
-        }
+        cmd->status = CMD_FAILED;
     }
+    // removed before the transaction ends, same as sendQueued()
+    if (ready || timedOut)
+        this->cmdTail = (this->cmdTail + 1) % (Si4463::CMD_QUEUE_LEN + 1);
+    this->deselect();
+
+    if (!ready && !timedOut)
+        return false;
+    if (ready)
+        this->recordCTS(waited);
     else
     {
-        for (int i = 0; i < iterNum; i++)
-        {
-            // isolate the rightmost byte, moving one step left each iteration
-            // then shift the current byte all the way to the right so it fits in a uint8_t
-            arr[pos++] = (val & ((uint16_t)0x00ff << (i * 8))) >> (i * 8);
-        }
+        this->linkStats.ctsTimeouts++;
+        Serial.println("ERROR: queued command, CTS took too long");
     }
+    if (cmd->onComplete != nullptr)
+        cmd->onComplete(cmd, cmd->ctx);
+    // the interrupt may have been waiting on this response to clear its interrupts
+    if (this->irqPending && !this->irqHeld)
+        this->retryIRQ();
+    return true;
 }
 
-void Si4463::to_bytes(uint32_t val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+void Si4463::cancelCommands()
 {
-    int iterNum = 4 - bytePos;
-    if (MSB)
+    while (this->cmdHead != this->cmdTail)
     {
-        for (int i = iterNum - 1; i >= 0; i--)
-        {
-            arr[pos++] = (val & ((uint32_t)0x000000ff << (i * 8))) >> (i * 8);
-        }
+        Si4463Command *cmd = this->cmdQueue[this->cmdTail];
+        this->cmdTail = (this->cmdTail + 1) % (Si4463::CMD_QUEUE_LEN + 1);
+        cmd->status = CMD_FAILED;
+        if (cmd->onComplete != nullptr)
+            cmd->onComplete(cmd, cmd->ctx);
     }
-    else
+}
+
+void Si4463::queueInternal(Si4463Command &cmd)
+{
+    if (cmd.status == CMD_QUEUED || cmd.status == CMD_SENT)
+        return;
+    // only happens if user commands fill the queue
+    if (!this->queueCommand(cmd))
     {
-        for (int i = 0; i < iterNum; i++)
-        {
-            arr[pos++] = (val & ((uint32_t)0x000000ff << (i * 8))) >> (i * 8);
-        }
+        this->flushCommands();
+        this->queueCommand(cmd);
+    }
+}
+
+bool Si4463::pollInternal(Si4463Command &cmd)
+{
+    if (cmd.status == CMD_DONE)
+    {
+        // the response stays in cmd.res for the caller
+        cmd.status = CMD_IDLE;
+        return true;
+    }
+    // failed commands are just sent again
+    this->queueInternal(cmd);
+    return false;
+}
+
+void Si4463::resetRXCommands()
+{
+    if (this->phStatusCmd.done())
+        this->phStatusCmd.status = CMD_IDLE;
+    if (this->fifoInfoCmd.done())
+        this->fifoInfoCmd.status = CMD_IDLE;
+}
+
+void Si4463::waitIdle(uint32_t us)
+{
+    // let the other radios on the bus use it while we wait, it is free since CS is high
+    if (this->bus != nullptr && this->bus->idle(this))
+        return;
+    if (us > 0)
+        delayMicroseconds(us);
+}
+
+void Si4463::select()
+{
+    // wait for any DMA transfer to finish, yield() runs asyncComplete()
+    while (Si4463::spiBusy)
+        yield();
+    this->spi->beginTransaction(this->spiSettings);
+    this->csPin.write(LOW);
+    this->selectTime = micros();
+}
+
+void Si4463::deselect()
+{
+    this->csPin.write(HIGH);
+    this->spi->endTransaction();
+    this->linkStats.spiTime += micros() - this->selectTime;
+}
+
+void Si4463::selectCmd()
+{
+    this->select();
+    // CTS is only known to be back after the main loop's own commands, the interrupt doesn't wait for its clears
+    while (this->irqCmd)
+    {
+        this->deselect();
+        this->irqCmd = false;
+        this->waitCTS();
+        this->select();
+    }
+}
+
+void Si4463::writeTXFIFO(uint8_t count, bool sendLength)
+{
+    this->select();
+
+    // write to the TX FIFO, sending the length along with the command if needed
+    uint8_t header[3] = {C_WRITE_TX_FIFO, 0, 0};
+    uint8_t headerLen = 1;
+    if (sendLength)
+    {
+        to_bytes(this->length, 1, 0, header);
+        headerLen = 3;
+    }
+#if defined(TEENSYDUINO)
+    this->spi->transfer(header, nullptr, headerLen);
+#else
+    for (int i = 0; i < headerLen; i++)
+        this->spi->transfer(header[i]);
+#endif
+
+    // number of message bytes we can send this time
+    uint16_t n = this->availLen - this->xfrd;
+    if (n > count)
+        n = count;
+
+    // send one contiguous piece at a time (there is only one unless sending segments)
+    while (n > 0)
+    {
+        uint16_t piece = n;
+        const uint8_t *src = this->txSource(piece);
+        if (piece == 0)
+            break;
+#if defined(__IMXRT1062__)
+        // hand the message bytes to DMA if they are contiguous, CS is released in asyncComplete()
+        if (this->asyncSPI && !this->irqMode && piece == n)
+        {
+            this->startAsync(src, nullptr, piece, false);
+            return;
+        }
+#endif
+#if defined(TEENSYDUINO)
+        this->spi->transfer(src, nullptr, piece);
+#else
+        for (int i = 0; i < piece; i++)
+            this->spi->transfer(src[i]);
+#endif
+        this->advanceTX(piece);
+        n -= piece;
+    }
+
+    this->deselect();
+}
+
+const uint8_t *Si4463::txSource(uint16_t &n)
+{
+    if (this->streamRing != nullptr)
+    {
+        // the length field and stream header, then the payload straight from the ring
+        if (this->xfrd < sizeof(this->streamHeader))
+        {
+            if (n > sizeof(this->streamHeader) - this->xfrd)
+                n = sizeof(this->streamHeader) - this->xfrd;
+            return this->streamHeader + this->xfrd;
+        }
+        // limit to the end of the ring
+        if (n > this->streamSize - this->streamTail)
+            n = this->streamSize - this->streamTail;
+        return this->streamRing + this->streamTail;
+    }
+
+    if (this->txSegs == nullptr)
+        return this->buf + this->xfrd;
+
+    // skip to the segment with the next byte to send
+    while (this->txSegIdx < this->txSegCount && this->txSegOff >= this->txSegs[this->txSegIdx].len)
+    {
+        this->txSegIdx++;
+        this->txSegOff = 0;
+    }
+    if (this->txSegIdx >= this->txSegCount)
+    {
+        n = 0;
+        return nullptr;
+    }
+
+    // limit to the rest of this segment
+    uint16_t left = this->txSegs[this->txSegIdx].len - this->txSegOff;
+    if (n > left)
+        n = left;
+    return this->txSegs[this->txSegIdx].data + this->txSegOff;
+}
+
+void Si4463::advanceTX(uint16_t n)
+{
+    // pieces never mix header and payload bytes, see txSource()
+    if (this->streamRing != nullptr && this->xfrd >= sizeof(this->streamHeader))
+    {
+        this->streamTail = (this->streamTail + n) % this->streamSize;
+        this->streamOut += n;
+    }
+    this->xfrd += n;
+    if (this->txSegs != nullptr)
+        this->txSegOff += n;
+}
+
+bool Si4463::beginTX()
+{
+    //  enter idle state
+    // uint8_t cIdleArgs[1] = {0b00000011};
+    // this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
+
+    // clear fifo
+    uint8_t cClearFIFO[1] = {0b00000011};
+    this->sendCommandC(C_FIFO_INFO, 1, cClearFIFO);
+
+    // write the length and as much of the message as fits
+    this->writeTXFIFO(FIFO_LENGTH - 2, true);
+
+    // set packet length for variable length packets
+    // this->setProperty(G_PKT, 2, P_PKT_FIELD_2_LENGTH2, mLen);
+
+    // update state before starting tx so the interrupt sees it
+    this->txStarved = false;
+    this->state = STATE_TX;
+
+    // start tx
+    // enter rx state after tx
+    uint8_t txArgs[6] = {this->channel, 0b00110000, 0, 0, 0, 0};
+    this->spi_write(C_START_TX, sizeof(txArgs), txArgs);
+
+    return true;
+}
+
+void Si4463::completeTX()
+{
+    // automatically placed into an idle state
+    this->state = STATE_TX_COMPLETE;
+    this->linkStats.txPackets++;
+    this->linkStats.txBytes += this->length;
+    if (!this->irqMode)
+        this->checkFIFOError(this->readFRR(2));
+    // clear internal variables
+    if (this->txSegs == nullptr && this->buf != nullptr)
+        memset(this->buf, 0, this->length);
+    this->txSegs = nullptr;
+    this->length = 0;
+    this->availLen = 0;
+    this->xfrd = 0;
+
+    // every byte is in the FIFO now, so the caller can reuse its memory
+    if (this->txCallback != nullptr)
+    {
+        void (*callback)(void *) = this->txCallback;
+        this->txCallback = nullptr;
+        callback(this->txCallbackCtx);
+    }
+}
+
+bool Si4463::serviceStream(bool room, bool sent)
+{
+    if (sent && this->streamOnAir)
+    {
+        this->streamOnAir = false;
+        this->linkStats.txPackets++;
+        this->linkStats.txBytes += this->streamAirLen;
+    }
+
+    // a frame is done with once it is all in the FIFO and started, then the next one can be written behind it
+    if (this->streamLoading && this->streamStarted && this->xfrd == this->length)
+        this->streamLoading = false;
+    if (!this->streamLoading)
+        this->openFrame();
+
+    if (this->streamLoading && !this->streamStarted && !this->streamOnAir)
+    {
+        this->startFrame();
+        return true;
+    }
+    if (!this->streamLoading && !this->streamOnAir && this->streamEndOpened)
+    {
+        this->finishStream();
+        return false;
+    }
+
+    // keep writing the frame being sent, or the next one behind it
+    if (room && this->streamLoading && this->xfrd < this->length)
+    {
+        this->writeTXFIFO(this->txThresh);
+        return true;
+    }
+    return false;
+}
+
+uint16_t Si4463::streamBuffered()
+{
+    return (this->streamHead + this->streamSize - this->streamTail) % this->streamSize;
+}
+
+bool Si4463::openFrame()
+{
+    uint16_t buffered = this->streamBuffered();
+    // nothing to send, unless the stream is ending and still needs a STREAM_END frame
+    if (this->streamEndOpened || (buffered == 0 && !this->streamEnding))
+        return false;
+
+    uint16_t payload = this->streamFrameLen - Si4463::STREAM_HEADER_LEN;
+    if (payload > buffered)
+        payload = buffered;
+    uint8_t flags = this->streamOut == 0 ? STREAM_START : 0;
+    if (this->streamEnding && payload == buffered)
+    {
+        flags |= STREAM_END;
+        this->streamEndOpened = true;
+    }
+
+    // length field first, the packet handler reads it from the FIFO
+    to_bytes((uint16_t)(Si4463::STREAM_HEADER_LEN + payload), 0, 0, this->streamHeader);
+    this->streamHeader[2] = flags;
+    to_bytes(this->streamOut, 3, 0, this->streamHeader);
+
+    // every payload byte is already in the ring, so the whole frame is available
+    this->length = sizeof(this->streamHeader) + payload;
+    this->availLen = this->length;
+    this->xfrd = 0;
+    this->streamStarted = false;
+    this->streamLoading = true;
+    return true;
+}
+
+void Si4463::startFrame()
+{
+    // xfrd is only up to date once any DMA transfer has finished
+    while (Si4463::spiBusy)
+        yield();
+    // the last frame is gone, so the FIFO only holds what has been written of this one
+    if (this->xfrd < this->length && this->xfrd < FIFO_LENGTH)
+        this->writeTXFIFO(FIFO_LENGTH - this->xfrd);
+
+    this->streamStarted = true;
+    this->streamOnAir = true;
+    this->streamAirLen = this->length - 2;
+
+    // back to TX_TUNE afterwards so the next frame starts without retuning
+    uint8_t txArgs[6] = {this->channel, 0b01010000, 0, 0, 0, 0};
+    memcpy(this->startTXCmd.args, txArgs, sizeof(txArgs));
+    this->queueInternal(this->startTXCmd);
+}
+
+void Si4463::finishStream()
+{
+    this->streamRing = nullptr;
+    this->length = 0;
+    this->availLen = 0;
+    this->xfrd = 0;
+    // leave TX_TUNE
+    this->queueInternal(this->readyCmd);
+    this->state = STATE_IDLE;
+}
+
+bool Si4463::readRXFIFO(uint8_t count)
+{
+    this->select();
+
+    // read from RX FIFO
+    this->spi->transfer(C_READ_RX_FIFO);
+
+    // if the internal length and xfrd variables are 0, then this is the first part of the message
+    if (this->xfrd == 0)
+    {
+        // so we need to read length
+        uint8_t mLen[2] = {0x00, 0x00};
+        mLen[0] = this->spi->transfer(0x00);
+        mLen[1] = this->spi->transfer(0x00);
+        // convert individual bytes to uint16_t
+        from_bytes(this->length, 0, 0, mLen);
+        // Serial.print("len ");
+        // Serial.println(this->length);
+        count = count > 2 ? count - 2 : 0;
+        // make sure the message is not too long (could be erroneous transmission)
+        if (this->length > Si4463::MAX_LEN || this->length == 0)
+        {
+            this->linkStats.lengthErrors++;
+            this->length = 0;
+            this->deselect();
+            return false; // error, message too long or too short
+        }
+    }
+
+    // number of message bytes left to read this time
+    uint16_t n = this->length - this->xfrd;
+    if (n > count)
+        n = count;
+    // read straight into the RX queue if there is one, the bytes are still read out of the FIFO if the packet is dropped
+    uint8_t *dest = this->rxDest();
+    if (dest != nullptr)
+        dest += this->xfrd;
+
+#if defined(TEENSYDUINO)
+#if defined(__IMXRT1062__)
+    // hand the message bytes to DMA, CS is released in asyncComplete()
+    if (this->asyncSPI && !this->irqMode && n > 0)
+    {
+        this->startAsync(nullptr, dest, n, true);
+        return true;
+    }
+#endif
+    this->spi->transfer(nullptr, dest, n);
+    this->xfrd += n;
+#else
+    for (int i = 0; i < n; i++)
+    {
+        uint8_t b = this->spi->transfer(0x00);
+        if (dest != nullptr)
+            dest[i] = b;
+    }
+    this->xfrd += n;
+#endif
+    this->deselect();
+
+    this->completeRX();
+    return true;
+}
+
+void Si4463::completeRX()
+{
+    // if we've transferred length bytes, we've received the whole message
+    if (this->xfrd == this->length && this->length > 0)
+    {
+        this->resetRXCommands();
+        this->linkStats.rxPackets++;
+        this->linkStats.rxBytes += this->length;
+        this->linkStats.rssi = this->RSSI();
+        if (!this->irqMode)
+            this->checkFIFOError(this->readFRR(2));
+        if (this->rxQueueSlots > 0)
+        {
+            this->queuePacket();
+            return;
+        }
+        // Serial.println("Complete");
+        // automatically placed into an idle state
+        this->state = STATE_RX_COMPLETE;
+        this->available = true;
+        // only reset xfrd
+        // length, availLen, and buf need to stay so they can be read
+        this->xfrd = 0;
+    }
+}
+
+bool Si4463::setBuffer(uint8_t *buffer)
+{
+    // buf may be holding a message being sent or received
+    if (buffer == nullptr || this->state == STATE_TX || this->state == STATE_RX || this->state == STATE_RX_COMPLETE)
+        return false;
+    if (this->ownBuf)
+        delete[] this->buf;
+    this->buf = buffer;
+    this->ownBuf = false;
+    return true;
+}
+
+bool Si4463::allocBuf()
+{
+    if (this->buf == nullptr)
+    {
+        this->buf = new uint8_t[Si4463::MAX_LEN];
+        this->ownBuf = true;
+    }
+    return this->buf != nullptr;
+}
+
+uint8_t *Si4463::rxDest()
+{
+    if (this->rxQueueSlots == 0)
+        return this->buf;
+    // the slot at the head is always free, it is one more than the queue depth
+    if (this->length > this->rxQueueSlotLen)
+        return nullptr;
+    return this->rxQueue + this->rxHead * this->rxQueueSlotLen;
+}
+
+void Si4463::queuePacket()
+{
+    uint8_t next = (this->rxHead + 1) % this->rxQueueSlots;
+    // drop the packet if the queue is full or it doesn't fit in a slot
+    if (next == this->rxTail || this->length > this->rxQueueSlotLen)
+    {
+        this->linkStats.rxDropped++;
+    }
+    else
+    {
+        // the packet was read straight into the slot, see rxDest()
+        uint8_t slot = this->rxHead;
+        this->rxQueueInfo[slot] = {this->length, this->RSSI(), this->linkStats.afc, micros()};
+        this->rxHead = next;
+    }
+
+    // the radio goes straight back to RX, so get ready for the next packet
+    this->xfrd = 0;
+    this->length = 0;
+    this->availLen = 0;
+    this->state = STATE_RX;
+}
+
+#if defined(__IMXRT1062__)
+void Si4463::startAsync(const uint8_t *txBuf, uint8_t *rxBuf, uint16_t n, bool rx)
+{
+    // xfrd is only advanced once the bytes have actually moved
+    Si4463::spiBusy = true;
+    this->asyncLen = n;
+    this->asyncRX = rx;
+    this->spi->transfer(txBuf, rxBuf, n, this->spiEvent);
+}
+
+void Si4463::asyncComplete(EventResponderRef event)
+{
+    Si4463 *radio = (Si4463 *)event.getContext();
+    radio->deselect();
+    uint16_t n = radio->asyncLen;
+    radio->asyncLen = 0;
+    Si4463::spiBusy = false;
+    if (radio->asyncRX)
+    {
+        radio->xfrd += n;
+        radio->completeRX();
+    }
+    else
+    {
+        radio->advanceTX(n);
+    }
+}
+#endif
+
+bool Si4463::attachIRQ()
+{
+    // find a free slot for this radio
+    if (this->irqSlot == -1)
+    {
+        for (int i = 0; i < Si4463::MAX_IRQ_RADIOS; i++)
+        {
+            if (irqRadios[i] == nullptr)
+            {
+                this->irqSlot = i;
+                break;
+            }
+        }
+    }
+    if (this->irqSlot == -1)
+    {
+        Serial.println("ERROR: no free IRQ slots, too many radios in IRQ mode");
+        return false;
+    }
+    irqRadios[this->irqSlot] = this;
+
+    // enable the packet handler interrupts we need to service the FIFOs
+    this->setProperty(G_INT_CTL, P_INT_CTL_PH_ENABLE, Si4463::IRQ_PH_ENABLE);
+    this->setProperty(G_INT_CTL, P_INT_CTL_ENABLE, INT_PH);
+    // PH_PEND in place of the latched RSSI, so serviceIRQ() gets everything it needs from FRRs B to D in one read
+    this->setFRRs(FRR_NO_CHANGE, FRR_INT_PH_PEND);
+    // the interrupt uses the bus, so it has to wait for transactions in the main loop to finish
+    this->spi->usingInterrupt(digitalPinToInterrupt(this->_irq));
+
+    // clear anything already pending so nIRQ starts high
+    uint8_t cIntArgs[3] = {0, 0, 0};
+    uint8_t rIntArgs[8] = {};
+    this->sendCommand(C_GET_INT_STATUS, sizeof(cIntArgs), cIntArgs, sizeof(rIntArgs), rIntArgs);
+
+    void (*isrs[Si4463::MAX_IRQ_RADIOS])() = {isr0, isr1, isr2, isr3};
+    attachInterrupt(digitalPinToInterrupt(this->_irq), isrs[this->irqSlot], FALLING);
+    return true;
+}
+
+void Si4463::isr0()
+{
+    if (irqRadios[0] != nullptr)
+        irqRadios[0]->handleIRQ();
+}
+
+void Si4463::isr1()
+{
+    if (irqRadios[1] != nullptr)
+        irqRadios[1]->handleIRQ();
+}
+
+void Si4463::isr2()
+{
+    if (irqRadios[2] != nullptr)
+        irqRadios[2]->handleIRQ();
+}
+
+void Si4463::isr3()
+{
+    if (irqRadios[3] != nullptr)
+        irqRadios[3]->handleIRQ();
+}
+
+void Si4463::spi_write(uint8_t cmd, uint8_t argc, uint8_t *argv)
+{
+    // queued commands go first so commands reach the radio in order
+    if (this->cmdHead != this->cmdTail)
+        this->flushCommands();
+
+    // CS low through entire SPI command
+    this->selectCmd();
+
+    // send the command
+    this->spi->transfer(cmd);
+    // send the args
+    for (int i = 0; i < argc; i++)
+    {
+        this->spi->transfer(argv[i]);
+    }
+
+    this->deselect();
+}
+
+void Si4463::spi_read(uint8_t argc, uint8_t *argv)
+{
+    // CS low through entire SPI command
+    uint8_t pos = 0;
+
+    uint8_t cts = 0x00;
+    uint32_t start = millis();
+    uint32_t startUs = micros();
+    while (cts != 0xFF)
+    {
+        this->select();
+        this->spi->transfer(C_READ_CMD_BUFF);
+        cts = this->spi->transfer(0x00);
+        if (cts != 0xFF)
+        {
+            this->deselect();
+            if (millis() - start > CTS_TIMEOUT)
+            {
+                this->linkStats.ctsTimeouts++;
+                Serial.println("ERROR: spi_read(), CTS took too long");
+                this->cmdOpen = false;
+                return;
+            }
+            this->waitIdle(1);
+        }
+    }
+
+    this->recordCTS(micros() - startUs);
+
+    // read in the args (CTS must already have been received)
+    while (pos < argc)
+    {
+        argv[pos++] = this->spi->transfer(0x00);
+    }
+
+    this->deselect();
+    this->cmdOpen = false;
+    // the interrupt may have been waiting on this response to clear its interrupts
+    if (this->irqPending && !this->irqHeld)
+        this->retryIRQ();
+}
+
+void Si4463::from_bytes(uint16_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+{
+    int iterNum = 2 - bytePos;
+    if (MSB)
+    {
+        for (int i = iterNum - 1; i >= 0; i--)
+        {
+            val += arr[pos++] << (i * 8); // starts shifted all the way left, then moves right
+        }
+    }
+    else
+    {
+        for (int i = 0; i < iterNum; i++)
+        {
+            val += arr[pos++] << (i * 8); // starts shifted all the way right, then moves left
+        }
+    }
+}
+
+void Si4463::from_bytes(uint32_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+{
+    int iterNum = 4 - bytePos;
+    if (MSB)
+    {
+        for (int i = iterNum - 1; i >= 0; i--)
+        {
+            val += arr[pos++] << (i * 8);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < iterNum; i++)
+        {
+            val += arr[pos++] << (i * 8);
+        }
+    }
+}
+
+void Si4463::from_bytes(uint64_t &val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+{
+    int iterNum = 8 - bytePos;
+    if (MSB)
+    {
+        for (int i = iterNum - 1; i >= 0; i--)
+        {
+            val += arr[pos++] << (i * 8);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < iterNum; i++)
+        {
+            val += arr[pos++] << (i * 8);
+        }
+    }
+}
+
+void Si4463::to_bytes(uint16_t val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+{
+    int iterNum = 2 - bytePos;
+    if (MSB)
+    {
+        for (int i = iterNum - 1; i >= 0; i--)
+        {
+            // isolate the leftmost byte, moving one step right each iteration
+            // then shift the current byte all the way to the right so it fits in a uint8_t
+            arr[pos++] = (val & ((uint16_t)0x00ff << (i * 8))) >> (i * 8);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < iterNum; i++)
+        {
+            // isolate the rightmost byte, moving one step left each iteration
+            // then shift the current byte all the way to the right so it fits in a uint8_t
+            arr[pos++] = (val & ((uint16_t)0x00ff << (i * 8))) >> (i * 8);
+        }
+    }
+}
+
+void Si4463::to_bytes(uint32_t val, uint8_t pos, uint8_t bytePos, uint8_t *arr, bool MSB)
+{
+    int iterNum = 4 - bytePos;
+    if (MSB)
+    {
+        for (int i = iterNum - 1; i >= 0; i--)
+        {
+            arr[pos++] = (val & ((uint32_t)0x000000ff << (i * 8))) >> (i * 8);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < iterNum; i++)
+        {
+            arr[pos++] = (val & ((uint32_t)0x000000ff << (i * 8))) >> (i * 8);
+        }
     }
 }
 
@@ -1417,46 +2547,382 @@ void Si4463::applyRadioConfig()
 void Si4463::applyWDSConfig(bool applyDefault)
 {
     if (applyDefault)
+        this->applyConfigArray(DEFAULT_CONFIG_ARR, sizeof(DEFAULT_CONFIG_ARR));
+    else
+        this->applyConfigArray(this->WDS_CONFIG, this->configLen);
+}
+
+void Si4463::applyConfigArray(const uint8_t *config, uint32_t length)
+{
+    // read one byte (length byte), then read that many bytes, then repeat
+    for (uint32_t i = 0; i < length; i++)
     {
-        // read one byte (length byte), then read that many bytes, then repeat
-        for (unsigned int i = 0; i < sizeof(DEFAULT_CONFIG_ARR); i++)
+        uint8_t cmdLen = config[i];
+        // SET_PROPERTY is [cmd, group, num, start, data...], stage it instead of sending if batching
+        if (this->batching && cmdLen >= 4 && config[i + 1] == C_SET_PROPERTY)
+        {
+            for (int j = 0; j < config[i + 3]; j++)
+                this->stageProperty(config[i + 2], config[i + 4] + j, config[i + 5 + j]);
+        }
+        // a profile only holds properties, anything else would be sent to the radio right away
+        else if (!this->buildingProfile)
         {
             // CS low through entire SPI command
-            digitalWrite(this->_cs, LOW);
+            this->selectCmd();
 
-            for (int j = 0; j < DEFAULT_CONFIG_ARR[i]; j++)
+            for (int j = 0; j < cmdLen; j++)
             {
                 // char str[5] = {};
-                // snprintf(str, 5, "%#02x", DEFAULT_CONFIG_ARR[i + j + 1]);
+                // snprintf(str, 5, "%#02x", config[i + j + 1]);
                 // Serial.print(str);
                 // Serial.print(" ");
-                this->spi->transfer(DEFAULT_CONFIG_ARR[i + j + 1]);
+                this->spi->transfer(config[i + j + 1]);
             }
             // Serial.println();
-            digitalWrite(this->_cs, HIGH);
-            i += DEFAULT_CONFIG_ARR[i];
+            this->deselect();
 
             this->waitCTS();
+
+            if (cmdLen >= 4 && config[i + 1] == C_SET_PROPERTY)
+                for (int j = 0; j < config[i + 3]; j++)
+                    this->shadowProperty(config[i + 2], config[i + 4] + j, config[i + 5 + j]);
+        }
+        i += cmdLen;
+    }
+}
+
+void Si4463::beginBatch()
+{
+    this->batchLen = 0;
+    this->batching = true;
+}
+
+void Si4463::commitBatch()
+{
+    // stop staging so setProperty() sends directly
+    this->batching = false;
+
+    int i = 0;
+    while (i < this->batchLen)
+    {
+        // find the run of contiguous properties starting here
+        uint8_t group = this->batch[i].group;
+        uint8_t start = this->batch[i].prop;
+        uint8_t data[MAX_NUM_PROPS] = {};
+        uint8_t num = 0;
+        while (i < this->batchLen && num < MAX_NUM_PROPS && this->batch[i].group == group && this->batch[i].prop == start + num)
+            data[num++] = this->batch[i++].value;
+
+        this->setProperty((Si4463Group)group, num, (Si4463Property)start, data);
+    }
+}
+
+void Si4463::setBatchConfig(bool enabled)
+{
+    this->batchConfig = enabled;
+}
+
+uint32_t Si4463::exportConfig(uint8_t *out, uint32_t maxLen)
+{
+    uint32_t pos = 0;
+    int i = 0;
+    while (i < this->batchLen)
+    {
+        // same run splitting as commitBatch()
+        uint8_t group = this->batch[i].group;
+        uint8_t start = this->batch[i].prop;
+        uint8_t num = 0;
+        while (i + num < this->batchLen && num < MAX_NUM_PROPS && this->batch[i + num].group == group && this->batch[i + num].prop == start + num)
+            num++;
+
+        // length byte, then [cmd, group, num, start, data...]
+        if (pos + 5 + num > maxLen)
+            return 0;
+        out[pos++] = 4 + num;
+        out[pos++] = C_SET_PROPERTY;
+        out[pos++] = group;
+        out[pos++] = num;
+        out[pos++] = start;
+        for (int j = 0; j < num; j++)
+            out[pos++] = this->batch[i++].value;
+    }
+    return pos;
+}
+
+void Si4463::printConfig(const char *name)
+{
+    // every staged property takes one byte, plus 5 bytes per command in the worst case
+    uint8_t config[Si4463::MAX_BATCH_PROPS * 6];
+    uint32_t len = this->exportConfig(config, sizeof(config));
+
+    Serial.print("const unsigned char ");
+    Serial.print(name);
+    Serial.println("[] = {");
+    uint32_t i = 0;
+    while (i < len)
+    {
+        // one command per line, like the WDS arrays
+        uint8_t cmdLen = config[i];
+        Serial.print("\t");
+        for (uint32_t j = i; j <= i + cmdLen; j++)
+        {
+            char str[7] = {};
+            snprintf(str, 7, "0x%02X, ", config[j]);
+            Serial.print(str);
         }
+        Serial.println();
+        i += cmdLen + 1;
     }
+    Serial.println("};");
+}
+
+bool Si4463::addProfile(const char *name, Si4463HardwareConfig hConfig, const uint8_t *config, uint32_t length)
+{
+    // the profile is staged in the batch, so it can't be added in the middle of one
+    // begin() has to see every profile to record the values of their properties
+    if (this->numProfiles == Si4463::MAX_PROFILES || this->batching || this->began || this->findProfile(name) != nullptr)
+        return false;
+    if (Si4463FreqPlan::config(hConfig.freq).band == -1 || Si4463FreqPlan::symbolRate(hConfig.dataRate) == 0)
+        return false;
+
+    // setModemConfig() and setPacketConfig() update the current settings as they go
+    Si4463Mod mod = this->mod;
+    int8_t band = this->band;
+    uint8_t channel = this->channel;
+    uint32_t freq = this->freq;
+    uint32_t byteDelay = this->byteDelay;
+    this->mod = hConfig.mod;
+
+    // stage the same properties begin() would, without sending anything
+    this->buildingProfile = true;
+    this->profileOverflow = false;
+    this->beginBatch();
+    if (config == nullptr)
+        this->applyConfigArray(DEFAULT_CONFIG_ARR, sizeof(DEFAULT_CONFIG_ARR));
     else
+        this->applyConfigArray(config, length);
+    // setAFC() would read the gain from the radio, so AFC is only turned on here if the WDS array sets the gain
+    uint8_t afcGain = 0;
+    if (this->findStaged(G_MODEM, P_MODEM_AFC_GAIN2, afcGain))
+        this->stageProperty(G_MODEM, P_MODEM_AFC_GAIN2, afcGain | 0b10000000);
+    this->setModemConfig(hConfig.mod, hConfig.dataRate, hConfig.freq);
+    this->setPower(hConfig.pwr);
+    this->setPacketConfig(hConfig.mod, hConfig.preambleLen, hConfig.preambleThresh);
+    this->batching = false;
+    this->buildingProfile = false;
+
+    this->mod = mod;
+    this->band = band;
+    this->channel = channel;
+    this->freq = freq;
+    this->byteDelay = byteDelay;
+
+    if (this->profileOverflow)
+        return false;
+
+    // the crc belongs to setCRC(), so switching profiles doesn't change it
+    Si4463Profile &p = this->profiles[this->numProfiles];
+    p.props = new Si4463StagedProp[this->batchLen];
+    p.numProps = 0;
+    for (int i = 0; i < this->batchLen; i++)
     {
-        // read one byte (length byte), then read that many bytes, then repeat
-        for (unsigned int i = 0; i < this->configLen; i++)
+        const Si4463StagedProp &prop = this->batch[i];
+        if (prop.group == G_PKT && (prop.prop == P_PKT_CRC_CONFIG || prop.prop == P_PKT_FIELD_1_CRC_CONFIG || prop.prop == P_PKT_FIELD_2_CRC_CONFIG))
+            continue;
+        p.props[p.numProps++] = prop;
+    }
+    p.name = name;
+    p.hConfig = hConfig;
+    this->numProfiles++;
+    return true;
+}
+
+bool Si4463::switchProfile(const char *name)
+{
+    Si4463Profile *p = this->findProfile(name);
+    // the modem can't be reconfigured while a packet is going out
+    if (p == nullptr || !this->began || this->state == STATE_TX || this->state == STATE_TX_COMPLETE || this->streaming())
+        return false;
+
+    // leave RX so the properties aren't changed under a packet, any partially received packet is lost
+    bool wasRX = this->state == STATE_RX;
+    if (wasRX)
+    {
+        this->state = STATE_IDLE;
+        this->xfrd = 0;
+        this->length = 0;
+        this->availLen = 0;
+        uint8_t cReadyArgs[1] = {0b00000011};
+        this->sendCommandC(C_CHANGE_STATE, 1, cReadyArgs);
+    }
+
+    // every property any profile sets is in profileBase, and all the lists are sorted, so the differences are found in one pass
+    this->beginBatch();
+    int t = 0;
+    int s = 0;
+    for (int i = 0; i < this->profileBaseLen; i++)
+    {
+        // properties the profile doesn't set go back to their value from before any configuration was applied
+        Si4463StagedProp prop = this->profileBase[i];
+        if (t < p->numProps && p->props[t].group == prop.group && p->props[t].prop == prop.prop)
+            prop.value = p->props[t++].value;
+        uint16_t key = (prop.group << 8) | prop.prop;
+        while (s < this->shadowLen && ((this->shadow[s].group << 8) | this->shadow[s].prop) < key)
+            s++;
+        // properties that haven't been sent since begin() are always sent
+        if (s < this->shadowLen && this->shadow[s].group == prop.group && this->shadow[s].prop == prop.prop && this->shadow[s].value == prop.value)
+            continue;
+        this->stageProperty(prop.group, prop.prop, prop.value);
+    }
+    this->commitBatch();
+
+    // same settings as setModemConfig() leaves behind
+    Si4463FreqConfig f = Si4463FreqPlan::config(p->hConfig.freq);
+    this->mod = p->hConfig.mod;
+    this->dataRate = p->hConfig.dataRate;
+    this->band = f.band;
+    this->channel = f.channel;
+    this->freq = f.freq;
+    this->byteDelay = Si4463FreqPlan::byteDelay(p->hConfig.dataRate);
+    this->pwr = p->hConfig.pwr;
+    this->preambleLen = p->hConfig.preambleLen;
+    this->preambleThresh = p->hConfig.preambleThresh;
+    this->profile = p;
+
+    if (wasRX)
+        this->rx();
+    return true;
+}
+
+void Si4463::recordProfileBase()
+{
+    if (this->profileBase != nullptr)
+        delete[] this->profileBase;
+    this->profileBase = nullptr;
+    this->profileBaseLen = 0;
+    if (this->numProfiles == 0)
+        return;
+
+    // merge the sorted property lists of every profile
+    uint16_t total = 0;
+    for (int i = 0; i < this->numProfiles; i++)
+        total += this->profiles[i].numProps;
+    this->profileBase = new Si4463StagedProp[total];
+    for (int i = 0; i < this->numProfiles; i++)
+    {
+        const Si4463Profile &p = this->profiles[i];
+        for (int j = 0; j < p.numProps; j++)
         {
-            // CS low through entire SPI command
-            digitalWrite(this->_cs, LOW);
+            uint16_t key = (p.props[j].group << 8) | p.props[j].prop;
+            int k = 0;
+            while (k < this->profileBaseLen && ((this->profileBase[k].group << 8) | this->profileBase[k].prop) < key)
+                k++;
+            if (k < this->profileBaseLen && this->profileBase[k].group == p.props[j].group && this->profileBase[k].prop == p.props[j].prop)
+                continue;
+            memmove(&this->profileBase[k + 1], &this->profileBase[k], (this->profileBaseLen - k) * sizeof(Si4463StagedProp));
+            this->profileBase[k] = {p.props[j].group, p.props[j].prop, 0};
+            this->profileBaseLen++;
+        }
+    }
 
-            for (int j = 0; j < this->WDS_CONFIG[i]; j++)
-            {
-                this->spi->transfer(this->WDS_CONFIG[i + j + 1]);
-            }
-            digitalWrite(this->_cs, HIGH);
-            i += this->WDS_CONFIG[i];
+    // read them in as few GET_PROPERTY commands as possible, small gaps are read along with the properties around them
+    int i = 0;
+    while (i < this->profileBaseLen)
+    {
+        uint8_t group = this->profileBase[i].group;
+        uint8_t start = this->profileBase[i].prop;
+        int end = i;
+        while (end < this->profileBaseLen && this->profileBase[end].group == group && this->profileBase[end].prop - start < MAX_NUM_PROPS)
+            end++;
+        uint8_t data[MAX_NUM_PROPS] = {};
+        this->getProperty((Si4463Group)group, this->profileBase[end - 1].prop - start + 1, (Si4463Property)start, data);
+        for (; i < end; i++)
+        {
+            this->profileBase[i].value = data[this->profileBase[i].prop - start];
+            // begin() turns AFC on after the configuration is applied, see setAFC()
+            if (group == G_MODEM && this->profileBase[i].prop == P_MODEM_AFC_GAIN2)
+                this->profileBase[i].value |= 0b10000000;
+        }
+    }
+}
 
-            this->waitCTS();
+void Si4463::stageProperty(uint8_t group, uint8_t prop, uint8_t value)
+{
+    // keep the batch sorted so contiguous properties end up next to each other
+    uint16_t key = (group << 8) | prop;
+    int i = 0;
+    while (i < this->batchLen && ((this->batch[i].group << 8) | this->batch[i].prop) < key)
+        i++;
+
+    // already staged, last write wins
+    if (i < this->batchLen && this->batch[i].group == group && this->batch[i].prop == prop)
+    {
+        this->batch[i].value = value;
+        return;
+    }
+
+    // out of space, send what we have and start over
+    if (this->batchLen == Si4463::MAX_BATCH_PROPS)
+    {
+        // a profile has to fit in one batch, addProfile() fails instead
+        if (this->buildingProfile)
+        {
+            this->profileOverflow = true;
+            return;
+        }
+        this->commitBatch();
+        this->beginBatch();
+        i = 0;
+    }
+
+    // shift everything after the insertion point
+    memmove(&this->batch[i + 1], &this->batch[i], (this->batchLen - i) * sizeof(Si4463StagedProp));
+    this->batch[i] = {group, prop, value};
+    this->batchLen++;
+}
+
+bool Si4463::findStaged(uint8_t group, uint8_t prop, uint8_t &value)
+{
+    for (int i = 0; i < this->batchLen; i++)
+    {
+        if (this->batch[i].group == group && this->batch[i].prop == prop)
+        {
+            value = this->batch[i].value;
+            return true;
         }
     }
+    return false;
+}
+
+void Si4463::shadowProperty(uint8_t group, uint8_t prop, uint8_t value)
+{
+    // same sorted insert as stageProperty()
+    uint16_t key = (group << 8) | prop;
+    int i = 0;
+    while (i < this->shadowLen && ((this->shadow[i].group << 8) | this->shadow[i].prop) < key)
+        i++;
+
+    if (i < this->shadowLen && this->shadow[i].group == group && this->shadow[i].prop == prop)
+    {
+        this->shadow[i].value = value;
+        return;
+    }
+
+    // out of space, untracked properties are always sent by switchProfile()
+    if (this->shadowLen == Si4463::MAX_SHADOW_PROPS)
+        return;
+
+    memmove(&this->shadow[i + 1], &this->shadow[i], (this->shadowLen - i) * sizeof(Si4463StagedProp));
+    this->shadow[i] = {group, prop, value};
+    this->shadowLen++;
+}
+
+Si4463Profile *Si4463::findProfile(const char *name)
+{
+    for (int i = 0; i < this->numProfiles; i++)
+        if (strcmp(this->profiles[i].name, name) == 0)
+            return &this->profiles[i];
+    return nullptr;
 }
 
 // Basic power function
@@ -3,12 +3,16 @@
 
 #include "Radio.h"
 #include "Si4463_defs.h"
+#include "Si4463_freq.h"
 #include "SPI.h"
+#include "Si4463Bus.h"
 
 // include the default configuration file
 #include "Si4463_default.h"
-// RF4463F30 COTS radios require this to be defined
+// RF4463F30 COTS radios require this to be defined, boards with a bare Si4463 build with SI4463_NO_RF4463F30 defined
+#ifndef SI4463_NO_RF4463F30
 #define RF4463F30
+#endif
 // set to 1 to always force using SPI for CTS
 // #define FORCE_SPI_CTS 1
 
@@ -56,8 +60,188 @@ struct Si4463PinConfig
     uint8_t gpio3;
 };
 
+/*
+Si4463 MCU Pin, one of the pins in Si4463PinConfig with its GPIO registers looked up once by attach()
+Reading or writing it is then a single register access instead of a pin table lookup in digitalRead()/digitalWrite()
+Only the Teensy 4.x caches the registers, other cores fall back to digitalRead()/digitalWrite()
+Building with SI4463_DIGITAL_PINS defined uses digitalRead()/digitalWrite() on the Teensy too, to compare against
+- uint8_t pin : the MCU pin number
+*/
+struct Si4463IOPin
+{
+    uint8_t pin = 0;
+#if defined(__IMXRT1062__) && !defined(SI4463_DIGITAL_PINS)
+    volatile uint32_t *in = nullptr;
+    volatile uint32_t *set = nullptr;
+    volatile uint32_t *clear = nullptr;
+    uint32_t mask = 0;
+#endif
+
+    void attach(uint8_t pin);
+    bool read() const
+    {
+#if defined(__IMXRT1062__) && !defined(SI4463_DIGITAL_PINS)
+        return (*this->in & this->mask) != 0;
+#else
+        return digitalRead(this->pin);
+#endif
+    }
+    void write(bool level) const
+    {
+#if defined(__IMXRT1062__) && !defined(SI4463_DIGITAL_PINS)
+        *(level ? this->set : this->clear) = this->mask;
+#else
+        digitalWrite(this->pin, level);
+#endif
+    }
+};
+
+/*
+Si4463 Transmit Segment
+- const uint8_t *data : the bytes to send, must stay valid until the transmission's completion callback
+- uint16_t len : the number of bytes
+*/
+struct Si4463Segment
+{
+    const uint8_t *data;
+    uint16_t len;
+};
+
+/*
+Si4463 Stream Frame Header, sent at the start of every packet of a stream (see startStream())
+- uint8_t flags : Si4463StreamFlag bits
+- uint32_t offset : the position of the frame's first payload byte in the stream, a gap means frames were lost
+*/
+struct Si4463StreamHeader
+{
+    uint8_t flags;
+    uint32_t offset;
+};
+
+/*
+Si4463 Received Packet Info
+- uint16_t length : the length of the packet in bytes
+- int rssi : the received signal strength in dBm
+- int16_t afc : the AFC frequency offset of the packet (raw AFC_FREQ_OFFSET, see datasheet)
+- uint32_t timestamp : the time the packet finished being received (micros())
+*/
+struct Si4463RXPacket
+{
+    uint16_t length;
+    int rssi;
+    int16_t afc;
+    uint32_t timestamp;
+};
+
+/*
+Si4463 Link Statistics, all counts are since the radio was constructed or the last resetStats()
+- uint32_t txPackets : the number of packets fully written to the TX FIFO
+- uint32_t txBytes : the number of message bytes in those packets
+- uint32_t rxPackets : the number of packets fully read from the RX FIFO (including ones dropped by the RX queue)
+- uint32_t rxBytes : the number of message bytes in those packets
+- uint32_t rxDropped : the number of packets dropped because the RX queue was full or the packet was too long for a slot
+- uint32_t crcErrors : the number of packets discarded because they failed the hardware crc check
+- uint32_t lengthErrors : the number of packets with an invalid length field (0 or more than MAX_LEN)
+- uint32_t txUnderflows : the number of times the TX FIFO underflowed
+- uint32_t rxOverflows : the number of times the RX FIFO overflowed
+- uint32_t ctsWaits : histogram of CTS wait times, bucket i counts waits shorter than CTS_HIST_BASE << i us, the last bucket counts the rest
+- uint32_t ctsTimeouts : the number of times CTS was not received before the timeout
+- uint32_t spiTime : the total time spent with CS low in us
+- int rssi : the received signal strength of the last packet in dBm
+- int16_t afc : the AFC frequency offset of the last packet (raw AFC_FREQ_OFFSET, see datasheet)
+*/
+struct Si4463Stats
+{
+    // number of buckets in the CTS wait histogram
+    static const uint8_t CTS_HIST_BINS = 8;
+    // upper limit of the first CTS wait bucket
+    static const uint32_t CTS_HIST_BASE = 16; // us
+
+    uint32_t txPackets;
+    uint32_t txBytes;
+    uint32_t rxPackets;
+    uint32_t rxBytes;
+    uint32_t rxDropped;
+    uint32_t crcErrors;
+    uint32_t lengthErrors;
+    uint32_t txUnderflows;
+    uint32_t rxOverflows;
+    uint32_t ctsWaits[CTS_HIST_BINS];
+    uint32_t ctsTimeouts;
+    uint32_t spiTime;
+    int rssi;
+    int16_t afc;
+};
+
+/*
+Si4463 Queued Command, sent with queueCommand() without waiting for CTS
+The radio keeps a pointer to the command until it is done, so it must stay valid until then
+- Si4463Cmd cmd : the command to send
+- uint8_t argc : the number of command arguments (max MAX_ARGS)
+- uint8_t args : the command arguments
+- uint8_t resLen : the number of response bytes to read (max MAX_RES)
+- uint8_t res : the response, valid once the status is CMD_DONE
+- void (*onComplete)(Si4463Command *, void *) : called once the command is done or has failed (from update() or the radio's waits), may be nullptr
+- void *ctx : passed to onComplete
+- Si4463CmdStatus status : the progress of the command, set by the radio
+- uint32_t sentAt : the time the command was sent (micros()), set by the radio
+*/
+struct Si4463Command
+{
+    // maximum number of arguments and response bytes
+    static const uint8_t MAX_ARGS = 16;
+    static const uint8_t MAX_RES = 16;
+
+    Si4463Cmd cmd;
+    uint8_t argc;
+    uint8_t args[MAX_ARGS];
+    uint8_t resLen;
+    uint8_t res[MAX_RES];
+    void (*onComplete)(Si4463Command *cmd, void *ctx);
+    void *ctx;
+    volatile Si4463CmdStatus status;
+    uint32_t sentAt;
+
+    /*
+    Checks whether the command has finished, successfully or not
+    Returns: whether the status is CMD_DONE or CMD_FAILED
+    */
+    bool done() const { return this->status == CMD_DONE || this->status == CMD_FAILED; }
+};
+
+/*
+Si4463 Staged Property
+- uint8_t group : the property group
+- uint8_t prop : the property index within the group
+- uint8_t value : the value to set the property to
+*/
+struct Si4463StagedProp
+{
+    uint8_t group;
+    uint8_t prop;
+    uint8_t value;
+};
+
+/*
+Si4463 Radio Profile, a configuration cached by addProfile() so it can be switched to without resetting the radio
+- const char *name : the name used to switch to the profile
+- Si4463HardwareConfig hConfig : the hardware configuration of the profile
+- Si4463StagedProp *props : the properties the profile sets, sorted by group then property
+- uint8_t numProps : the number of properties in ```props```
+*/
+struct Si4463Profile
+{
+    const char *name;
+    Si4463HardwareConfig hConfig;
+    Si4463StagedProp *props;
+    uint8_t numProps;
+};
+
 class Si4463 : public Radio
 {
+    // the bus services FIFOs and checks the SPI bus directly
+    friend class Si4463Bus;
+
 public:
     // the maximum length of a transmitted or received message
     static const uint16_t MAX_LEN = 0x1FFF;
@@ -69,22 +253,37 @@ public:
     static const uint8_t CTS_TIMEOUT = 100; // ms
     // length of the FIFO in default config
     static const uint8_t FIFO_LENGTH = 129; // bytes
-    // RX_FIFO_FULL interrupt occurs when there are more than RX_THRESH bytes in FIFO
+    // RX_FIFO_FULL interrupt occurs when there are more than RX_THRESH bytes in FIFO (default, see setRXThreshold())
     static const uint8_t RX_THRESH = 40; // bytes (max 64)
-    // TX_FIFO_EMPTY interrupt occurs when there is more than TX_THRESH bytes of space in FIFO
+    // TX_FIFO_EMPTY interrupt occurs when there is more than TX_THRESH bytes of space in FIFO (default, see setTXThreshold())
     static const uint8_t TX_THRESH = 63; // bytes (max 64)
+    // SPI clock used for all transactions with the radio
+    static const uint32_t SPI_CLOCK = 10000000; // Hz (max for the Si4463)
+    // maximum number of radios that can be serviced from the nIRQ pin at once
+    static const uint8_t MAX_IRQ_RADIOS = 4;
+    // maximum number of properties that can be staged in a batch before it is flushed
+    static const uint8_t MAX_BATCH_PROPS = 192;
+    // maximum number of property values remembered from what was sent to the radio, see switchProfile()
+    static const uint8_t MAX_SHADOW_PROPS = 255;
+    // maximum number of profiles that can be added with addProfile()
+    static const uint8_t MAX_PROFILES = 4;
+    // maximum number of commands waiting in the command queue
+    static const uint8_t CMD_QUEUE_LEN = 8;
+    // length of the header at the start of each stream frame, see Si4463StreamHeader
+    static const uint8_t STREAM_HEADER_LEN = 5; // bytes
     // the current radio state, does not always align with hardware state
-    Si4463State state = STATE_IDLE;
+    volatile Si4463State state = STATE_IDLE;
     // a Message object used to encode and decode the message
     Message m;
-    // the buffer to store messages that are currently being sent or received
-    uint8_t buf[Si4463::MAX_LEN];
+    // the MAX_LEN byte buffer for messages sent with tx() or startTX() or received without an RX queue
+    // allocated the first time it is needed unless given with setBuffer(), txSegments(), streams and the RX queue don't use it
+    uint8_t *buf = nullptr;
     // the length of the buffer
     uint16_t length = 0;
     // the number of message bytes transferred
-    uint16_t xfrd = 0;
+    volatile uint16_t xfrd = 0;
     // pointer to the end of data in ```buf``` (TX), or the start of unread data (RX)
-    uint32_t availLen = 0;
+    volatile uint32_t availLen = 0;
     // the received signal strength
     int rssi = 100;
     // the modulation scheme the radio is using
@@ -95,6 +294,8 @@ public:
     uint32_t freq;
     // the current channel used to set the transmit/receive frequency
     uint8_t channel = 0;
+    // the current band (index into Si4463FreqPlan tables), -1 until the modem is configured
+    int8_t band = -1;
     // the current transmit power (0-127), see datasheet
     uint8_t pwr;
     // the current preamble length in symbols
@@ -102,7 +303,9 @@ public:
     // the current preamble length threshold for packet detection in symbols
     uint8_t preambleThresh;
     // whether a full message has been received
-    bool available = false;
+    volatile bool available = false;
+    // the crc used by the packet handler
+    Si4463CRC crc = CRC_NONE;
     // the amount of time between attempting to read/write bytes
     uint32_t byteDelay = 0;
 
@@ -198,12 +401,125 @@ public:
     */
     uint16_t writeTXBuf(const uint8_t *data, uint16_t len);
     /*
+    Transmits a message made of several segments (ex. header, payload, parity) straight from the caller's memory without copying into ```buf```
+    The segment array and the data it points to must stay valid until onComplete is called
+    - segs : the segments to send, in order
+    - count : the number of segments
+    - onComplete : called once every byte has been written to the FIFO (from update()), may be nullptr
+    - ctx : passed to onComplete
+    Returns: whether a transmission was successfully started
+    */
+    bool txSegments(const Si4463Segment *segs, uint8_t count, void (*onComplete)(void *) = nullptr, void *ctx = nullptr);
+    /*
+    Same as tx(), but sends straight from ```message``` without copying, see txSegments()
+    - message : the message to be transmitted, must stay valid until onComplete is called
+    - len : the length of the message
+    - onComplete : called once every byte has been written to the FIFO, may be nullptr
+    - ctx : passed to onComplete
+    Returns: whether a transmission was successfully started
+    */
+    bool txNoCopy(const uint8_t *message, uint16_t len, void (*onComplete)(void *) = nullptr, void *ctx = nullptr);
+    /*
+    Starts a stream, an unbounded transmission fed from a ring buffer with writeStream()
+    The stream is sent as back to back packets of up to frameLen bytes, each starting with a Si4463StreamHeader. The next packet is
+    written to the FIFO behind the one being sent and started from TX_TUNE as soon as it finishes, so the transmitter never waits on the FIFO.
+    Packets are cut short rather than waiting when the ring runs low, and nothing is sent while it is empty.
+    - ring : the ring buffer, must stay valid until the stream ends
+    - size : the length of the ring buffer
+    - frameLen : the maximum length of each packet, including the stream header (max MAX_LEN)
+    Returns: whether the stream was started
+    */
+    bool startStream(uint8_t *ring, uint16_t size, uint16_t frameLen = Si4463::MAX_LEN);
+    /*
+    Adds data to the stream started with startStream()
+    - data : the data to add
+    - len : the length of the data
+    Returns: the length of data added, less than len if the ring buffer is full
+    */
+    uint16_t writeStream(const uint8_t *data, uint16_t len);
+    /*
+    Used to get the free space in the stream's ring buffer
+    Returns: the number of bytes writeStream() can take
+    */
+    uint16_t streamSpace();
+    /*
+    Ends the stream once everything written so far has been sent, the last packet has the STREAM_END flag set
+    */
+    void endStream();
+    /*
+    Used to check whether a stream is running
+    Returns: whether a stream has been started and not yet finished
+    */
+    bool streaming();
+    /*
+    Decodes the header of a packet sent by a stream, the payload follows it
+    - frame : the received packet
+    - len : the length of the packet
+    - header : updated with the header
+    Returns: false if the packet is too short to be a stream frame
+    */
+    static bool readStreamHeader(const uint8_t *frame, uint16_t len, Si4463StreamHeader &header);
+    /*
     Similar to writeTXBuf(), can be used to read from the RX buffer before the full message has been received
     - data : the array to read data into
     - len : the length of data to read
     Returns: the length of data successfully added
     */
     uint16_t readRXBuf(uint8_t *data, uint16_t len);
+    /*
+    Sets up a queue of received packets, when enabled the radio stays in RX and each completed packet is queued
+    Packets are then read with readRXQueue() or receive(), and avail() returns whether any are queued
+    Must be called before rx() or avail()
+    - depth : the number of packets that can be queued (0 to disable the queue)
+    - slotLen : the maximum length of a queued packet, longer packets are dropped
+    Returns: whether the queue could be allocated
+    */
+    bool setRXQueue(uint8_t depth, uint16_t slotLen = Si4463::MAX_LEN);
+    /*
+    Used to get the number of packets waiting in the RX queue
+    Returns: the number of queued packets
+    */
+    uint8_t rxQueued();
+    /*
+    Removes the oldest packet from the RX queue and copies it into ```data```
+    - data : the array to read the packet into
+    - len : the length of ```data```, the packet is truncated if it is longer
+    - info : updated with the packet length, RSSI, and timestamp if not nullptr
+    Returns: the number of bytes copied, 0 if the queue is empty
+    */
+    uint16_t readRXQueue(uint8_t *data, uint16_t len, Si4463RXPacket *info = nullptr);
+    /*
+    Gives the radio a buffer for ```buf``` instead of letting it allocate its own the first time it is needed
+    Can't be changed while sending or receiving
+    - buffer : at least MAX_LEN bytes, must stay valid while the radio uses it
+    Returns: whether the buffer was set
+    */
+    bool setBuffer(uint8_t *buffer);
+    /*
+    Used to get the link statistics, the counters are updated as packets are sent and received so reading them does not use the SPI bus
+    Returns: the link statistics
+    */
+    const Si4463Stats &stats();
+    /*
+    Clears all the link statistics
+    */
+    void resetStats();
+    /*
+    Queues a command to be sent without waiting for CTS, update() sends it once the commands ahead of it are done and collects its response
+    Blocking commands (sendCommand(), setProperty(), etc.) wait for every queued command first so commands always reach the radio in order
+    - cmd : the command, must stay valid until it is done
+    Returns: false if the queue is full, the command is already queued, or begin() has not been called
+    */
+    bool queueCommand(Si4463Command &cmd);
+    /*
+    Used to get the number of commands waiting in the command queue, including the one waiting for CTS
+    Returns: the number of queued commands
+    */
+    uint8_t commandsQueued();
+    /*
+    Blocks until every queued command is done
+    */
+    void flushCommands();
 
     // tx/rx helper functions
     /*
@@ -219,6 +535,15 @@ public:
     */
     void handleRX();
     /*
+    Function called from the nIRQ interrupt when IRQ mode is enabled, services the FIFOs unless update() is servicing the radio
+    */
+    void handleIRQ();
+    /*
+    Function called by handleIRQ() and update() in IRQ mode, reads the interrupt status from the FRRs, clears it and moves
+    bytes to or from the FIFOs. Never waits for a command's response, packet events that need commands are left to update()
+    */
+    void serviceIRQ();
+    /*
     Used to check if data is available to be retrieved using receive(), also places the radio into rx mode
     Returns: whether a new message is available
     */
@@ -233,6 +558,26 @@ public:
     */
     void setModemConfig(Si4463Mod mod, Si4463DataRate dataRate, uint32_t freq);
     /*
+    Sets the crc the packet handler appends to transmitted packets and checks on received ones
+    Packets that fail the check are discarded and counted in stats() instead of being handed to the user
+    Can be called before begin() or while not transmitting or receiving, both ends of the link must use the same crc
+    - crc : the crc polynomial, CRC_NONE to turn it off
+    */
+    void setCRC(Si4463CRC crc);
+    /*
+    Switches to another channel in the current band without reconfiguring the modem
+    Takes effect immediately in RX (any partial packet is dropped), otherwise on the next transmit or receive
+    - channel : the channel, frequency = band base + channel * 100 kHz
+    Returns: false if transmitting or the modem has not been configured
+    */
+    bool setChannel(uint8_t channel);
+    /*
+    Tunes to a new frequency, using setChannel() if it is in the current band and setModemConfig() otherwise
+    - freq : the frequency (Hz)
+    Returns: false if the frequency cannot be tuned to or the radio is transmitting
+    */
+    bool setFrequency(uint32_t freq);
+    /*
     Sets the transmit power of the radio, see datasheet for correspondence between this value and actual power output
     - pwr : the power level of the radio (0-127)
     */
@@ -263,12 +608,14 @@ public:
     */
     void setFRRs(Si4463FRR regAMode, Si4463FRR regBMode = FRR_NO_CHANGE, Si4463FRR regCMode = FRR_NO_CHANGE, Si4463FRR regDMode = FRR_NO_CHANGE);
     /*
-    Sets the amount of empty space needed in the FIFO for TX_FIFO_EMPTY to go high
+    Sets the amount of empty space needed in the FIFO for TX_FIFO_EMPTY to go high, this many bytes are then written each time
+    begin() sets it to TX_THRESH, so call it afterwards to use a different threshold
     - size : the amount of empty space in bytes (max 64)
     */
     void setTXThreshold(uint8_t size);
     /*
-    Sets the numbers of bytes needed in the FIFO for RX_FIFO_FULL to go high
+    Sets the numbers of bytes needed in the FIFO for RX_FIFO_FULL to go high, this many bytes are then read each time
+    begin() sets it to RX_THRESH, so call it afterwards to use a different threshold
     - size : the number of bytes (max 64)
     */
     void setRXThreshold(uint8_t size);
@@ -278,6 +625,20 @@ public:
     */
     void setAFC(bool enabled);
     /*
+    Selects whether the FIFOs are serviced when the nIRQ pin interrupt fires rather than by polling GPIO 0 and 1 in update()
+    The FIFOs are read and written from the interrupt, so packets keep moving while update() isn't being called. Starting
+    stream frames, dropping bad packets and reading the RSSI still need update().
+    Must be called before begin(). In IRQ mode the nIRQ pin is no longer used for CTS, so CTS is checked over SPI.
+    - enabled : whether IRQ mode should be used
+    */
+    void setIRQMode(bool enabled);
+    /*
+    Selects whether FIFO reads and writes outside of IRQ mode are handed to DMA, letting update() return before the transfer finishes
+    Only supported on the Teensy 4.x. Any other SPI devices sharing the bus must not start a transaction while a transfer is in progress.
+    - enabled : whether async SPI should be used
+    */
+    void setAsyncSPI(bool enabled);
+    /*
     Used to get the state of the GPIO 0 pin
     Returns: the state of GPIO 0
     */
@@ -354,6 +715,62 @@ public:
     */
     void setProperty(uint8_t *data, uint8_t size);
     /*
+    Starts staging properties instead of sending them one at a time, until commitBatch() is called
+    Properties set while staging are coalesced into as few SET_PROPERTY commands as possible (up to MAX_NUM_PROPS each)
+    */
+    void beginBatch();
+    /*
+    Sends all staged properties, one SET_PROPERTY command per run of contiguous properties
+    The staged properties are kept so they can be exported with exportConfig() until beginBatch() is called again
+    */
+    void commitBatch();
+    /*
+    Selects whether begin() stages its configuration and sends it as a batch (default), or sends each property separately
+    - enabled : whether begin() should use batching
+    */
+    void setBatchConfig(bool enabled);
+    /*
+    Writes the last committed batch as a configuration array in the same format as the WDS arrays ([length, command bytes...])
+    The result can be passed to begin() in place of a WDS array, the setters in begin() then only restage the same values
+    - out : the array to write the configuration into
+    - maxLen : the length of ```out```
+    Returns: the number of bytes written, or 0 if ```out``` is too small
+    */
+    uint32_t exportConfig(uint8_t *out, uint32_t maxLen);
+    /*
+    Prints the last committed batch as a C array that can be saved in a header next to the WDS config arrays
+    - name : the name of the array
+    */
+    void printConfig(const char *name = "PRECOMPUTED_CONFIG_ARR");
+    /*
+    Caches a radio configuration so switchProfile() can change to it at runtime without resetting the radio
+    The profile holds the properties begin() sets for this configuration (the WDS array, modem, power, and packet settings),
+    the global, interrupt, FIFO threshold, FRR, and CRC settings are shared by every profile
+    Nothing is sent to the radio. Profiles have to be added before begin(), which records the values their properties start
+    from (see switchProfile()). The profile is left in the batch for printConfig()
+    - name : the name of the profile, not copied so it must outlive the radio (a string literal)
+    - hConfig : the hardware configuration of the profile
+    - config : the WDS configuration array of the profile, or nullptr for the default configuration
+    - length : the length of ```config```
+    Returns: whether the profile was added, false if the name is taken, the bank is full, the configuration is invalid, or
+    begin() was already called
+    */
+    bool addProfile(const char *name, Si4463HardwareConfig hConfig, const uint8_t *config = nullptr, uint32_t length = 0);
+    /*
+    Switches to a profile added with addProfile(), only sending the properties that differ from what was last sent to the radio
+    Properties another profile sets but this one doesn't go back to the value begin() found before applying a configuration
+    (the power on default, or begin()'s global settings), so the radio ends up as a fresh begin() with the profile would leave
+    it. The radio goes back to RX afterwards if it was receiving, any partially received packet is lost
+    - name : the name of the profile
+    Returns: whether the profile was applied, false if it doesn't exist, begin() hasn't been called, or the radio is
+    transmitting or streaming
+    */
+    bool switchProfile(const char *name);
+    /*
+    Returns: the name of the profile last switched to, or nullptr if switchProfile() hasn't been called
+    */
+    const char *currentProfile() const { return this->profile != nullptr ? this->profile->name : nullptr; }
+    /*
     Reads all the FRRs
     - data : the array to be populated with the values of the FRRs
     - start : the index of the FRR to start reading at
@@ -436,6 +853,168 @@ private:
     // other pins (these will be set to one of the above gpio pins)
     int _cts = -1;
 
+    // the pins read and written on every update() and SPI transaction, set up by begin()
+    Si4463IOPin csPin;
+    Si4463IOPin irqPin;
+    Si4463IOPin gpioPins[4];
+
+    // SPI settings used for every transaction with the radio
+    SPISettings spiSettings = SPISettings(Si4463::SPI_CLOCK, MSBFIRST, SPI_MODE0);
+
+    // IRQ mode variables
+    // whether the FIFOs are serviced when the nIRQ interrupt fires
+    bool irqMode = false;
+    // index of this radio in irqRadios, -1 if not attached
+    int8_t irqSlot = -1;
+    // radios currently attached to an nIRQ interrupt
+    static Si4463 *irqRadios[Si4463::MAX_IRQ_RADIOS];
+    // packet handler interrupts serviced in IRQ mode
+    static const uint8_t IRQ_PH_ENABLE = PH_PACKET_SENT | PH_PACKET_RX | PH_CRC_ERROR | PH_TX_FIFO_ALMOST_EMPTY | PH_RX_FIFO_ALMOST_FULL;
+    // set while update() services the radio, the interrupt leaves it alone until then
+    volatile bool irqHeld = false;
+    // set when the interrupt was skipped or couldn't clear the pending interrupts, serviced again by the main loop
+    volatile bool irqPending = false;
+    // set when the interrupt sent a command, CTS has to be checked before the next one
+    volatile bool irqCmd = false;
+    // set while sendCommand() is waiting for a response, the interrupt can't send a command until it is read
+    volatile bool cmdOpen = false;
+    // packet events already serviced but not cleared yet, so they aren't serviced twice
+    volatile uint8_t irqSeen = 0;
+    // packet events (PH_PACKET_SENT, PH_CRC_ERROR) the interrupt left for update() since they need commands
+    volatile uint8_t irqEvents = 0;
+    // FIFO errors seen by the interrupt, counted and cleared by update()
+    volatile uint8_t irqChipPend = 0;
+    // set when the interrupt started reading a packet, update() reads its RSSI
+    volatile bool irqSignal = false;
+
+    // zero-copy TX variables
+    // the segments being sent, nullptr when sending from buf
+    const Si4463Segment *txSegs = nullptr;
+    // number of segments
+    uint8_t txSegCount = 0;
+    // segment containing the next byte to send
+    uint8_t txSegIdx = 0;
+    // offset of the next byte to send in the current segment
+    uint16_t txSegOff = 0;
+    // segment used by txNoCopy()
+    Si4463Segment txSingle = {nullptr, 0};
+    // called when a transmission has been completely written to the FIFO
+    void (*txCallback)(void *) = nullptr;
+    // passed to txCallback
+    void *txCallbackCtx = nullptr;
+
+    // streaming TX variables, frames are opened and started by update() (writeStream() and endStream() leave it to update())
+    // in IRQ mode the interrupt writes the frame being loaded
+    // the producer's ring buffer, nullptr when not streaming
+    uint8_t *streamRing = nullptr;
+    // length of streamRing, one byte is left empty so full and empty can be told apart
+    uint16_t streamSize = 0;
+    // next byte to be written (by the user)
+    uint16_t streamHead = 0;
+    // next byte to be sent (by the radio)
+    volatile uint16_t streamTail = 0;
+    // total payload bytes written to the FIFO, the offset of the next frame
+    uint32_t streamOut = 0;
+    // maximum packet length, including the stream header
+    uint16_t streamFrameLen = 0;
+    // length field and stream header of the frame being written to the FIFO
+    uint8_t streamHeader[2 + Si4463::STREAM_HEADER_LEN] = {};
+    // whether a frame is being written to the FIFO (length and xfrd belong to it)
+    bool streamLoading = false;
+    // whether the frame being written has been started
+    bool streamStarted = false;
+    // whether a frame is being sent, only one is ever started at a time
+    bool streamOnAir = false;
+    // length of the packet being sent
+    uint16_t streamAirLen = 0;
+    // whether endStream() has been called, and whether the frame with STREAM_END has been opened
+    bool streamEnding = false;
+    bool streamEndOpened = false;
+
+    // shared bus variables
+    // the bus this radio was added to, nullptr if it has the SPI bus to itself
+    Si4463Bus *bus = nullptr;
+
+    // RX queue variables
+    // packet data, rxQueueSlots slots of rxQueueSlotLen bytes
+    uint8_t *rxQueue = nullptr;
+    // packet info for each slot
+    Si4463RXPacket *rxQueueInfo = nullptr;
+    // number of slots, one more than the queue depth so full and empty can be told apart
+    uint8_t rxQueueSlots = 0;
+    // length of each slot
+    uint16_t rxQueueSlotLen = 0;
+    // next slot to be written (by the radio)
+    volatile uint8_t rxHead = 0;
+    // next slot to be read (by the user)
+    volatile uint8_t rxTail = 0;
+
+    // command queue variables
+    // queued commands, one more slot than CMD_QUEUE_LEN so full and empty can be told apart
+    Si4463Command *cmdQueue[Si4463::CMD_QUEUE_LEN + 1] = {nullptr};
+    // next slot to be written
+    volatile uint8_t cmdHead = 0;
+    // oldest queued command, the only one that can be waiting for CTS
+    volatile uint8_t cmdTail = 0;
+    // commands used by update() so it never waits for CTS
+    Si4463Command signalCmd = {C_GET_MODEM_STATUS, 1, {0xFF}, 8, {}, Si4463::signalLatched, this, CMD_IDLE, 0};
+    Si4463Command phStatusCmd = {C_GET_PH_STATUS, 1, {0xFF ^ (PH_PACKET_RX | PH_CRC_ERROR)}, 2, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command fifoInfoCmd = {C_FIFO_INFO, 1, {0x00}, 2, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command chipStatusCmd = {C_GET_CHIP_STATUS, 1, {0xFF ^ CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR}, 4, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command clearFIFOCmd = {C_FIFO_INFO, 1, {0b00000011}, 0, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command startRXCmd = {C_START_RX, 7, {}, 0, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command txSentCmd = {C_GET_PH_STATUS, 1, {0xFF ^ PH_PACKET_SENT}, 2, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command startTXCmd = {C_START_TX, 6, {}, 0, {}, nullptr, nullptr, CMD_IDLE, 0};
+    Si4463Command readyCmd = {C_CHANGE_STATE, 1, {0b00000011}, 0, {}, nullptr, nullptr, CMD_IDLE, 0};
+
+    // batch config variables
+    // properties staged for the current batch, sorted by group then property
+    Si4463StagedProp batch[Si4463::MAX_BATCH_PROPS];
+    // number of staged properties
+    uint8_t batchLen = 0;
+    // whether properties are currently being staged
+    bool batching = false;
+    // whether begin() should batch its configuration
+    bool batchConfig = true;
+
+    // profile bank variables
+    // cached configurations, see addProfile()
+    Si4463Profile profiles[Si4463::MAX_PROFILES] = {};
+    // number of cached profiles
+    uint8_t numProfiles = 0;
+    // the profile last switched to
+    Si4463Profile *profile = nullptr;
+    // every property set by any profile with the value it had before begin() applied a configuration, sorted by group
+    // then property, see recordProfileBase()
+    Si4463StagedProp *profileBase = nullptr;
+    // number of properties in profileBase
+    uint16_t profileBaseLen = 0;
+    // the value of each property last sent to the radio since begin(), sorted by group then property
+    Si4463StagedProp shadow[Si4463::MAX_SHADOW_PROPS];
+    // number of properties in the shadow
+    uint8_t shadowLen = 0;
+    // whether a profile is being staged, commands that aren't SET_PROPERTY are dropped instead of sent
+    bool buildingProfile = false;
+    // whether properties were dropped while building a profile because the batch was full
+    bool profileOverflow = false;
+
+    // whether buf was allocated by the radio and has to be freed
+    bool ownBuf = false;
+
+    // async SPI variables
+    // whether FIFO transfers are done with DMA
+    bool asyncSPI = false;
+    // whether a DMA transfer is in progress, shared since radios may share a bus
+    static volatile bool spiBusy;
+    // number of message bytes in the current DMA transfer
+    uint16_t asyncLen = 0;
+    // whether the current DMA transfer is reading from the RX FIFO
+    bool asyncRX = false;
+#if defined(__IMXRT1062__)
+    // signals the end of a DMA transfer
+    EventResponder spiEvent;
+#endif
+
     // WDS radio config variables
     // array to hold WDS config
     uint8_t *WDS_CONFIG = nullptr;
@@ -445,13 +1024,229 @@ private:
     // other config that can be private
     // timer for byteDelay
     uint32_t timer = millis();
+    // the FIFO thresholds currently set on the radio
+    uint8_t txThresh = Si4463::TX_THRESH;
+    uint8_t rxThresh = Si4463::RX_THRESH;
     bool TXEmptyFlag = false;
+    // set by serviceIRQ() when the TX FIFO ran low but there was no data left to send
+    volatile bool txStarved = false;
     bool RXFullFlag = false;
     // force use of SPI CTS until GPIO is setup
     bool useSPICTS = true;
+    // whether begin() has completed
+    bool began = false;
+
+    // statistics variables
+    // link statistics returned by stats()
+    Si4463Stats linkStats = {};
+    // the time CS was last pulled low
+    uint32_t selectTime = 0;
+
+    /*
+    Completion callback for ```signalCmd```, reads the latched RSSI and the AFC offset of the packet being received
+    - cmd : the finished GET_MODEM_STATUS command
+    - ctx : the radio
+    */
+    static void signalLatched(Si4463Command *cmd, void *ctx);
+    /*
+    Adds a CTS wait to the histogram in the link statistics
+    - us : how long the wait took in microseconds
+    */
+    void recordCTS(uint32_t us);
+    /*
+    Counts a FIFO underflow or overflow if one is pending and clears it
+    - chipPend : the CHIP_PEND byte from FRR C
+    */
+    void checkFIFOError(uint8_t chipPend);
+    /*
+    Sends the crc configuration for ```crc``` to the packet handler
+    */
+    void applyCRC();
+    /*
+    Drops the packet being received after a crc error and clears the RX FIFO
+    */
+    void discardRX();
+    /*
+    Sends START_RX on the current channel
+    - queued : whether to queue the command instead of sending it straight away
+    */
+    void startRX(bool queued = false);
+    /*
+    Checks the FIFO status pins and moves bytes to or from the FIFOs, called by update() and by the bus
+    */
+    void serviceFIFOs();
+    /*
+    Called while waiting for CTS, lets the bus service other radios or delays otherwise
+    - us : the delay in microseconds if there is nothing else to do
+    */
+    void waitIdle(uint32_t us);
+    /*
+    Sends the next queued command and collects responses as CTS comes back, never waits for CTS
+    Called by update(), queueCommand(), and the bus
+    */
+    void pollCommands();
+    /*
+    Sends a queued command, it must be the oldest one in the queue
+    - cmd : the command
+    */
+    void sendQueued(Si4463Command *cmd);
+    /*
+    Checks CTS once for the command waiting for it and reads its response if it is ready, or fails it after CTS_TIMEOUT
+    - cmd : the command, must be the oldest one in the queue
+    Returns: whether the command is done
+    */
+    bool finishQueued(Si4463Command *cmd);
+    /*
+    Fails every queued command, used when the radio is shut down
+    */
+    void cancelCommands();
+    /*
+    Queues one of the radio's own commands, waiting for room if the queue is full of user commands
+    Does nothing if the command is already queued
+    - cmd : the command
+    */
+    void queueInternal(Si4463Command &cmd);
+    /*
+    Queues one of the radio's own commands if it isn't already, and checks if its response has come back
+    - cmd : the command
+    Returns: true once, when the response is ready to be used
+    */
+    bool pollInternal(Si4463Command &cmd);
+    /*
+    Forgets responses from a packet that was abandoned so they aren't used for the next one
+    */
+    void resetRXCommands();
 
     // abstractions of low level SPI operations
     /*
+    Begins an SPI transaction and pulls CS low
+    */
+    void select();
+    /*
+    Pulls CS high and ends the SPI transaction
+    */
+    void deselect();
+    /*
+    Same as select(), but first waits for any command the interrupt sent to finish, used before sending a command
+    */
+    void selectCmd();
+    /*
+    Writes bytes from ```buf``` into the TX FIFO, starting at ```xfrd``` and stopping at ```availLen```
+    - count : the maximum number of message bytes to write
+    - sendLength : whether to write the 2 byte length field before the message bytes
+    */
+    void writeTXFIFO(uint8_t count, bool sendLength = false);
+    /*
+    Reads bytes from the RX FIFO into ```buf```, reading the 2 byte length field first if this is the start of a packet
+    - count : the maximum number of bytes to read, including the length field
+    Returns: false if the length field was invalid
+    */
+    bool readRXFIFO(uint8_t count);
+    /*
+    Gets the next contiguous bytes to send, from ```buf``` or the current segment
+    - n : the number of bytes wanted, updated with the number available contiguously
+    Returns: a pointer to the next byte to send
+    */
+    const uint8_t *txSource(uint16_t &n);
+    /*
+    Marks bytes as sent, advancing ```xfrd``` and the segment position
+    - n : the number of bytes sent
+    */
+    void advanceTX(uint16_t n);
+    /*
+    Clears the TX FIFO, writes the length and first part of the message, and starts transmitting
+    Returns: whether a transmission was successfully started
+    */
+    bool beginTX();
+    /*
+    Resets the transmit state once the whole message is in the FIFO and calls the completion callback
+    */
+    void completeTX();
+    /*
+    Moves a stream along, called from handleTX() or update()
+    - room : whether the TX FIFO has room for txThresh more bytes
+    - sent : whether the frame being sent has finished
+    Returns: whether anything was written to the FIFO
+    */
+    bool serviceStream(bool room, bool sent);
+    /*
+    Used to get the number of bytes waiting in the stream's ring buffer
+    Returns: the number of bytes added but not yet written to the FIFO
+    */
+    uint16_t streamBuffered();
+    /*
+    Sets up the next stream frame from the bytes in the ring buffer
+    Returns: whether a frame was opened (false if the ring buffer is empty)
+    */
+    bool openFrame();
+    /*
+    Tops up the FIFO with the frame being written and starts sending it, nothing else can be in the FIFO
+    */
+    void startFrame();
+    /*
+    Returns the radio to ready once the last stream frame has been sent
+    */
+    void finishStream();
+    /*
+    Checks if the whole message has been read from the RX FIFO and marks it available
+    */
+    void completeRX();
+    /*
+    Queues the completed packet and gets ready for the next packet
+    */
+    void queuePacket();
+    /*
+    Allocates ```buf``` if it hasn't been allocated or set with setBuffer()
+    Returns: whether buf can be used
+    */
+    bool allocBuf();
+    /*
+    Used to get where the packet being received is read to, its RX queue slot or ```buf```
+    Returns: the start of the packet, nullptr if it doesn't fit and its bytes are dropped
+    */
+    uint8_t *rxDest();
+#if defined(__IMXRT1062__)
+    /*
+    Starts a DMA transfer of message bytes, the radio must already be selected
+    - txBuf : the bytes to send, or nullptr to send zeros
+    - rxBuf : where to store the received bytes, or nullptr to discard them
+    - n : the number of bytes
+    - rx : whether this is a read from the RX FIFO
+    */
+    void startAsync(const uint8_t *txBuf, uint8_t *rxBuf, uint16_t n, bool rx);
+    /*
+    Called once a DMA transfer finishes, deselects the radio and updates the transfer state
+    - event : the EventResponder holding a pointer to the radio
+    */
+    static void asyncComplete(EventResponderRef event);
+#endif
+    /*
+    Enables the packet handler interrupts and attaches the nIRQ pin interrupt
+    Returns: whether the interrupt was successfully attached
+    */
+    bool attachIRQ();
+    /*
+    Clears the packet handler interrupts seen by serviceIRQ() with GET_PH_STATUS, without reading the response
+    - pend : the pending interrupts to clear
+    Returns: false if a command's response is still waiting to be read, then the main loop has to try again
+    */
+    bool clearIRQ(uint8_t pend);
+    /*
+    Services the radio from the main loop when the interrupt couldn't, see irqPending
+    */
+    void retryIRQ();
+    /*
+    Handles the packet events the interrupt left for update(), see irqEvents
+    */
+    void finishIRQ();
+    /*
+    Interrupt service routines for each IRQ slot
+    */
+    static void isr0();
+    static void isr1();
+    static void isr2();
+    static void isr3();
+    /*
     Performs an spi write operation, writing a register or command followed by arguments
     - reg : the first byte of the operation, usually a register or command
     - argc : the number of arguments
@@ -518,6 +1313,45 @@ private:
     Applies the config from WDS from a header file generated by compileHeaders.py
     */
     void applyWDSConfig(bool applyDefault = true);
+    /*
+    Adds a property to the current batch, replacing its value if it is already staged
+    - group : the property group
+    - prop : the property index
+    - value : the value to set the property to
+    */
+    void stageProperty(uint8_t group, uint8_t prop, uint8_t value);
+    /*
+    Looks up a property in the current batch
+    - group : the property group
+    - prop : the property index
+    - value : updated with the staged value if found
+    Returns: whether the property is staged
+    */
+    bool findStaged(uint8_t group, uint8_t prop, uint8_t &value);
+    /*
+    Records a property value sent to the radio so switchProfile() can skip properties that are already set
+    - group : the property group
+    - prop : the property index
+    - value : the value the property was set to
+    */
+    void shadowProperty(uint8_t group, uint8_t prop, uint8_t value);
+    /*
+    Reads the value of every property set by a profile from the radio, overlaid with anything staged, into profileBase
+    Called by begin() before the configuration is applied, so the values are the power on defaults or begin()'s global settings
+    */
+    void recordProfileBase();
+    /*
+    Looks up a profile in the bank
+    - name : the name of the profile
+    Returns: the profile, or nullptr if it doesn't exist
+    */
+    Si4463Profile *findProfile(const char *name);
+    /*
+    Sends a WDS style configuration array, staging SET_PROPERTY commands if batching
+    - config : the configuration array
+    - length : the length of the configuration array
+    */
+    void applyConfigArray(const uint8_t *config, uint32_t length);
 };
 
 #endif
\ No newline at end of file
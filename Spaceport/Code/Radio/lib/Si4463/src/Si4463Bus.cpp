@@ -0,0 +1,76 @@
+#include "Si4463Bus.h"
+#include "Si4463.h"
+
+Si4463Bus::Si4463Bus(SPIClass *spi)
+{
+    this->spi = spi;
+}
+
+bool Si4463Bus::add(Si4463 *radio)
+{
+    if (this->numRadios >= Si4463Bus::MAX_RADIOS)
+    {
+        Serial.println("ERROR: too many radios on the bus");
+        return false;
+    }
+    if (radio->spi != this->spi)
+    {
+        Serial.println("ERROR: radio does not use this SPI bus");
+        return false;
+    }
+    radio->bus = this;
+    this->radios[this->numRadios++] = radio;
+    return true;
+}
+
+bool Si4463Bus::begin()
+{
+    bool success = true;
+    for (int i = 0; i < this->numRadios; i++)
+    {
+        if (!this->radios[i]->begin())
+        {
+            Serial.print("ERROR: radio ");
+            Serial.print(i);
+            Serial.println(" on the bus failed to begin");
+            success = false;
+        }
+    }
+    return success;
+}
+
+void Si4463Bus::update()
+{
+    for (int i = 0; i < this->numRadios; i++)
+        this->radios[i]->update();
+}
+
+bool Si4463Bus::idle(Si4463 *waiting)
+{
+    // a radio being serviced may need to wait for CTS itself, don't recurse
+    if (this->servicing)
+        return false;
+
+    this->servicing = true;
+    bool serviced = false;
+    for (int i = 0; i < this->numRadios; i++)
+    {
+        Si4463 *radio = this->radios[i];
+        if (radio == waiting)
+            continue;
+        // queued commands can go out while the bus is free
+        if (radio->cmdHead != radio->cmdTail)
+        {
+            radio->pollCommands();
+            serviced = true;
+        }
+        // only radios that are actively moving data need servicing
+        if (radio->state == STATE_TX || radio->state == STATE_RX)
+        {
+            radio->serviceFIFOs();
+            serviced = true;
+        }
+    }
+    this->servicing = false;
+    return serviced;
+}
@@ -0,0 +1,57 @@
+#ifndef SI4463_BUS_H
+#define SI4463_BUS_H
+
+#include <Arduino.h>
+#include "SPI.h"
+
+class Si4463;
+
+/*
+Shares one SPI bus between several Si4463 radios
+While one radio waits for CTS the bus is free, so the bus uses that time to service the FIFOs of the other radios.
+Configuration traffic therefore never starves the FIFOs of a radio that is sending or receiving.
+*/
+class Si4463Bus
+{
+public:
+    // maximum number of radios on one bus
+    static const uint8_t MAX_RADIOS = 4;
+
+    /*
+    Si4463Bus constructor
+    - spi : the SPI bus shared by the radios
+    */
+    Si4463Bus(SPIClass *spi);
+    /*
+    Adds a radio to the bus, must be called before the radio's begin()
+    - radio : the radio to add, must use the same SPI bus
+    Returns: whether the radio was added
+    */
+    bool add(Si4463 *radio);
+    /*
+    Calls begin() on every radio in the order they were added, radios that have already started are serviced while later ones are configured
+    Returns: whether every radio began successfully
+    */
+    bool begin();
+    /*
+    Calls update() on every radio, can be used instead of calling each radio's update()
+    */
+    void update();
+    /*
+    Services the FIFOs and queued commands of every radio except the waiting one, called by radios while they wait for CTS
+    - waiting : the radio that is waiting
+    Returns: whether any radio was serviced
+    */
+    bool idle(Si4463 *waiting);
+
+private:
+    SPIClass *spi;
+    // radios on the bus
+    Si4463 *radios[Si4463Bus::MAX_RADIOS] = {nullptr};
+    // number of radios on the bus
+    uint8_t numRadios = 0;
+    // prevents servicing other radios from inside a radio that is already being serviced
+    bool servicing = false;
+};
+
+#endif
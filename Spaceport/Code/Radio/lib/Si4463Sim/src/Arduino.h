@@ -0,0 +1,91 @@
+#ifndef SI4463SIM_ARDUINO_H
+#define SI4463SIM_ARDUINO_H
+
+// Minimal Arduino API for building the Si4463 driver on a host machine (PlatformIO native platform)
+// Time is simulated, see Si4463Sim.h for how each call advances the clock
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef uint8_t byte;
+
+// time
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// pins
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// interrupts
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+/*
+Serial port shim, output goes to stdout and there is never any input
+*/
+class HardwareSerial
+{
+public:
+    void begin(uint32_t baud);
+    void end();
+    int available();
+    int read();
+    int peek();
+    void flush();
+    size_t write(uint8_t b);
+    size_t write(const uint8_t *buf, size_t len);
+
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    size_t println(const char *str);
+    size_t println(char c);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+
+    operator bool() { return true; }
+
+private:
+    size_t printNumber(unsigned long n, int base);
+};
+
+extern HardwareSerial Serial;
+
+#endif
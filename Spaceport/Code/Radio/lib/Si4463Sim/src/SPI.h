@@ -0,0 +1,59 @@
+#ifndef SI4463SIM_SPI_H
+#define SI4463SIM_SPI_H
+
+// Minimal SPI API for building the Si4463 driver on a host machine (PlatformIO native platform)
+// Bytes are routed to whichever simulated chip on this bus has CS low, see Si4463Sim.h
+
+#include "Arduino.h"
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+/*
+SPI transaction settings, only the clock is used (to time transfers)
+*/
+class SPISettings
+{
+public:
+    SPISettings() {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock) {}
+
+    uint32_t clock = 4000000;
+};
+
+class SPIClass
+{
+public:
+    void begin();
+    void end();
+    /*
+    Starts a transaction, interrupts registered with usingInterrupt() are held off until endTransaction()
+    */
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+    uint8_t transfer(uint8_t data);
+    void transfer(void *buf, size_t count);
+    void transfer(const void *txBuf, void *rxBuf, size_t count);
+    void usingInterrupt(uint8_t interrupt);
+    void notUsingInterrupt(uint8_t interrupt);
+
+    // the clock of the current transaction
+    uint32_t clock = 4000000;
+    // whether a transaction is in progress
+    bool inTransaction = false;
+
+private:
+    // whether usingInterrupt() was called
+    bool usingIRQ = false;
+};
+
+extern SPIClass SPI;
+extern SPIClass SPI1;
+extern SPIClass SPI2;
+
+#endif
@@ -0,0 +1,835 @@
+#include "Si4463Sim.h"
+
+uint32_t Si4463Sim::gpioTime = 20;
+uint32_t Si4463Sim::clockTime = 20;
+uint32_t Si4463Sim::yieldTime = 100;
+uint32_t Si4463Sim::stepTime = 1000;
+
+uint64_t Si4463Sim::time = 0;
+Si4463Sim *Si4463Sim::chips[Si4463Sim::MAX_CHIPS] = {nullptr};
+void (*Si4463Sim::isrs[256])() = {nullptr};
+bool Si4463Sim::isrPending[256] = {false};
+bool Si4463Sim::anyPending = false;
+bool Si4463Sim::interruptsEnabled = true;
+bool Si4463Sim::interruptsHeld = false;
+bool Si4463Sim::inISR = false;
+
+// Si4463SimChannel
+
+Si4463SimChannel::Si4463SimChannel(uint32_t seed)
+{
+    // xorshift gets stuck at 0
+    this->seed = seed == 0 ? 1 : seed;
+}
+
+bool Si4463SimChannel::add(Si4463Sim *radio)
+{
+    if (this->numRadios >= Si4463SimChannel::MAX_RADIOS)
+        return false;
+    this->radios[this->numRadios++] = radio;
+    return true;
+}
+
+void Si4463SimChannel::remove(Si4463Sim *radio)
+{
+    for (int i = 0; i < this->numRadios; i++)
+    {
+        if (this->radios[i] == radio)
+        {
+            this->radios[i] = this->radios[--this->numRadios];
+            return;
+        }
+    }
+}
+
+void Si4463SimChannel::startPacket(Si4463Sim *from)
+{
+    // the length field is at the front of the transmitter's FIFO, used to pick which byte to corrupt
+    uint16_t len = 2;
+    if (from->txCount >= 2)
+        len += (from->txFIFO[from->txHead] << 8) | from->txFIFO[(from->txHead + 1) % from->fifoSize()];
+
+    for (int i = 0; i < this->numRadios; i++)
+    {
+        Si4463Sim *to = this->radios[i];
+        if (to == from || !to->sameTuning(from))
+            continue;
+        // each receiver loses or corrupts packets independently
+        if (this->random() < this->lossRate)
+            continue;
+        uint16_t corruptAt = 0xFFFF;
+        if (this->random() < this->errorRate)
+            corruptAt = (uint16_t)(this->random() * len) % len;
+        to->rxStart(from, corruptAt, this->rssi, this->afc);
+    }
+}
+
+void Si4463SimChannel::packetByte(Si4463Sim *from, uint8_t b)
+{
+    for (int i = 0; i < this->numRadios; i++)
+        if (this->radios[i] != from)
+            this->radios[i]->rxByte(from, b);
+}
+
+void Si4463SimChannel::endPacket(Si4463Sim *from, bool complete)
+{
+    for (int i = 0; i < this->numRadios; i++)
+        if (this->radios[i] != from)
+            this->radios[i]->rxEnd(from, complete);
+}
+
+float Si4463SimChannel::random()
+{
+    this->seed ^= this->seed << 13;
+    this->seed ^= this->seed >> 17;
+    this->seed ^= this->seed << 5;
+    return (this->seed >> 8) / (float)(1 << 24);
+}
+
+// Si4463Sim
+
+Si4463Sim::Si4463Sim(Si4463SimChannel *channel, SPIClass *spi, uint8_t cs, uint8_t sdn, uint8_t irq, uint8_t gpio0, uint8_t gpio1, uint8_t gpio2, uint8_t gpio3)
+{
+    this->channel = channel;
+    this->spi = spi;
+    this->_cs = cs;
+    this->_sdn = sdn;
+    this->_irq = irq;
+    this->_gpio[0] = gpio0;
+    this->_gpio[1] = gpio1;
+    this->_gpio[2] = gpio2;
+    this->_gpio[3] = gpio3;
+
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS; i++)
+    {
+        if (chips[i] == nullptr)
+        {
+            chips[i] = this;
+            break;
+        }
+    }
+    if (this->channel != nullptr)
+        this->channel->add(this);
+    this->reset();
+}
+
+Si4463Sim::~Si4463Sim()
+{
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS; i++)
+        if (chips[i] == this)
+            chips[i] = nullptr;
+    if (this->channel != nullptr)
+        this->channel->remove(this);
+}
+
+uint64_t Si4463Sim::now()
+{
+    return Si4463Sim::time;
+}
+
+void Si4463Sim::advance(uint64_t ns)
+{
+    // a long delay is split up so the chips and interrupts run as it goes, like they would in real time
+    while (ns > Si4463Sim::stepTime)
+    {
+        Si4463Sim::advance(Si4463Sim::stepTime);
+        ns -= Si4463Sim::stepTime;
+    }
+    Si4463Sim::time += ns;
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS; i++)
+    {
+        Si4463Sim *chip = chips[i];
+        if (chip == nullptr)
+            continue;
+        chip->step();
+        // nIRQ interrupts are edge triggered
+        int level = chip->pinLevel(chip->pinModes[4]);
+        if (chip->lastIRQ == HIGH && level == LOW && isrs[chip->_irq] != nullptr)
+        {
+            isrPending[chip->_irq] = true;
+            Si4463Sim::anyPending = true;
+        }
+        chip->lastIRQ = level;
+    }
+
+    // run pending interrupts, unless they are masked or one is already running
+    if (!Si4463Sim::anyPending || !Si4463Sim::interruptsEnabled || Si4463Sim::interruptsHeld || Si4463Sim::inISR)
+        return;
+    Si4463Sim::anyPending = false;
+    for (int pin = 0; pin < 256; pin++)
+    {
+        if (isrPending[pin])
+        {
+            isrPending[pin] = false;
+            Si4463Sim::inISR = true;
+            isrs[pin]();
+            Si4463Sim::inISR = false;
+        }
+    }
+}
+
+bool Si4463Sim::readPin(uint8_t pin, int &level)
+{
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS; i++)
+    {
+        Si4463Sim *chip = chips[i];
+        if (chip == nullptr)
+            continue;
+        for (int j = 0; j < 4; j++)
+        {
+            if (chip->_gpio[j] == pin)
+            {
+                level = chip->pinLevel(chip->pinModes[j]);
+                return true;
+            }
+        }
+        if (chip->_irq == pin)
+        {
+            level = chip->pinLevel(chip->pinModes[4]);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Si4463Sim::writePin(uint8_t pin, int level)
+{
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS; i++)
+    {
+        Si4463Sim *chip = chips[i];
+        if (chip == nullptr)
+            continue;
+        if (chip->_sdn == pin)
+        {
+            if (level == HIGH)
+            {
+                chip->powered = false;
+            }
+            else if (!chip->powered)
+            {
+                // power on reset
+                chip->reset();
+                chip->powered = true;
+                chip->readyAt = Si4463Sim::time + chip->porTime;
+                chip->ctsAt = chip->readyAt;
+            }
+        }
+        if (chip->_cs == pin)
+        {
+            if (level == LOW && !chip->selected)
+            {
+                chip->selected = true;
+                chip->cmdLen = 0;
+                chip->ctsSent = false;
+            }
+            else if (level == HIGH && chip->selected)
+            {
+                chip->selected = false;
+                chip->execute();
+            }
+        }
+    }
+}
+
+uint8_t Si4463Sim::transfer(SPIClass *spi, uint8_t out)
+{
+    Si4463Sim *chip = nullptr;
+    for (int i = 0; i < Si4463Sim::MAX_CHIPS && chip == nullptr; i++)
+        if (chips[i] != nullptr && chips[i]->spi == spi && chips[i]->selected && chips[i]->powered)
+            chip = chips[i];
+    // nothing driving MISO
+    if (chip == nullptr)
+        return 0x00;
+
+    // first byte is the command
+    if (chip->cmdLen == 0)
+    {
+        chip->cmdBuf[chip->cmdLen++] = out;
+        return 0x00;
+    }
+
+    uint8_t cmd = chip->cmdBuf[0];
+    if (chip->cmdLen < sizeof(chip->cmdBuf))
+        chip->cmdLen++;
+    switch (cmd)
+    {
+    case C_READ_CMD_BUFF:
+        // CTS byte, then the response to the last command
+        if (!chip->ctsSent)
+        {
+            if (!chip->ctsReady())
+                return 0x00;
+            chip->ctsSent = true;
+            chip->respPos = 0;
+            return 0xFF;
+        }
+        return chip->respPos < sizeof(chip->resp) ? chip->resp[chip->respPos++] : 0x00;
+    case C_FRR_A_READ:
+    case C_FRR_B_READ:
+    case C_FRR_C_READ:
+    case C_FRR_D_READ:
+    {
+        // reads continue on to the following FRRs
+        uint8_t start = cmd == C_FRR_A_READ ? 0 : cmd == C_FRR_B_READ ? 1 : cmd == C_FRR_C_READ ? 2 : 3;
+        return chip->frr((start + chip->cmdLen - 2) % 4);
+    }
+    case C_WRITE_TX_FIFO:
+        if (chip->txCount >= chip->fifoSize())
+        {
+            chip->chipPend |= CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR;
+            chip->overflows++;
+        }
+        else
+        {
+            chip->txFIFO[(chip->txHead + chip->txCount) % chip->fifoSize()] = out;
+            chip->txCount++;
+            chip->updateThresholds();
+        }
+        return 0x00;
+    case C_READ_RX_FIFO:
+    {
+        if (chip->rxCount == 0)
+        {
+            chip->chipPend |= CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR;
+            chip->underflows++;
+            return 0x00;
+        }
+        uint8_t b = chip->rxFIFO[chip->rxHead];
+        chip->rxHead = (chip->rxHead + 1) % chip->fifoSize();
+        chip->rxCount--;
+        chip->updateThresholds();
+        return b;
+    }
+    default:
+        // argument, the command runs once CS goes high
+        chip->cmdBuf[chip->cmdLen - 1] = out;
+        return 0x00;
+    }
+}
+
+void Si4463Sim::attachISR(uint8_t pin, void (*isr)())
+{
+    isrs[pin] = isr;
+    isrPending[pin] = false;
+}
+
+void Si4463Sim::setInterrupts(bool enabled)
+{
+    Si4463Sim::interruptsEnabled = enabled;
+}
+
+void Si4463Sim::holdInterrupts(bool hold)
+{
+    Si4463Sim::interruptsHeld = hold;
+}
+
+void Si4463Sim::reset()
+{
+    memset(this->props, 0, sizeof(this->props));
+    // defaults from the API reference for the properties the simulation uses
+    this->props[G_GLOBAL][P_GLOBAL_CONFIG] = 0x20;
+    this->props[G_INT_CTL][P_INT_CTL_ENABLE] = 0x04;
+    this->props[G_INT_CTL][P_INT_CTL_CHIP_ENABLE] = 0x04;
+    this->props[G_FRR_CTL][P_FRR_CTL_A_MODE] = FRR_INT_STATUS;
+    this->props[G_FRR_CTL][P_FRR_CTL_B_MODE] = FRR_INT_PEND;
+    this->props[G_FRR_CTL][P_FRR_CTL_C_MODE] = FRR_CURRENT_STATE;
+    this->props[G_FRR_CTL][P_FRR_CTL_D_MODE] = FRR_DISABLED;
+    this->props[G_PREAMBLE][P_PREAMBLE_TX_LENGTH] = 0x08;
+    this->props[G_PREAMBLE][P_PREAMBLE_CONFIG] = 0x21;
+    this->props[G_SYNC][P_SYNC_CONFIG] = 0x01;
+    this->props[G_PKT][P_PKT_TX_THRESHOLD] = 0x30;
+    this->props[G_PKT][P_PKT_RX_THRESHOLD] = 0x30;
+    this->props[G_MODEM][P_MODEM_MOD_TYPE] = 0x02;
+    this->props[G_MODEM][P_MODEM_DATA_RATE3] = 0x0F;
+    this->props[G_MODEM][P_MODEM_DATA_RATE3 + 1] = 0x42;
+    this->props[G_MODEM][P_MODEM_DATA_RATE3 + 2] = 0x40;
+
+    // GPIO 1 is CTS after power on, like the real chip
+    this->pinModes[0] = PIN_DRIVE0;
+    this->pinModes[1] = PIN_CTS;
+    this->pinModes[2] = PIN_DRIVE0;
+    this->pinModes[3] = PIN_DRIVE0;
+    this->pinModes[4] = PIN_NIRQ;
+    this->lastIRQ = HIGH;
+
+    this->cmdLen = 0;
+    memset(this->resp, 0, sizeof(this->resp));
+    this->txHead = 0;
+    this->txCount = 0;
+    this->rxHead = 0;
+    this->rxCount = 0;
+    this->state = 3;
+    this->channelNum = 0;
+    this->txTuned = false;
+    this->txEndAt = 0;
+    this->rxFrom = nullptr;
+    this->phPend = 0;
+    this->modemPend = 0;
+    // CHIP_READY is pending after power on
+    this->chipPend = CHIP_READY;
+    this->lastTXAlmostEmpty = false;
+    this->lastRXAlmostFull = false;
+}
+
+void Si4463Sim::step()
+{
+    if (!this->powered)
+        return;
+
+    // finish tuning
+    if (this->state == 5 && Si4463Sim::time >= this->tuneEnd)
+    {
+        this->state = 7;
+        this->txSent = 0;
+        this->txTotal = 0;
+        this->txEndAt = 0;
+        // preamble and sync word go out before the first byte from the FIFO
+        this->txNextAt = this->tuneEnd + (uint64_t)(this->overheadBytes() + 1) * this->bytePeriod();
+    }
+    if (this->state == 6 && Si4463Sim::time >= this->tuneEnd)
+        this->state = 8;
+
+    // send every byte due by now
+    while (this->state == 7 && this->txEndAt == 0 && this->txNextAt <= Si4463Sim::time)
+    {
+        if (this->txCount == 0)
+        {
+            // the driver didn't keep up, the packet is cut short
+            this->chipPend |= CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR;
+            this->underflows++;
+            if (this->txSent > 0)
+                this->channel->endPacket(this, false);
+            this->enterState(this->txDoneState);
+            break;
+        }
+        if (this->txSent == 0)
+            this->channel->startPacket(this);
+
+        uint8_t b = this->txFIFO[this->txHead];
+        this->txHead = (this->txHead + 1) % this->fifoSize();
+        this->txCount--;
+        this->channel->packetByte(this, b);
+        this->txSent++;
+
+        // 2 byte length field, then the payload
+        if (this->txSent == 1)
+            this->txLenHigh = b;
+        else if (this->txSent == 2)
+            this->txTotal = 2 + ((this->txLenHigh << 8) | b);
+        if (this->txTotal > 0 && this->txSent == this->txTotal)
+            this->txEndAt = this->txNextAt + (uint64_t)this->crcBytes() * this->bytePeriod();
+        this->txNextAt += this->bytePeriod();
+    }
+    if (this->state == 7 && this->txEndAt != 0 && Si4463Sim::time >= this->txEndAt)
+    {
+        this->txEndAt = 0;
+        this->txPackets++;
+        this->phPend |= PH_PACKET_SENT;
+        this->channel->endPacket(this, true);
+        this->enterState(this->txDoneState);
+    }
+
+    this->updateThresholds();
+}
+
+void Si4463Sim::updateThresholds()
+{
+    // the threshold interrupts are raised when the condition becomes true
+    bool txAlmostEmpty = this->fifoSize() - this->txCount >= this->props[G_PKT][P_PKT_TX_THRESHOLD];
+    bool rxAlmostFull = this->rxCount > 0 && this->rxCount >= this->props[G_PKT][P_PKT_RX_THRESHOLD];
+    if (txAlmostEmpty && !this->lastTXAlmostEmpty)
+        this->phPend |= PH_TX_FIFO_ALMOST_EMPTY;
+    if (rxAlmostFull && !this->lastRXAlmostFull)
+        this->phPend |= PH_RX_FIFO_ALMOST_FULL;
+    this->lastTXAlmostEmpty = txAlmostEmpty;
+    this->lastRXAlmostFull = rxAlmostFull;
+}
+
+void Si4463Sim::execute()
+{
+    uint8_t cmd = this->cmdBuf[0];
+    // these don't use the command buffer
+    if (this->cmdLen == 0 || cmd == C_READ_CMD_BUFF || cmd == C_WRITE_TX_FIFO || cmd == C_READ_RX_FIFO ||
+        cmd == C_FRR_A_READ || cmd == C_FRR_B_READ || cmd == C_FRR_C_READ || cmd == C_FRR_D_READ)
+        return;
+
+    // the real chip ignores commands sent before CTS
+    if (!this->ctsReady())
+    {
+        this->cmdErrors++;
+        this->chipPend |= CHIP_CMD_ERROR;
+        return;
+    }
+    this->ctsAt = Si4463Sim::time + (cmd == C_POWER_UP ? this->powerUpTime : this->cmdTime);
+    memset(this->resp, 0, sizeof(this->resp));
+
+    uint8_t *args = this->cmdBuf + 1;
+    uint8_t argc = this->cmdLen - 1;
+    switch (cmd)
+    {
+    case C_PART_INFO:
+        this->resp[0] = 0x11; // chip revision
+        this->resp[1] = Si4463Sim::PART_NO >> 8;
+        this->resp[2] = Si4463Sim::PART_NO & 0xFF;
+        break;
+    case C_SET_PROPERTY:
+        for (int i = 0; i < args[1] && 3 + i < argc; i++)
+            this->props[args[0]][(uint8_t)(args[2] + i)] = args[3 + i];
+        this->updateThresholds();
+        break;
+    case C_GET_PROPERTY:
+        for (int i = 0; i < args[1] && i < (int)sizeof(this->resp); i++)
+            this->resp[i] = this->props[args[0]][(uint8_t)(args[2] + i)];
+        break;
+    case C_GPIO_PIN_CFG:
+        // DO_NOTHING keeps the current mode
+        for (int i = 0; i < 5 && i < argc; i++)
+            if ((args[i] & 0x3F) != PIN_DO_NOTHING)
+                this->pinModes[i] = args[i] & 0x3F;
+        for (int i = 0; i < 5; i++)
+            this->resp[i] = this->pinModes[i];
+        break;
+    case C_FIFO_INFO:
+        if (argc > 0 && (args[0] & 0b10))
+        {
+            this->rxHead = 0;
+            this->rxCount = 0;
+        }
+        if (argc > 0 && (args[0] & 0b01))
+        {
+            this->txHead = 0;
+            this->txCount = 0;
+        }
+        this->updateThresholds();
+        this->resp[0] = this->rxCount;
+        this->resp[1] = this->fifoSize() - this->txCount;
+        break;
+    case C_GET_INT_STATUS:
+        this->resp[0] = this->intPend();
+        this->resp[1] = this->intPend();
+        this->resp[2] = this->phPend;
+        this->resp[3] = this->phStatus();
+        this->resp[4] = this->modemPend;
+        this->resp[5] = this->modemPend;
+        this->resp[6] = this->chipPend;
+        this->resp[7] = this->chipPend;
+        // a 0 bit clears the interrupt, no arguments clears everything
+        this->phPend &= argc > 0 ? args[0] : 0;
+        this->modemPend &= argc > 1 ? args[1] : 0;
+        this->chipPend &= argc > 2 ? args[2] : 0;
+        break;
+    case C_GET_PH_STATUS:
+        this->resp[0] = this->phPend;
+        this->resp[1] = this->phStatus();
+        this->phPend &= argc > 0 ? args[0] : 0;
+        break;
+    case C_GET_MODEM_STATUS:
+        this->resp[0] = this->modemPend;
+        this->resp[1] = this->modemPend;
+        this->resp[2] = this->latchedRSSI;
+        this->resp[3] = this->latchedRSSI;
+        this->resp[6] = (uint16_t)this->latchedAFC >> 8;
+        this->resp[7] = (uint16_t)this->latchedAFC & 0xFF;
+        this->modemPend &= argc > 0 ? args[0] : 0;
+        break;
+    case C_GET_CHIP_STATUS:
+        this->resp[0] = this->chipPend;
+        this->resp[1] = this->chipPend;
+        this->chipPend &= argc > 0 ? args[0] : 0;
+        break;
+    case C_REQUEST_DEVICE_STATE:
+        this->resp[0] = this->state;
+        this->resp[1] = this->channelNum;
+        break;
+    case C_CHANGE_STATE:
+        if (argc > 0)
+            this->enterState(args[0] & 0x0F);
+        break;
+    case C_START_TX:
+    {
+        // channel, condition (TXCOMPLETE_STATE in the top nibble), length, delay, repeats
+        bool tuned = this->txTuned && this->state == 3 && (argc == 0 || args[0] == this->channelNum);
+        this->enterState(3);
+        this->channelNum = argc > 0 ? args[0] : 0;
+        this->txDoneState = argc > 1 ? args[1] >> 4 : 0;
+        this->state = 5;
+        this->tuneEnd = Si4463Sim::time + (tuned ? this->tunedTime : this->tuneTime);
+        break;
+    }
+    case C_START_RX:
+        // channel, condition, length, timeout/valid/invalid states
+        this->enterState(3);
+        this->channelNum = argc > 0 ? args[0] : 0;
+        this->rxValidState = argc > 5 ? args[5] : 0;
+        this->rxInvalidState = argc > 6 ? args[6] : 0;
+        this->state = 6;
+        this->tuneEnd = Si4463Sim::time + this->tuneTime;
+        break;
+    default:
+        // POWER_UP, NOP, IRCAL, etc. only need CTS
+        break;
+    }
+}
+
+void Si4463Sim::enterState(uint8_t next)
+{
+    if (next == 0)
+        return;
+    // stopping in the middle of a packet
+    if (this->state == 7 && this->txSent > 0 && (this->txTotal == 0 || this->txSent < this->txTotal || this->txEndAt != 0))
+        this->channel->endPacket(this, false);
+    this->txEndAt = 0;
+    this->txSent = 0;
+    this->rxFrom = nullptr;
+    this->txTuned = next == 5;
+
+    if (next == 6 || next == 8)
+        this->state = 8; // already tuned, so straight back to searching for a packet
+    else
+        this->state = 3; // everything else is treated as ready
+}
+
+int Si4463Sim::pinLevel(uint8_t mode)
+{
+    if (!this->powered)
+        return LOW;
+    switch (mode)
+    {
+    case PIN_DRIVE1:
+        return HIGH;
+    case PIN_CTS:
+        return this->ctsReady() ? HIGH : LOW;
+    case PIN_INV_CTS:
+        return this->ctsReady() ? LOW : HIGH;
+    case PIN_POR:
+        return Si4463Sim::time >= this->readyAt ? HIGH : LOW;
+    case PIN_TX_STATE:
+        return this->state == 5 || this->state == 7 ? HIGH : LOW;
+    case PIN_RX_STATE:
+        return this->state == 6 || this->state == 8 ? HIGH : LOW;
+    case PIN_TX_FIFO_EMPTY:
+        return this->lastTXAlmostEmpty ? HIGH : LOW;
+    case PIN_RX_FIFO_FULL:
+        return this->lastRXAlmostFull ? HIGH : LOW;
+    case PIN_NIRQ:
+        return this->irqActive() ? LOW : HIGH;
+    default:
+        return LOW;
+    }
+}
+
+uint8_t Si4463Sim::frr(uint8_t index)
+{
+    switch (this->props[G_FRR_CTL][P_FRR_CTL_A_MODE + index])
+    {
+    case FRR_INT_STATUS:
+    case FRR_INT_PEND:
+        return this->intPend();
+    case FRR_INT_PH_STATUS:
+        return this->phStatus();
+    case FRR_INT_PH_PEND:
+        return this->phPend;
+    case FRR_INT_MODEM_STATUS:
+    case FRR_INT_MODEM_PEND:
+        return this->modemPend;
+    case FRR_INT_CHIP_STATUS:
+    case FRR_INT_CHIP_PEND:
+        return this->chipPend;
+    case FRR_CURRENT_STATE:
+        return this->state;
+    case FRR_LATCHED_RSSI:
+        return this->latchedRSSI;
+    default:
+        return 0;
+    }
+}
+
+bool Si4463Sim::irqActive()
+{
+    return this->intPend() != 0;
+}
+
+uint8_t Si4463Sim::intPend()
+{
+    uint8_t enabled = this->props[G_INT_CTL][P_INT_CTL_ENABLE];
+    uint8_t pend = 0;
+    if ((enabled & INT_PH) && (this->phPend & this->props[G_INT_CTL][P_INT_CTL_PH_ENABLE]))
+        pend |= INT_PH;
+    if ((enabled & INT_MODEM) && (this->modemPend & this->props[G_INT_CTL][P_INT_CTL_MODEM_ENABLE]))
+        pend |= INT_MODEM;
+    if ((enabled & INT_CHIP) && (this->chipPend & this->props[G_INT_CTL][P_INT_CTL_CHIP_ENABLE]))
+        pend |= INT_CHIP;
+    return pend;
+}
+
+uint8_t Si4463Sim::phStatus()
+{
+    // the FIFO thresholds are levels, the packet events only show while pending
+    uint8_t status = this->phPend & ~(PH_TX_FIFO_ALMOST_EMPTY | PH_RX_FIFO_ALMOST_FULL);
+    if (this->lastTXAlmostEmpty)
+        status |= PH_TX_FIFO_ALMOST_EMPTY;
+    if (this->lastRXAlmostFull)
+        status |= PH_RX_FIFO_ALMOST_FULL;
+    return status;
+}
+
+bool Si4463Sim::ctsReady()
+{
+    return this->powered && Si4463Sim::time >= this->ctsAt;
+}
+
+uint8_t Si4463Sim::fifoSize()
+{
+    return (this->props[G_GLOBAL][P_GLOBAL_CONFIG] & 0b00010000) ? Si4463Sim::SHARED_SIZE : Si4463Sim::FIFO_SIZE;
+}
+
+uint32_t Si4463Sim::bytePeriod()
+{
+    // MODEM_DATA_RATE through MODEM_TX_NCO_MODE, as written by setModemConfig()
+    uint64_t dr = 0;
+    for (int i = 0; i < 7; i++)
+        dr = (dr << 8) | this->props[G_MODEM][P_MODEM_DATA_RATE3 + i];
+    uint32_t rate = Si4463FreqPlan::symbolRate((Si4463DataRate)dr);
+    if (rate == 0)
+        rate = this->defaultSymbolRate;
+    // 4 level FSK sends 2 bits per symbol
+    uint8_t mod = this->props[G_MODEM][P_MODEM_MOD_TYPE] & 0b111;
+    uint32_t bitsPerSymbol = mod == MOD_4FSK || mod == MOD_4GFSK ? 2 : 1;
+    return (uint32_t)(8000000000ULL / ((uint64_t)rate * bitsPerSymbol));
+}
+
+uint16_t Si4463Sim::overheadBytes()
+{
+    // PREAMBLE_CONFIG.LENGTH_CONFIG selects bytes or nibbles
+    uint16_t preamble = this->props[G_PREAMBLE][P_PREAMBLE_TX_LENGTH];
+    if (!(this->props[G_PREAMBLE][P_PREAMBLE_CONFIG] & 0b00100000))
+        preamble = (preamble + 1) / 2;
+    uint16_t sync = (this->props[G_SYNC][P_SYNC_CONFIG] & 0b11) + 1;
+    return preamble + sync;
+}
+
+uint8_t Si4463Sim::crcBytes()
+{
+    uint8_t poly = this->props[G_PKT][P_PKT_CRC_CONFIG] & 0x0F;
+    if (poly == CRC_NONE || !(this->props[G_PKT][P_PKT_FIELD_2_CRC_CONFIG] & 0b00100000))
+        return 0;
+    if (poly == CRC_ITU_T_8)
+        return 1;
+    if (poly == CRC_KOOPMAN_32 || poly == CRC_IEEE_802_3_32 || poly == CRC_CASTAGNOLI_32)
+        return 4;
+    return 2;
+}
+
+bool Si4463Sim::crcEnabled()
+{
+    return (this->props[G_PKT][P_PKT_CRC_CONFIG] & 0x0F) != CRC_NONE && (this->props[G_PKT][P_PKT_FIELD_2_CRC_CONFIG] & 0b00001000);
+}
+
+bool Si4463Sim::sameTuning(Si4463Sim *other)
+{
+    if (this->channelNum != other->channelNum)
+        return false;
+    if (this->props[G_MODEM][P_MODEM_CLKGEN_BAND] != other->props[G_MODEM][P_MODEM_CLKGEN_BAND] ||
+        this->props[G_MODEM][P_MODEM_MOD_TYPE] != other->props[G_MODEM][P_MODEM_MOD_TYPE])
+        return false;
+    // FREQ_CONTROL_INTE, FRAC, and CHANNEL_STEP_SIZE
+    for (int i = 0; i < 6; i++)
+        if (this->props[G_FREQ_CONTROL][i] != other->props[G_FREQ_CONTROL][i])
+            return false;
+    for (int i = 0; i < 7; i++)
+        if (this->props[G_MODEM][P_MODEM_DATA_RATE3 + i] != other->props[G_MODEM][P_MODEM_DATA_RATE3 + i])
+            return false;
+    return true;
+}
+
+void Si4463Sim::rxStart(Si4463Sim *from, uint16_t corruptAt, int rssi, int16_t afc)
+{
+    // only one packet can be received at a time
+    if (this->state != 8 || this->rxFrom != nullptr)
+        return;
+    this->rxFrom = from;
+    this->rxGot = 0;
+    this->rxTotal = 0;
+    this->rxCorruptAt = corruptAt;
+    this->rxCorrupted = false;
+    // RSSI is latched at the sync word, in the same units as the RSSI properties
+    int latched = (rssi + 134) * 2;
+    this->latchedRSSI = latched < 0 ? 0 : latched > 255 ? 255 : latched;
+    this->latchedAFC = afc;
+}
+
+void Si4463Sim::rxByte(Si4463Sim *from, uint8_t b)
+{
+    if (this->rxFrom != from || this->state != 8)
+        return;
+    if (this->rxGot == this->rxCorruptAt)
+    {
+        b ^= 0b00010000;
+        this->rxCorrupted = true;
+    }
+
+    if (this->rxCount >= this->fifoSize())
+    {
+        // the driver didn't keep up, the rest of the packet is lost
+        this->chipPend |= CHIP_FIFO_UNDERFLOW_OVERFLOW_ERROR;
+        this->overflows++;
+        this->rxFrom = nullptr;
+        this->enterState(this->rxInvalidState);
+        return;
+    }
+    this->rxFIFO[(this->rxHead + this->rxCount) % this->fifoSize()] = b;
+    this->rxCount++;
+    this->rxGot++;
+    this->updateThresholds();
+
+    // the length field decides how much more to receive
+    if (this->rxGot == 1)
+    {
+        this->rxLenHigh = b;
+    }
+    else if (this->rxGot == 2)
+    {
+        uint16_t len = (this->rxLenHigh << 8) | b;
+        if (len == 0 || len > 0x1FFF)
+        {
+            this->rxFrom = nullptr;
+            return;
+        }
+        this->rxTotal = 2 + len;
+    }
+    // without a crc the packet ends as soon as the payload is in, otherwise the crc has to be checked first
+    if (this->rxTotal > 0 && this->rxGot == this->rxTotal && !this->crcEnabled())
+        this->rxFinish(true);
+}
+
+void Si4463Sim::rxEnd(Si4463Sim *from, bool complete)
+{
+    if (this->rxFrom != from)
+        return;
+    if (this->crcEnabled())
+    {
+        // a short, long, or corrupted packet fails the crc
+        this->rxFinish(complete && this->rxGot == this->rxTotal && !this->rxCorrupted);
+    }
+    else
+    {
+        // the real chip would wait for bytes that never come, go back to searching instead
+        this->rxFrom = nullptr;
+    }
+}
+
+void Si4463Sim::rxFinish(bool valid)
+{
+    this->rxFrom = nullptr;
+    if (valid)
+    {
+        this->rxPackets++;
+        this->phPend |= PH_PACKET_RX;
+        this->enterState(this->rxValidState);
+    }
+    else
+    {
+        this->phPend |= PH_CRC_ERROR;
+        this->enterState(this->rxInvalidState);
+    }
+}
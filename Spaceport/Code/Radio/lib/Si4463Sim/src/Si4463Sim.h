@@ -0,0 +1,403 @@
+#ifndef SI4463SIM_H
+#define SI4463SIM_H
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Si4463_defs.h"
+#include "Si4463_freq.h"
+
+class Si4463Sim;
+
+/*
+Virtual channel connecting simulated radios, every radio tuned to the same frequency with the same modem settings hears every packet
+Packets can be lost or corrupted at random (repeatably, from a fixed seed)
+*/
+class Si4463SimChannel
+{
+public:
+    // maximum number of radios on a channel
+    static const uint8_t MAX_RADIOS = 8;
+    // probability that a receiver does not hear a packet at all (0-1)
+    float lossRate = 0;
+    // probability that a receiver hears a packet with one bit flipped (0-1)
+    float errorRate = 0;
+    // received signal strength reported by receivers
+    int rssi = -60; // dBm
+    // AFC offset reported by receivers (raw AFC_FREQ_OFFSET)
+    int16_t afc = 0;
+
+    /*
+    Si4463SimChannel constructor
+    - seed : seed for the random loss and corruption
+    */
+    Si4463SimChannel(uint32_t seed = 1);
+
+    /*
+    Adds a radio to the channel, done by the Si4463Sim constructor
+    - radio : the radio
+    Returns: false if there are already MAX_RADIOS radios
+    */
+    bool add(Si4463Sim *radio);
+    /*
+    Removes a radio from the channel, done by the Si4463Sim destructor
+    - radio : the radio
+    */
+    void remove(Si4463Sim *radio);
+
+    // called by a transmitting radio
+    /*
+    Starts a packet, receivers that are listening lock on to it
+    - from : the transmitting radio
+    */
+    void startPacket(Si4463Sim *from);
+    /*
+    Sends the next byte of a packet (length field, then payload)
+    - from : the transmitting radio
+    - b : the byte
+    */
+    void packetByte(Si4463Sim *from, uint8_t b);
+    /*
+    Ends a packet
+    - from : the transmitting radio
+    - complete : false if the transmitter stopped early (TX FIFO underflow)
+    */
+    void endPacket(Si4463Sim *from, bool complete);
+
+private:
+    Si4463Sim *radios[MAX_RADIOS] = {nullptr};
+    uint8_t numRadios = 0;
+    uint32_t seed;
+
+    /*
+    xorshift random number generator
+    Returns: a random number between 0 and 1
+    */
+    float random();
+};
+
+/*
+Simulated Si4463 for running the driver on a host machine
+Models the command buffer and CTS, the TX and RX FIFOs, the FIFO threshold, state and CTS GPIOs, nIRQ, the FRRs, and the
+ready/TX/RX state transitions, with bytes moving over a Si4463SimChannel at the configured data rate
+
+Time is simulated (Si4463Sim::now()) and only moves forward when the driver calls into the Arduino/SPI layer:
+- SPI transfers take 8 bits at the transaction clock
+- delay(), delayMicroseconds() take the time asked for
+- digitalRead(), digitalWrite(), micros(), millis(), yield() take the costs below
+so the code between those calls runs infinitely fast, and a benchmark runs as fast as the host can execute the driver
+*/
+class Si4463Sim
+{
+public:
+    // maximum number of simulated chips
+    static const uint8_t MAX_CHIPS = 8;
+    // size of each FIFO, or of the shared FIFO when GLOBAL_CONFIG.FIFO_MODE is set
+    static const uint8_t FIFO_SIZE = 64;   // bytes
+    static const uint8_t SHARED_SIZE = 129; // bytes
+    // PART_INFO part number
+    static const uint16_t PART_NO = 0x4463;
+
+    // simulated costs of calls into the Arduino layer
+    static uint32_t gpioTime;  // ns per digitalRead/digitalWrite
+    static uint32_t clockTime; // ns per micros/millis
+    static uint32_t yieldTime; // ns per yield
+    // longest step time is moved forward by at once, so interrupts still land on time during long delays
+    static uint32_t stepTime; // ns
+
+    // chip timing
+    // time from SDN low until the chip is ready
+    uint32_t porTime = 1000000; // ns
+    // time from a command until CTS
+    uint32_t cmdTime = 25000; // ns
+    // time from POWER_UP until CTS
+    uint32_t powerUpTime = 6000000; // ns
+    // time to tune the synthesizer before TX or RX
+    uint32_t tuneTime = 60000; // ns
+    // time to start TX from TX_TUNE, the synthesizer is already locked
+    uint32_t tunedTime = 10000; // ns
+    // symbol rate used if the data rate properties don't match a Si4463DataRate
+    uint32_t defaultSymbolRate = 100000; // sps
+
+    // counters for benchmarks
+    // commands sent while CTS was low (ignored, as on the real chip)
+    uint32_t cmdErrors = 0;
+    // packets sent and received, and bytes lost to FIFO underflows/overflows
+    uint32_t txPackets = 0;
+    uint32_t rxPackets = 0;
+    uint32_t underflows = 0;
+    uint32_t overflows = 0;
+
+    /*
+    Si4463Sim constructor, connects a simulated chip to the pins used by a Si4463
+    - channel : the channel to transmit and receive on
+    - spi : the SPI bus the chip is on
+    - cs, sdn, irq, gpio0-3 : the MCU pins the chip is connected to
+    */
+    Si4463Sim(Si4463SimChannel *channel, SPIClass *spi, uint8_t cs, uint8_t sdn, uint8_t irq, uint8_t gpio0, uint8_t gpio1, uint8_t gpio2, uint8_t gpio3);
+    ~Si4463Sim();
+
+    /*
+    Gets a property as the chip holds it, to compare configurations
+    - group : the property group
+    - prop : the property index
+    Returns: the property value
+    */
+    uint8_t property(uint8_t group, uint8_t prop) const { return this->props[group][prop]; }
+
+    // simulation control
+    /*
+    Gets the simulated time
+    Returns: the time since the simulation started in ns
+    */
+    static uint64_t now();
+    /*
+    Moves the simulated time forward, running the chips and any interrupts that become pending
+    - ns : the time to advance by
+    */
+    static void advance(uint64_t ns);
+
+    // hooks for the Arduino/SPI layer
+    /*
+    Gets the level of a pin driven by a simulated chip
+    - pin : the MCU pin
+    - level : updated with the pin level if a chip drives the pin
+    Returns: whether a chip drives the pin
+    */
+    static bool readPin(uint8_t pin, int &level);
+    /*
+    Passes an MCU pin write to the chip connected to it (CS and SDN)
+    - pin : the MCU pin
+    - level : the new level
+    */
+    static void writePin(uint8_t pin, int level);
+    /*
+    Transfers one byte to the chip selected on a bus
+    - spi : the bus
+    - out : the byte sent by the MCU
+    Returns: the byte sent by the chip (0x00 if no chip is selected)
+    */
+    static uint8_t transfer(SPIClass *spi, uint8_t out);
+    /*
+    Attaches an interrupt to a pin, triggered when a chip pulls it low
+    - pin : the MCU pin
+    - isr : the interrupt routine, nullptr to detach
+    */
+    static void attachISR(uint8_t pin, void (*isr)());
+    /*
+    Enables or disables interrupts, like noInterrupts()/interrupts()
+    - enabled : whether interrupts are enabled
+    */
+    static void setInterrupts(bool enabled);
+    /*
+    Holds off interrupts during an SPI transaction, like SPI.usingInterrupt()
+    - hold : whether interrupts are held off
+    */
+    static void holdInterrupts(bool hold);
+
+private:
+    // simulated time
+    static uint64_t time;
+    // all the chips, stepped together
+    static Si4463Sim *chips[MAX_CHIPS];
+    // interrupt routines by pin, and whether they are waiting to run
+    static void (*isrs[256])();
+    static bool isrPending[256];
+    // whether any interrupt is waiting to run
+    static bool anyPending;
+    static bool interruptsEnabled;
+    static bool interruptsHeld;
+    static bool inISR;
+
+    Si4463SimChannel *channel;
+    SPIClass *spi;
+    uint8_t _cs;
+    uint8_t _sdn;
+    uint8_t _irq;
+    uint8_t _gpio[4];
+
+    // power and command state
+    bool powered = false;
+    uint64_t readyAt = 0;
+    bool selected = false;
+    // bytes of the command being clocked in
+    uint8_t cmdBuf[32] = {};
+    uint8_t cmdLen = 0;
+    // response to the last command, read with READ_CMD_BUFF
+    uint8_t resp[16] = {};
+    uint8_t respPos = 0;
+    // when CTS goes high after the last command
+    uint64_t ctsAt = 0;
+    // whether the current transaction has returned CTS (READ_CMD_BUFF)
+    bool ctsSent = false;
+
+    // properties, by group then property
+    uint8_t props[256][256] = {};
+    // GPIO modes, 0-3 then nIRQ
+    uint8_t pinModes[5] = {};
+    // last nIRQ level seen by advance()
+    int lastIRQ = HIGH;
+
+    // FIFOs
+    uint8_t txFIFO[SHARED_SIZE] = {};
+    uint8_t txHead = 0;
+    uint8_t txCount = 0;
+    uint8_t rxFIFO[SHARED_SIZE] = {};
+    uint8_t rxHead = 0;
+    uint8_t rxCount = 0;
+
+    // radio state, uses the CURRENT_STATE/START_RX state codes (3 ready, 5 TX tune, 6 RX tune, 7 TX, 8 RX)
+    uint8_t state = 1;
+    uint8_t channelNum = 0;
+    uint64_t tuneEnd = 0;
+    // whether the synthesizer is still locked for TX (TX_TUNE, reported as ready)
+    bool txTuned = false;
+    // state after TX and after a valid/invalid RX packet
+    uint8_t txDoneState = 3;
+    uint8_t rxValidState = 3;
+    uint8_t rxInvalidState = 8;
+
+    // TX packet state
+    // when the next byte finishes being sent
+    uint64_t txNextAt = 0;
+    uint16_t txSent = 0;
+    uint16_t txTotal = 0;
+    uint8_t txLenHigh = 0;
+    // when the crc finishes being sent, 0 until all the bytes are sent
+    uint64_t txEndAt = 0;
+
+    // RX packet state
+    // the radio whose packet is being received
+    Si4463Sim *rxFrom = nullptr;
+    uint16_t rxGot = 0;
+    uint16_t rxTotal = 0;
+    // the byte that is corrupted, 0xFFFF for none
+    uint16_t rxCorruptAt = 0xFFFF;
+    bool rxCorrupted = false;
+    uint8_t rxLenHigh = 0;
+    uint8_t latchedRSSI = 0;
+    int16_t latchedAFC = 0;
+
+    // interrupts
+    uint8_t phPend = 0;
+    uint8_t modemPend = 0;
+    uint8_t chipPend = 0;
+    bool lastTXAlmostEmpty = false;
+    bool lastRXAlmostFull = false;
+
+    friend class Si4463SimChannel;
+
+    /*
+    Resets the chip to its power on state
+    */
+    void reset();
+    /*
+    Runs the chip up to the simulated time
+    */
+    void step();
+    /*
+    Updates the FIFO threshold interrupts
+    */
+    void updateThresholds();
+    /*
+    Runs a command once CS goes high
+    */
+    void execute();
+    /*
+    Changes state, using the START_RX/START_TX/CHANGE_STATE state codes
+    - next : the state code, 0 to stay in the current state
+    */
+    void enterState(uint8_t next);
+    /*
+    Gets the level of a chip pin from its mode
+    - mode : the GPIO mode
+    Returns: the pin level
+    */
+    int pinLevel(uint8_t mode);
+    /*
+    Gets the value of an FRR from its mode
+    - index : the FRR (0-3)
+    Returns: the FRR value
+    */
+    uint8_t frr(uint8_t index);
+
+    /*
+    Gets whether the nIRQ output is active, any enabled interrupt pending
+    Returns: whether an interrupt is pending
+    */
+    bool irqActive();
+    /*
+    Gets the INT_PEND byte of GET_INT_STATUS
+    Returns: a bit for each interrupt group with enabled interrupts pending
+    */
+    uint8_t intPend();
+    /*
+    Gets the PH_STATUS byte of GET_INT_STATUS/GET_PH_STATUS
+    Returns: the current FIFO threshold levels, plus the pending packet events
+    */
+    uint8_t phStatus();
+    /*
+    Gets whether the chip has finished the last command
+    Returns: whether CTS is high
+    */
+    bool ctsReady();
+    /*
+    Gets the size of the FIFOs, which depends on GLOBAL_CONFIG.FIFO_MODE
+    Returns: the size of each FIFO in bytes
+    */
+    uint8_t fifoSize();
+    /*
+    Gets the time to send one byte from the data rate and modulation properties
+    Returns: the time in ns
+    */
+    uint32_t bytePeriod();
+    /*
+    Gets the number of preamble and sync word bytes sent before each packet
+    Returns: the number of bytes
+    */
+    uint16_t overheadBytes();
+    /*
+    Gets the number of crc bytes sent after each packet
+    Returns: the number of bytes
+    */
+    uint8_t crcBytes();
+    /*
+    Gets whether the receiver checks the crc
+    Returns: whether the crc is checked
+    */
+    bool crcEnabled();
+    /*
+    Checks if another chip uses the same frequency, channel, modulation, and data rate
+    - other : the other chip
+    Returns: whether the chips can hear each other
+    */
+    bool sameTuning(Si4463Sim *other);
+
+    // RX side of the channel
+    /*
+    Locks on to a packet if listening
+    - from : the transmitting chip
+    - corruptAt : index of the byte to corrupt, 0xFFFF for none
+    - rssi : the received signal strength in dBm
+    - afc : the AFC offset
+    */
+    void rxStart(Si4463Sim *from, uint16_t corruptAt, int rssi, int16_t afc);
+    /*
+    Receives a byte of the packet that was locked on to
+    - from : the transmitting chip
+    - b : the byte
+    */
+    void rxByte(Si4463Sim *from, uint8_t b);
+    /*
+    Ends the packet that was locked on to
+    - from : the transmitting chip
+    - complete : false if the transmitter stopped early
+    */
+    void rxEnd(Si4463Sim *from, bool complete);
+    /*
+    Finishes receiving a packet, raising PACKET_RX or CRC_ERROR
+    - valid : whether the packet passed the crc check
+    */
+    void rxFinish(bool valid);
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "Arduino.h"
+#include "SPI.h"
+#include "Si4463Sim.h"
+
+// levels of pins not driven by a simulated chip
+static uint8_t pinLevels[256] = {0};
+
+uint32_t millis()
+{
+    Si4463Sim::advance(Si4463Sim::clockTime);
+    return (uint32_t)(Si4463Sim::now() / 1000000);
+}
+
+uint32_t micros()
+{
+    Si4463Sim::advance(Si4463Sim::clockTime);
+    return (uint32_t)(Si4463Sim::now() / 1000);
+}
+
+void delay(uint32_t ms)
+{
+    Si4463Sim::advance((uint64_t)ms * 1000000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    Si4463Sim::advance((uint64_t)us * 1000);
+}
+
+void yield()
+{
+    Si4463Sim::advance(Si4463Sim::yieldTime);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (mode == INPUT_PULLUP)
+        pinLevels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    Si4463Sim::advance(Si4463Sim::gpioTime);
+    pinLevels[pin] = val;
+    Si4463Sim::writePin(pin, val);
+}
+
+int digitalRead(uint8_t pin)
+{
+    Si4463Sim::advance(Si4463Sim::gpioTime);
+    int level = pinLevels[pin];
+    Si4463Sim::readPin(pin, level);
+    return level;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    return pin;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(), int mode)
+{
+    // only falling edges (nIRQ) are simulated
+    Si4463Sim::attachISR(interrupt, isr);
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    Si4463Sim::attachISR(interrupt, nullptr);
+}
+
+void noInterrupts()
+{
+    Si4463Sim::setInterrupts(false);
+}
+
+void interrupts()
+{
+    Si4463Sim::setInterrupts(true);
+}
+
+// HardwareSerial
+
+void HardwareSerial::begin(uint32_t baud) {}
+void HardwareSerial::end() {}
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+int HardwareSerial::peek() { return -1; }
+void HardwareSerial::flush() { fflush(stdout); }
+
+size_t HardwareSerial::write(uint8_t b)
+{
+    return fputc(b, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len)
+{
+    return fwrite(buf, 1, len, stdout);
+}
+
+size_t HardwareSerial::print(const char *str)
+{
+    return this->write((const uint8_t *)str, strlen(str));
+}
+
+size_t HardwareSerial::print(char c)
+{
+    return this->write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(int n, int base)
+{
+    return this->print((long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned int n, int base)
+{
+    return this->printNumber(n, base);
+}
+
+size_t HardwareSerial::print(long n, int base)
+{
+    if (n < 0 && base == DEC)
+        return this->print('-') + this->printNumber(-(unsigned long)n, base);
+    return this->printNumber((unsigned long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned long n, int base)
+{
+    return this->printNumber(n, base);
+}
+
+size_t HardwareSerial::print(double n, int digits)
+{
+    return printf("%.*f", digits, n);
+}
+
+size_t HardwareSerial::println()
+{
+    return this->print("\r\n");
+}
+
+size_t HardwareSerial::println(const char *str) { return this->print(str) + this->println(); }
+size_t HardwareSerial::println(char c) { return this->print(c) + this->println(); }
+size_t HardwareSerial::println(int n, int base) { return this->print(n, base) + this->println(); }
+size_t HardwareSerial::println(unsigned int n, int base) { return this->print(n, base) + this->println(); }
+size_t HardwareSerial::println(long n, int base) { return this->print(n, base) + this->println(); }
+size_t HardwareSerial::println(unsigned long n, int base) { return this->print(n, base) + this->println(); }
+size_t HardwareSerial::println(double n, int digits) { return this->print(n, digits) + this->println(); }
+
+size_t HardwareSerial::printNumber(unsigned long n, int base)
+{
+    // most significant digit first, like Print::printNumber()
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2)
+        base = 10;
+    do
+    {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+    return this->print(str);
+}
+
+HardwareSerial Serial;
+
+// SPIClass
+
+void SPIClass::begin() {}
+void SPIClass::end() {}
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    this->clock = settings.clock;
+    this->inTransaction = true;
+    if (this->usingIRQ)
+        Si4463Sim::holdInterrupts(true);
+}
+
+void SPIClass::endTransaction()
+{
+    this->inTransaction = false;
+    if (this->usingIRQ)
+        Si4463Sim::holdInterrupts(false);
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    // 8 clock cycles per byte
+    Si4463Sim::advance(8000000000ULL / this->clock);
+    return Si4463Sim::transfer(this, data);
+}
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+    uint8_t *b = (uint8_t *)buf;
+    for (size_t i = 0; i < count; i++)
+        b[i] = this->transfer(b[i]);
+}
+
+void SPIClass::transfer(const void *txBuf, void *rxBuf, size_t count)
+{
+    const uint8_t *tx = (const uint8_t *)txBuf;
+    uint8_t *rx = (uint8_t *)rxBuf;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t b = this->transfer(tx != nullptr ? tx[i] : 0xFF);
+        if (rx != nullptr)
+            rx[i] = b;
+    }
+}
+
+void SPIClass::usingInterrupt(uint8_t interrupt)
+{
+    this->usingIRQ = true;
+}
+
+void SPIClass::notUsingInterrupt(uint8_t interrupt)
+{
+    this->usingIRQ = false;
+}
+
+SPIClass SPI;
+SPIClass SPI1;
+SPIClass SPI2;
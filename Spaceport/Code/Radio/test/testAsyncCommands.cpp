@@ -0,0 +1,126 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+
+// queued while receiving, the loop keeps running while the radio works on them
+Si4463Command partInfo = {C_PART_INFO, 0, {}, 8};
+Si4463Command modemStatus = {C_GET_MODEM_STATUS, 1, {0xFF}, 8};
+
+// how often to queue the commands
+uint32_t cmdTimer = millis();
+uint32_t cmdInterval = 500;
+
+// longest loop since the last report
+uint32_t maxLoop = 0;
+uint32_t completed = 0;
+uint32_t failed = 0;
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
+
+APRSText testMessage(aprscfg);
+
+void onPartInfo(Si4463Command *cmd, void *ctx);
+void onModemStatus(Si4463Command *cmd, void *ctx);
+
+void setup()
+{
+    Serial.begin(9600);
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+
+    partInfo.onComplete = onPartInfo;
+    modemStatus.onComplete = onModemStatus;
+}
+
+void loop()
+{
+    uint32_t start = micros();
+    if (radio.avail())
+    {
+        radio.receive(testMessage);
+        Serial.print("\nReceived message: ");
+        Serial.println(testMessage.msg);
+    }
+    if (millis() - cmdTimer > cmdInterval)
+    {
+        cmdTimer = millis();
+        // the commands from the last round may still be running, queueCommand() refuses them until they are done
+        if (!radio.queueCommand(partInfo) || !radio.queueCommand(modemStatus))
+            Serial.println("Could not queue a command");
+
+        Serial.print("Longest loop: ");
+        Serial.print(maxLoop);
+        Serial.print(" us | Completed: ");
+        Serial.print(completed);
+        Serial.print(" | Failed: ");
+        Serial.println(failed);
+        maxLoop = 0;
+    }
+    // need to call as fast as possible every loop, also collects the command responses
+    radio.update();
+
+    if (micros() - start > maxLoop)
+        maxLoop = micros() - start;
+}
+
+void onPartInfo(Si4463Command *cmd, void *ctx)
+{
+    if (cmd->status == CMD_FAILED)
+    {
+        failed++;
+        return;
+    }
+    completed++;
+    Serial.print("Part: ");
+    Serial.print((cmd->res[1] << 8) | cmd->res[2], HEX);
+    Serial.print(" | Rev: ");
+    Serial.print(cmd->res[0]);
+    Serial.print(" | Took: ");
+    Serial.print(micros() - cmd->sentAt);
+    Serial.println(" us");
+}
+
+void onModemStatus(Si4463Command *cmd, void *ctx)
+{
+    if (cmd->status == CMD_FAILED)
+    {
+        failed++;
+        return;
+    }
+    completed++;
+    // current RSSI is byte 2, converted the same way as Si4463::RSSI()
+    Serial.print("Current RSSI: ");
+    Serial.print(cmd->res[2] / 2 - 64 - 70);
+    Serial.println(" dBm");
+}
@@ -0,0 +1,97 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// two radios receiving at the same time on one SPI bus, pins match the Ground-Receiver avionics and payload radios
+
+Si4463HardwareConfig hwcfgA = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfgA = {
+    &SPI, // spi bus to use
+    30,   // cs
+    29,   // sdn
+    24,   // irq
+    25,   // gpio0
+    26,   // gpio1
+    27,   // gpio2
+    28,   // gpio3
+};
+
+Si4463HardwareConfig hwcfgB = {
+    MOD_2GFSK,         // modulation
+    DR_100k,           // data rate
+    (uint32_t)431.3e6, // frequency (Hz)
+    127,               // tx power (127 = ~20dBm)
+    48,                // preamble length
+    16,                // required received valid preamble
+};
+
+Si4463PinConfig pincfgB = {
+    &SPI, // spi bus to use
+    6,    // cs
+    5,    // sdn
+    0,    // irq
+    1,    // gpio0
+    2,    // gpio1
+    3,    // gpio2
+    4,    // gpio3
+};
+
+Si4463 radioA(hwcfgA, pincfgA);
+Si4463 radioB(hwcfgB, pincfgB);
+Si4463Bus bus(&SPI);
+
+uint32_t receivedA = 0;
+uint32_t receivedB = 0;
+uint32_t timer = millis();
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
+
+APRSText testMessage(aprscfg);
+
+void setup()
+{
+    Serial.begin(9600);
+    bus.add(&radioA);
+    bus.add(&radioB);
+    // radio A is serviced while radio B is configured
+    if (!bus.begin())
+    {
+        Serial.println("Error: radios failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radios began successfully");
+}
+
+void loop()
+{
+    if (radioA.avail())
+    {
+        radioA.receive(testMessage);
+        receivedA++;
+    }
+    if (radioB.avail())
+    {
+        radioB.receive(testMessage);
+        receivedB++;
+    }
+    if (millis() - timer > 1000)
+    {
+        timer = millis();
+        Serial.print("Received A: ");
+        Serial.print(receivedA);
+        Serial.print(" | Received B: ");
+        Serial.println(receivedB);
+    }
+    // updates both radios
+    bus.update();
+}
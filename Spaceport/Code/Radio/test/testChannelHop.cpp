@@ -0,0 +1,75 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+// frequencies to hop between, all in the same band so only the channel changes
+const uint32_t freqs[3] = {(uint32_t)430e6, (uint32_t)431.3e6, (uint32_t)433e6};
+
+// checked at compile time
+static_assert(Si4463FreqPlan::config(430e6).channel == 80, "430 MHz should be channel 80");
+static_assert(Si4463FreqPlan::config(431.3e6).channel == 93, "431.3 MHz should be channel 93");
+static_assert(Si4463FreqPlan::config(433e6).channel == 110, "433 MHz should be channel 110");
+
+uint32_t timer = millis();
+int current = 0;
+
+void setup()
+{
+    Serial.begin(9600);
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+    // enter RX
+    radio.avail();
+}
+
+void loop()
+{
+    if (millis() - timer > 1000)
+    {
+        timer = millis();
+        current = (current + 1) % 3;
+
+        uint32_t start = micros();
+        bool success = radio.setFrequency(freqs[current]);
+        uint32_t elapsed = micros() - start;
+
+        Serial.print("Hopped to ");
+        Serial.print(radio.freq);
+        Serial.print(" Hz (channel ");
+        Serial.print(radio.channel);
+        Serial.print(") in ");
+        Serial.print(elapsed);
+        Serial.println(success ? " us" : " us, FAILED");
+    }
+    radio.update();
+}
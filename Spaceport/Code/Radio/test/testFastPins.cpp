@@ -0,0 +1,139 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// Compares the cycles spent on one pin read by digitalRead() (what Si4463 used before its pins were cached), by a cached
+// Si4463IOPin, and by digitalReadFast() with a constant pin, then times update() on a radio that is receiving
+// The teensy41_FAST_PINS_BASELINE env builds it with SI4463_DIGITAL_PINS, so the driver's pins go through
+// digitalRead()/digitalWrite() again: its update() line is the time before the pins were cached, compare it with the
+// update() line from teensy41_FAST_PINS
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+
+uint8_t buf[Si4463::MAX_LEN];
+
+// number of reads or update() calls to time
+const uint32_t iterations = 100000;
+
+/*
+Cycle counts of the timed call
+- uint32_t min : the fastest call
+- uint32_t max : the slowest call
+- uint64_t total : the sum of all calls
+*/
+struct CycleStats
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+};
+
+// runs f iterations times and collects the cycles each call took
+template <typename F>
+CycleStats timeCalls(F f);
+void printStats(const char *name, const CycleStats &s);
+
+// volatile so the compiler can't hoist the reads out of the loop
+volatile uint8_t gpio0Pin = 9;
+volatile bool sink;
+
+void setup()
+{
+    Serial.begin(9600);
+    while (!Serial && millis() < 3000)
+        ;
+
+    // enable the cycle counter
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+
+    Si4463IOPin cached;
+    cached.attach(gpio0Pin);
+    CycleStats runtime = timeCalls([]() { sink = digitalRead(gpio0Pin); });
+    CycleStats io = timeCalls([&]() { sink = cached.read(); });
+    CycleStats constant = timeCalls([]() { sink = digitalReadFast(9); });
+
+    radio.rx();
+    CycleStats update = timeCalls([]()
+                                  {
+                                      radio.update();
+                                      // anything received is dropped, only the time matters
+                                      if (radio.avail())
+                                          radio.readRXBuf(buf, sizeof(buf)); });
+
+    Serial.print("cycles over ");
+    Serial.print(iterations);
+    Serial.print(" calls at ");
+    Serial.print(F_CPU_ACTUAL / 1000000);
+    Serial.println(" MHz (the loop and timing overhead is included)");
+#ifdef SI4463_DIGITAL_PINS
+    Serial.println("driver pins: digitalRead()/digitalWrite() (baseline)");
+#else
+    Serial.println("driver pins: cached registers");
+#endif
+    printStats("digitalRead()       ", runtime);
+    printStats("Si4463IOPin::read() ", io);
+    printStats("digitalReadFast(9)  ", constant);
+    printStats("Si4463::update()    ", update);
+}
+
+void loop()
+{
+}
+
+template <typename F>
+CycleStats timeCalls(F f)
+{
+    CycleStats s = {UINT32_MAX, 0, 0};
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        uint32_t start = ARM_DWT_CYCCNT;
+        f();
+        uint32_t cycles = ARM_DWT_CYCCNT - start;
+        if (cycles < s.min)
+            s.min = cycles;
+        if (cycles > s.max)
+            s.max = cycles;
+        s.total += cycles;
+    }
+    return s;
+}
+
+void printStats(const char *name, const CycleStats &s)
+{
+    Serial.print(name);
+    Serial.print(" | min: ");
+    Serial.print(s.min);
+    Serial.print(" | avg: ");
+    Serial.print((uint32_t)(s.total / iterations));
+    Serial.print(" | max: ");
+    Serial.println(s.max);
+}
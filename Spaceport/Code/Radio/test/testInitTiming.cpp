@@ -0,0 +1,73 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+
+// number of times to run begin() for each method
+const int runs = 5;
+
+uint32_t timeBegin(bool batch)
+{
+    radio.setBatchConfig(batch);
+    uint32_t total = 0;
+    for (int i = 0; i < runs; i++)
+    {
+        uint32_t start = micros();
+        if (!radio.begin(CONFIG_422Mc110_2GFSK_500000U, sizeof(CONFIG_422Mc110_2GFSK_500000U)))
+        {
+            Serial.println("Error: radio failed to begin");
+            Serial.flush();
+            while (1)
+                ;
+        }
+        total += micros() - start;
+    }
+    return total / runs;
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    while (!Serial)
+        ;
+
+    uint32_t oldTime = timeBegin(false);
+    uint32_t newTime = timeBegin(true);
+
+    Serial.println("begin() timing, average of 5 runs");
+    Serial.print("Single properties (us): ");
+    Serial.println(oldTime);
+    Serial.print("Batched properties (us): ");
+    Serial.println(newTime);
+
+    // the batch from the last begin() can be saved in a header and passed to begin() like a WDS config
+    radio.printConfig("CONFIG_422Mc110_2GFSK_500000U_PRECOMPUTED");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,107 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header for the telemetry profile, the data profile uses the default config
+// (WDS headers can't be included together, they define the same macros)
+#include "422Mc80_4GFSK_009600H.h"
+
+// begin() uses the data profile
+Si4463HardwareConfig datacfg = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463HardwareConfig telemetrycfg = {
+    MOD_4GFSK,       // modulation
+    DR_4_8k,         // data rate (9.6 kbps with 4 levels)
+    (uint32_t)422e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    32,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    10,   // cs
+    38,   // sdn
+    33,   // irq
+    34,   // gpio0
+    35,   // gpio1
+    36,   // gpio2
+    37,   // gpio3
+};
+
+Si4463 radio(datacfg, pincfg);
+
+// how often to switch profiles
+uint32_t switchTimer = millis();
+uint32_t switchInterval = 5000;
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
+
+APRSText testMessage(aprscfg, "Profile switch test", "");
+
+void setup()
+{
+    Serial.begin(9600);
+    // profiles are only cached, nothing is sent until switchProfile()
+    if (!radio.addProfile("data", datacfg) ||
+        !radio.addProfile("telemetry", telemetrycfg, CONFIG_422Mc80_4GFSK_009600H, sizeof(CONFIG_422Mc80_4GFSK_009600H)))
+    {
+        Serial.println("Error: could not add profiles");
+        Serial.flush();
+        while (1)
+            ;
+    }
+
+    uint32_t start = micros();
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.print("Radio began successfully in ");
+    Serial.print(micros() - start);
+    Serial.println(" us");
+
+    // the radio is already set up this way, so nothing should need to be sent
+    start = micros();
+    radio.switchProfile("data");
+    Serial.print("Switched to the current profile in ");
+    Serial.print(micros() - start);
+    Serial.println(" us");
+}
+
+void loop()
+{
+    if (millis() - switchTimer > switchInterval)
+    {
+        switchTimer = millis();
+        const char *next = strcmp(radio.currentProfile(), "data") == 0 ? "telemetry" : "data";
+        uint32_t start = micros();
+        // waits for the current packet to finish sending
+        if (radio.switchProfile(next))
+        {
+            Serial.print("Switched to ");
+            Serial.print(next);
+            Serial.print(" in ");
+            Serial.print(micros() - start);
+            Serial.println(" us");
+        }
+        else
+            Serial.println("Could not switch profiles, still transmitting");
+    }
+    if (radio.state == STATE_IDLE)
+    {
+        radio.send(testMessage);
+    }
+    // need to call as fast as possible every loop
+    radio.update();
+}
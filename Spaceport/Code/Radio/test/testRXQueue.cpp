@@ -0,0 +1,102 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+uint32_t timeout = 2100;
+
+uint32_t received = 0;
+uint32_t timeouts = 0;
+
+// simulated slow processing per message, packets that arrive in the meantime should be queued instead of dropped
+uint32_t processing = 200;
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
+
+APRSText testMessage(aprscfg);
+
+void logStats();
+
+void setup()
+{
+    Serial.begin(9600);
+    // queue up to 8 packets of up to 256 bytes
+    if (!radio.setRXQueue(8, 256))
+    {
+        Serial.println("Error: could not allocate RX queue");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+}
+
+void loop()
+{
+    if (radio.avail())
+    {
+        radio.receive(testMessage);
+        Serial.print("\nReceived message: ");
+        Serial.println(testMessage.msg);
+        Serial.print("RSSI: ");
+        Serial.print(radio.RSSI());
+        Serial.println(" dBm");
+        Serial.print("Still queued: ");
+        Serial.println(radio.rxQueued());
+        delay(processing);
+
+        // reset timeout
+        timer = millis();
+        received++;
+        logStats();
+    }
+    if (millis() - timer > timeout)
+    {
+        timer = millis();
+        timeouts++;
+        logStats();
+    }
+    // need to call as fast as possible every loop
+    radio.update();
+}
+
+void logStats()
+{
+    Serial.print("Received: ");
+    Serial.print(received);
+    Serial.print(" | Timeouts: ");
+    Serial.print(timeouts);
+    Serial.print(" | Dropped: ");
+    Serial.println(radio.stats().rxDropped);
+}
\ No newline at end of file
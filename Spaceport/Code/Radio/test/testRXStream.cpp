@@ -0,0 +1,111 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+
+uint8_t frame[Si4463::MAX_LEN];
+// stream offset expected in the next frame
+uint32_t nextOffset = 0;
+
+uint32_t frames = 0;
+uint32_t payloadBytes = 0;
+uint32_t lostBytes = 0;
+uint32_t badFrames = 0;
+
+void setup()
+{
+    Serial.begin(9600);
+    // frames arrive back to back, so the radio has to stay in RX between them
+    if (!radio.setRXQueue(4))
+    {
+        Serial.println("Error: could not allocate RX queue");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    if (!radio.begin(CONFIG_422Mc110_2GFSK_500000U, sizeof(CONFIG_422Mc110_2GFSK_500000U)))
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+}
+
+void loop()
+{
+    if (radio.avail())
+    {
+        uint16_t len = radio.readRXQueue(frame, sizeof(frame));
+        Si4463StreamHeader header;
+        if (!Si4463::readStreamHeader(frame, len, header))
+            badFrames++;
+        else
+        {
+            // resynchronize on the offset, anything skipped over was lost
+            if (header.flags & STREAM_START)
+                nextOffset = 0;
+            if (header.offset > nextOffset)
+                lostBytes += header.offset - nextOffset;
+            uint16_t payload = len - Si4463::STREAM_HEADER_LEN;
+            for (uint16_t i = 0; i < payload; i++)
+            {
+                if (frame[Si4463::STREAM_HEADER_LEN + i] != (uint8_t)(header.offset + i))
+                {
+                    badFrames++;
+                    break;
+                }
+            }
+            nextOffset = header.offset + payload;
+            frames++;
+            payloadBytes += payload;
+            if (header.flags & STREAM_END)
+                Serial.println("Stream ended");
+        }
+    }
+
+    if (millis() - timer > 2000)
+    {
+        uint32_t elapsed = millis() - timer;
+        timer = millis();
+        Serial.print("Frames: ");
+        Serial.print(frames);
+        Serial.print(" | Rate: ");
+        Serial.print(payloadBytes * 8.0 / elapsed);
+        Serial.print(" kbps | Lost bytes: ");
+        Serial.print(lostBytes);
+        Serial.print(" | Bad frames: ");
+        Serial.println(badFrames);
+        frames = 0;
+        payloadBytes = 0;
+    }
+
+    // need to call as fast as possible every loop
+    radio.update();
+}
@@ -0,0 +1,159 @@
+// Checks switchProfile() against the simulated radio (lib/Si4463Sim) on the host: after switching, every property on the
+// chip has to match a chip set up by a fresh begin() with the same configuration
+// Build and run with: pio run -e native_SIM_PROFILES -t exec
+
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+#include "Si4463Sim.h"
+
+// radio config header for the 4GFSK profile, the 2GFSK profile uses the default config
+// (WDS headers can't be included together, they define the same macros)
+#include "422Mc80_4GFSK_009600H.h"
+
+Si4463HardwareConfig cfg2GFSK = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463HardwareConfig cfg4GFSK = {
+    MOD_4GFSK,       // modulation
+    DR_4_8k,         // data rate (9.6 kbps with 4 levels)
+    (uint32_t)422e6, // frequency (Hz)
+    100,             // tx power
+    32,              // preamble length
+    16,              // required received valid preamble
+};
+
+// every WDS array in include/ sets the same properties, so the 4GFSK profile also sets the whitening seed, which the
+// 2GFSK profile leaves at its power on value. Switching to 2GFSK has to put it back
+const uint8_t extraConfig[] = {0x06, C_SET_PROPERTY, G_PKT, 0x02, P_PKT_WHT_SEED2, 0x12, 0x34};
+uint8_t config4GFSK[sizeof(CONFIG_422Mc80_4GFSK_009600H) + sizeof(extraConfig)];
+
+Si4463PinConfig switchPins = {
+    &SPI, // spi bus to use
+    10,   // cs
+    38,   // sdn
+    33,   // irq
+    34,   // gpio0
+    35,   // gpio1
+    36,   // gpio2
+    37,   // gpio3
+};
+
+Si4463PinConfig freshPins = {
+    &SPI1, // spi bus to use
+    0,     // cs
+    1,     // sdn
+    2,     // irq
+    3,     // gpio0
+    4,     // gpio1
+    5,     // gpio2
+    6,     // gpio3
+};
+
+/*
+Compares every property of two chips
+- name : printed with the result
+- switched : the chip that was switched to the profile
+- fresh : the chip set up by begin() with the profile's configuration
+Returns: the number of properties that differ
+*/
+int compareChips(const char *name, const Si4463Sim &switched, const Si4463Sim &fresh);
+/*
+Sets up a chip with a fresh begin() and compares it with the switched chip
+- name : printed with the result
+- switched : the chip that was switched to the profile
+- hConfig : the hardware configuration of the profile
+- config : the WDS configuration array of the profile, or nullptr for the default configuration
+- length : the length of ```config```
+Returns: the number of properties that differ, or -1 if the fresh radio failed to begin
+*/
+int compareFresh(const char *name, const Si4463Sim &switched, Si4463HardwareConfig hConfig, const uint8_t *config, uint32_t length);
+
+int main()
+{
+    memcpy(config4GFSK, CONFIG_422Mc80_4GFSK_009600H, sizeof(CONFIG_422Mc80_4GFSK_009600H));
+    memcpy(config4GFSK + sizeof(CONFIG_422Mc80_4GFSK_009600H), extraConfig, sizeof(extraConfig));
+
+    Si4463SimChannel channel;
+    Si4463Sim chip(&channel, switchPins.spi, switchPins.cs, switchPins.sdn, switchPins.irq, switchPins.gpio0, switchPins.gpio1, switchPins.gpio2, switchPins.gpio3);
+    Si4463 radio(cfg4GFSK, switchPins);
+
+    if (!radio.addProfile("2GFSK", cfg2GFSK) ||
+        !radio.addProfile("4GFSK", cfg4GFSK, config4GFSK, sizeof(config4GFSK)))
+    {
+        printf("Error: could not add profiles\n");
+        return 1;
+    }
+    // starts out as the 4GFSK profile, so the 4GFSK WDS properties are on the chip when switching away from it
+    if (!radio.begin(config4GFSK, sizeof(config4GFSK)))
+    {
+        printf("Error: radio failed to begin\n");
+        return 1;
+    }
+
+    int failures = 0;
+    if (!radio.switchProfile("2GFSK"))
+    {
+        printf("Error: could not switch to 2GFSK\n");
+        return 1;
+    }
+    if (compareFresh("4GFSK -> 2GFSK", chip, cfg2GFSK, nullptr, 0) != 0)
+        failures++;
+
+    if (!radio.switchProfile("4GFSK"))
+    {
+        printf("Error: could not switch to 4GFSK\n");
+        return 1;
+    }
+    if (compareFresh("2GFSK -> 4GFSK", chip, cfg4GFSK, config4GFSK, sizeof(config4GFSK)) != 0)
+        failures++;
+
+    if (chip.cmdErrors != 0)
+    {
+        printf("Error: %u commands sent while CTS was low\n", (unsigned)chip.cmdErrors);
+        failures++;
+    }
+    printf(failures == 0 ? "PASS\n" : "FAIL\n");
+    return failures == 0 ? 0 : 1;
+}
+
+int compareChips(const char *name, const Si4463Sim &switched, const Si4463Sim &fresh)
+{
+    int differ = 0;
+    for (int group = 0; group < 256; group++)
+    {
+        for (int prop = 0; prop < 256; prop++)
+        {
+            uint8_t a = switched.property(group, prop);
+            uint8_t b = fresh.property(group, prop);
+            if (a == b)
+                continue;
+            if (differ < 10)
+                printf("  group 0x%02X property 0x%02X: 0x%02X after switching, 0x%02X after begin()\n", group, prop, a, b);
+            differ++;
+        }
+    }
+    printf("%-16s %4d properties differ from a fresh begin()\n", name, differ);
+    return differ;
+}
+
+int compareFresh(const char *name, const Si4463Sim &switched, Si4463HardwareConfig hConfig, const uint8_t *config, uint32_t length)
+{
+    // a separate channel, so the two chips never hear each other
+    Si4463SimChannel channel;
+    Si4463Sim chip(&channel, freshPins.spi, freshPins.cs, freshPins.sdn, freshPins.irq, freshPins.gpio0, freshPins.gpio1, freshPins.gpio2, freshPins.gpio3);
+    Si4463 radio(hConfig, freshPins);
+    bool began = config == nullptr ? radio.begin() : radio.begin(config, length);
+    if (!began)
+    {
+        printf("Error: fresh radio failed to begin\n");
+        return -1;
+    }
+    return compareChips(name, switched, chip);
+}
@@ -0,0 +1,262 @@
+// Runs the Si4463 driver against two simulated radios (lib/Si4463Sim) on the host and measures throughput
+// Build and run with: pio run -e native_SIM_THROUGHPUT -t exec
+
+#include <chrono>
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+#include "Si4463Sim.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig txPins = {
+    &SPI, // spi bus to use
+    10,   // cs
+    38,   // sdn
+    33,   // irq
+    34,   // gpio0
+    35,   // gpio1
+    36,   // gpio2
+    37,   // gpio3
+};
+
+Si4463PinConfig rxPins = {
+    &SPI1, // spi bus to use
+    0,     // cs
+    1,     // sdn
+    2,     // irq
+    3,     // gpio0
+    4,     // gpio1
+    5,     // gpio2
+    6,     // gpio3
+};
+
+/*
+Benchmark settings
+- txThresh, rxThresh : FIFO thresholds, see setTXThreshold()/setRXThreshold()
+- loopTime : time spent outside of update() each loop (us)
+- irqMode : whether both radios use the nIRQ interrupt
+- packetLen : length of each packet
+- chunkLen : if nonzero, packets are streamed with startTX()/writeTXBuf() this many bytes at a time
+- stream : whether to send with startStream()/writeStream() instead, packetLen is the frame length
+- crc : the hardware crc, see setCRC()
+- errorRate : chance of a packet being corrupted on the channel
+*/
+struct BenchConfig
+{
+    uint8_t txThresh;
+    uint8_t rxThresh;
+    uint32_t loopTime;
+    bool irqMode;
+    uint16_t packetLen;
+    uint16_t chunkLen;
+    bool stream = false;
+    Si4463CRC crc = CRC_NONE;
+    float errorRate = 0;
+};
+
+// simulated time per run
+const uint32_t runTime = 2000; // ms
+// chance of a packet being lost on the channel
+const float lossRate = 0.0;
+
+uint8_t txBuf[Si4463::MAX_LEN];
+uint8_t rxBuf[Si4463::MAX_LEN];
+uint8_t streamRing[16384];
+
+void printHeader();
+void runBench(const BenchConfig &cfg);
+
+int main()
+{
+    printHeader();
+
+    // FIFO thresholds
+    runBench({16, 16, 10, false, 1000, 0});
+    runBench({32, 32, 10, false, 1000, 0});
+    runBench({48, 40, 10, false, 1000, 0});
+    runBench({63, 40, 10, false, 1000, 0});
+    runBench({63, 63, 10, false, 1000, 0});
+
+    // update() call frequency
+    runBench({63, 40, 1, false, 1000, 0});
+    runBench({63, 40, 50, false, 1000, 0});
+    runBench({63, 40, 100, false, 1000, 0});
+    runBench({63, 40, 200, false, 1000, 0});
+
+    // interrupts instead of polling
+    runBench({63, 40, 10, true, 1000, 0});
+    runBench({63, 40, 200, true, 1000, 0});
+    // the interrupt services the FIFOs on its own, so a stalled loop still keeps up
+    runBench({63, 40, 50000, true, 1000, 0});
+
+    // packet length
+    runBench({63, 40, 10, false, 100, 0});
+    runBench({63, 40, 10, false, 4000, 0});
+
+    // streaming
+    runBench({63, 40, 10, false, 4000, 64});
+    runBench({63, 40, 10, false, 4000, 512});
+
+    // continuous stream, frames chained back to back
+    runBench({63, 40, 10, false, 1000, 0, true});
+    runBench({63, 40, 10, false, 4000, 0, true});
+    runBench({63, 40, 10, false, Si4463::MAX_LEN, 0, true});
+    runBench({63, 40, 10, true, 4000, 0, true});
+
+    // hardware crc, with some packets corrupted
+    runBench({63, 40, 10, false, 1000, 0, false, CRC_CCITT_16, 0.1});
+    runBench({63, 40, 10, true, 1000, 0, false, CRC_CCITT_16, 0.1});
+    return 0;
+}
+
+void printHeader()
+{
+    printf("%5s %5s %6s %4s %6s %6s %4s | %9s %6s %6s %6s %6s %6s %6s %7s | %7s %8s\n",
+           "txT", "rxT", "loop", "irq", "len", "chunk", "strm",
+           "kbps", "sent", "recv", "bad", "crc", "undfl", "ovrfl", "maxUpd",
+           "cmdErr", "speedup");
+}
+
+void runBench(const BenchConfig &cfg)
+{
+    // fresh chips and drivers for each run
+    Si4463SimChannel channel;
+    channel.lossRate = lossRate;
+    channel.errorRate = cfg.errorRate;
+    Si4463Sim txChip(&channel, txPins.spi, txPins.cs, txPins.sdn, txPins.irq, txPins.gpio0, txPins.gpio1, txPins.gpio2, txPins.gpio3);
+    Si4463Sim rxChip(&channel, rxPins.spi, rxPins.cs, rxPins.sdn, rxPins.irq, rxPins.gpio0, rxPins.gpio1, rxPins.gpio2, rxPins.gpio3);
+    Si4463 txRadio(hwcfg, txPins);
+    Si4463 rxRadio(hwcfg, rxPins);
+
+    // IRQ mode is set up by begin(), the thresholds are reset by it
+    txRadio.setIRQMode(cfg.irqMode);
+    rxRadio.setIRQMode(cfg.irqMode);
+    if (!txRadio.begin() || !rxRadio.begin())
+    {
+        printf("Error: radio failed to begin\n");
+        return;
+    }
+    txRadio.setCRC(cfg.crc);
+    rxRadio.setCRC(cfg.crc);
+    txRadio.setTXThreshold(cfg.txThresh);
+    rxRadio.setRXThreshold(cfg.rxThresh);
+    rxRadio.setRXQueue(4);
+    if (cfg.stream && !txRadio.startStream(streamRing, sizeof(streamRing), cfg.packetLen))
+    {
+        printf("Error: stream failed to start\n");
+        return;
+    }
+    rxRadio.resetStats();
+    txRadio.resetStats();
+
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t bad = 0;
+    uint64_t goodBytes = 0;
+    // streaming progress, bytes of the current packet handed to the driver
+    uint16_t streamed = 0;
+    // longest time spent in one loop's driver calls
+    uint64_t maxUpdate = 0;
+    // stream bytes handed to the driver
+    uint32_t produced = 0;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t simStart = Si4463Sim::now();
+    uint64_t simEnd = simStart + (uint64_t)runTime * 1000000;
+
+    while (Si4463Sim::now() < simEnd)
+    {
+        // keep the stream's ring full, numbered by stream offset so the receiver can check it
+        if (cfg.stream)
+        {
+            uint16_t n = txRadio.streamSpace();
+            if (n > sizeof(txBuf))
+                n = sizeof(txBuf);
+            for (uint16_t i = 0; i < n; i++)
+                txBuf[i] = (uint8_t)(produced + i);
+            produced += txRadio.writeStream(txBuf, n);
+        }
+        // start the next packet as soon as the last one is done, numbered so the receiver can check it
+        else if (txRadio.state == STATE_IDLE && (cfg.chunkLen == 0 || streamed == 0 || streamed == cfg.packetLen))
+        {
+            for (uint16_t i = 0; i < cfg.packetLen; i++)
+                txBuf[i] = (uint8_t)(sent + i);
+            bool started;
+            if (cfg.chunkLen == 0)
+            {
+                started = txRadio.tx(txBuf, cfg.packetLen);
+            }
+            else
+            {
+                streamed = cfg.chunkLen < cfg.packetLen ? cfg.chunkLen : cfg.packetLen;
+                started = txRadio.startTX(txBuf, streamed, cfg.packetLen);
+            }
+            if (started)
+                sent++;
+        }
+        // feed the rest of a streamed packet
+        if (cfg.chunkLen > 0 && streamed > 0 && streamed < cfg.packetLen)
+        {
+            uint16_t n = cfg.packetLen - streamed < cfg.chunkLen ? cfg.packetLen - streamed : cfg.chunkLen;
+            streamed += txRadio.writeTXBuf(txBuf + streamed, n);
+        }
+
+        uint64_t loopStart = Si4463Sim::now();
+        if (rxRadio.avail())
+        {
+            uint16_t len = rxRadio.readRXQueue(rxBuf, sizeof(rxBuf));
+            bool ok;
+            if (cfg.stream)
+            {
+                // frames can be short if the ring ran low, the payload is checked against the stream offset
+                Si4463StreamHeader header;
+                ok = Si4463::readStreamHeader(rxBuf, len, header) && len <= cfg.packetLen;
+                for (uint16_t i = Si4463::STREAM_HEADER_LEN; ok && i < len; i++)
+                    ok = rxBuf[i] == (uint8_t)(header.offset + i - Si4463::STREAM_HEADER_LEN);
+                if (ok)
+                    len -= Si4463::STREAM_HEADER_LEN;
+            }
+            else
+            {
+                ok = len == cfg.packetLen;
+                for (uint16_t i = 1; ok && i < len; i++)
+                    ok = rxBuf[i] == (uint8_t)(rxBuf[0] + i);
+            }
+            if (ok)
+            {
+                received++;
+                goodBytes += len;
+            }
+            else
+                bad++;
+        }
+
+        txRadio.update();
+        rxRadio.update();
+        if (Si4463Sim::now() - loopStart > maxUpdate)
+            maxUpdate = Si4463Sim::now() - loopStart;
+        // the rest of the loop
+        delayMicroseconds(cfg.loopTime);
+    }
+
+    double simSeconds = (Si4463Sim::now() - simStart) / 1e9;
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    const Si4463Stats &txStats = txRadio.stats();
+    const Si4463Stats &rxStats = rxRadio.stats();
+    if (cfg.stream)
+        sent = txStats.txPackets;
+
+    printf("%5u %5u %6u %4s %6u %6u %4s | %9.1f %6u %6u %6u %6u %6u %6u %7u | %7u %7.0fx\n",
+           cfg.txThresh, cfg.rxThresh, (unsigned)cfg.loopTime, cfg.irqMode ? "yes" : "no", cfg.packetLen, cfg.chunkLen, cfg.stream ? "yes" : "no",
+           goodBytes * 8 / simSeconds / 1000, (unsigned)sent, (unsigned)received, (unsigned)bad,
+           (unsigned)rxStats.crcErrors, (unsigned)txStats.txUnderflows, (unsigned)rxStats.rxOverflows, (unsigned)(maxUpdate / 1000),
+           (unsigned)(txChip.cmdErrors + rxChip.cmdErrors), simSeconds / wallSeconds);
+}
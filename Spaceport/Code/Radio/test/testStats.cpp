@@ -0,0 +1,144 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_100k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+uint32_t timeout = 2100;
+
+uint32_t received = 0;
+uint32_t timeouts = 0;
+
+// how often to print the link statistics
+uint32_t statsTimer = millis();
+uint32_t statsInterval = 1000;
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
+
+APRSText testMessage(aprscfg);
+
+void logStats();
+void logLinkStats();
+
+void setup()
+{
+    Serial.begin(9600);
+    if (!radio.begin())
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+}
+
+void loop()
+{
+    if (radio.avail())
+    {
+        radio.receive(testMessage);
+        Serial.print("\nReceived message: ");
+        Serial.println(testMessage.msg);
+        Serial.print("RSSI: ");
+        Serial.print(radio.RSSI());
+        Serial.println(" dBm");
+
+        // reset timeout
+        timer = millis();
+        received++;
+        logStats();
+    }
+    if (millis() - timer > timeout)
+    {
+        timer = millis();
+        timeouts++;
+        logStats();
+    }
+    if (millis() - statsTimer > statsInterval)
+    {
+        statsTimer = millis();
+        logLinkStats();
+    }
+    // need to call as fast as possible every loop
+    radio.update();
+}
+
+void logStats()
+{
+    Serial.print("Received: ");
+    Serial.print(received);
+    Serial.print(" | Timeouts: ");
+    Serial.println(timeouts);
+}
+
+void logLinkStats()
+{
+    // copy so the counters don't change while printing
+    Si4463Stats s = radio.stats();
+    Serial.print("RX: ");
+    Serial.print(s.rxPackets);
+    Serial.print(" packets, ");
+    Serial.print(s.rxBytes);
+    Serial.print(" bytes | TX: ");
+    Serial.print(s.txPackets);
+    Serial.print(" packets, ");
+    Serial.print(s.txBytes);
+    Serial.println(" bytes");
+    Serial.print("Errors: crc ");
+    Serial.print(s.crcErrors);
+    Serial.print(" | length ");
+    Serial.print(s.lengthErrors);
+    Serial.print(" | dropped ");
+    Serial.print(s.rxDropped);
+    Serial.print(" | TX underflows ");
+    Serial.print(s.txUnderflows);
+    Serial.print(" | RX overflows ");
+    Serial.println(s.rxOverflows);
+    Serial.print("Last packet: RSSI ");
+    Serial.print(s.rssi);
+    Serial.print(" dBm | AFC ");
+    Serial.println(s.afc);
+    Serial.print("SPI time: ");
+    Serial.print(s.spiTime);
+    Serial.print(" us | CTS timeouts: ");
+    Serial.println(s.ctsTimeouts);
+    Serial.print("CTS waits (<us: count):");
+    for (int i = 0; i < Si4463Stats::CTS_HIST_BINS; i++)
+    {
+        Serial.print(" ");
+        if (i < Si4463Stats::CTS_HIST_BINS - 1)
+        {
+            Serial.print("<");
+            Serial.print(Si4463Stats::CTS_HIST_BASE << i);
+        }
+        else
+            Serial.print("rest");
+        Serial.print(": ");
+        Serial.print(s.ctsWaits[i]);
+    }
+    Serial.println();
+}
@@ -0,0 +1,94 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+#define BUZZER 0
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+
+// time spent in update() while a message is being sent
+uint32_t updateTime = 0;
+uint32_t maxUpdateTime = 0;
+
+APRSConfig aprscfg = {"KC3UTM", "ALL", "WIDE1-1", TextMessage, '\\', 'M'};
+
+APRSText testMessage(aprscfg, "test with payload longer than FIFO length, test with payload longer than FIFO length, test with payload longer than FIFO length", "");
+
+void beep(int d)
+{
+    digitalWrite(BUZZER, HIGH);
+    delay(d);
+    digitalWrite(BUZZER, LOW);
+    delay(d);
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    pinMode(BUZZER, OUTPUT);
+    digitalWrite(BUZZER, LOW);
+
+    // FIFO transfers are handed to DMA
+    radio.setAsyncSPI(true);
+    if (!radio.begin(CONFIG_422Mc110_2GFSK_500000U, sizeof(CONFIG_422Mc110_2GFSK_500000U)))
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+        {
+            beep(1000);
+        }
+    }
+    Serial.println("Radio began successfully");
+
+    beep(100);
+}
+
+void loop()
+{
+    if (millis() - timer > 2000)
+    {
+        timer = millis();
+        Serial.print("Time in update() for last message (us): ");
+        Serial.print(updateTime);
+        Serial.print(" | Max single update() (us): ");
+        Serial.println(maxUpdateTime);
+        updateTime = 0;
+        maxUpdateTime = 0;
+
+        Serial.println("Sending message");
+        Serial.println(testMessage.msg);
+        radio.send(testMessage);
+    }
+    // need to call as fast as possible every loop
+    uint32_t start = micros();
+    radio.update();
+    uint32_t elapsed = micros() - start;
+    updateTime += elapsed;
+    if (elapsed > maxUpdateTime)
+        maxUpdateTime = elapsed;
+}
\ No newline at end of file
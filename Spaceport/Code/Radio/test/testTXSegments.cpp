@@ -0,0 +1,103 @@
+#include "Arduino.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+#define BUZZER 0
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+
+// message parts, sent straight from these arrays without copying into the radio
+uint8_t header[4] = {0xAB, 0xCD, 0x00, 0x00};
+uint8_t payload[200] = {};
+uint8_t parity[16] = {};
+
+Si4463Segment segs[3] = {
+    {header, sizeof(header)},
+    {payload, sizeof(payload)},
+    {parity, sizeof(parity)},
+};
+
+// set when the radio is done with the arrays above
+volatile bool done = true;
+uint16_t frame = 0;
+
+void onComplete(void *ctx)
+{
+    *(volatile bool *)ctx = true;
+}
+
+void beep(int d)
+{
+    digitalWrite(BUZZER, HIGH);
+    delay(d);
+    digitalWrite(BUZZER, LOW);
+    delay(d);
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    pinMode(BUZZER, OUTPUT);
+    digitalWrite(BUZZER, LOW);
+
+    if (!radio.begin(CONFIG_422Mc110_2GFSK_500000U, sizeof(CONFIG_422Mc110_2GFSK_500000U)))
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+        {
+            beep(1000);
+        }
+    }
+    Serial.println("Radio began successfully");
+
+    beep(100);
+}
+
+void loop()
+{
+    // only touch the arrays once the radio is done with them
+    if (done && millis() - timer > 2000)
+    {
+        timer = millis();
+        // fill in the next frame
+        frame++;
+        header[2] = frame >> 8;
+        header[3] = frame & 0xFF;
+        for (unsigned int i = 0; i < sizeof(payload); i++)
+            payload[i] = 'a' + (frame + i) % 26;
+        for (unsigned int i = 0; i < sizeof(parity); i++)
+            parity[i] = frame + i;
+
+        Serial.print("Sending frame ");
+        Serial.println(frame);
+        done = false;
+        if (!radio.txSegments(segs, 3, onComplete, (void *)&done))
+            done = true;
+    }
+    // need to call as fast as possible every loop
+    radio.update();
+}
\ No newline at end of file
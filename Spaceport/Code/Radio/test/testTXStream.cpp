@@ -0,0 +1,98 @@
+#include "Arduino.h"
+#include "RadioMessage.h"
+#include "Si4463.h"
+
+// radio config header
+#include "422Mc110_2GFSK_500000U.h"
+
+Si4463HardwareConfig hwcfg = {
+    MOD_2GFSK,       // modulation
+    DR_500k,         // data rate
+    (uint32_t)433e6, // frequency (Hz)
+    127,             // tx power (127 = ~20dBm)
+    48,              // preamble length
+    16,              // required received valid preamble
+};
+
+Si4463PinConfig pincfg = {
+    &SPI, // spi bus to use
+    8,    // cs
+    6,    // sdn
+    7,    // irq
+    9,    // gpio0
+    10,   // gpio1
+    4,    // random pin - gpio2 is not connected
+    5,    // random pin - gpio3 is not connected
+};
+
+Si4463 radio(hwcfg, pincfg);
+uint32_t timer = millis();
+
+// the stream's ring buffer, the producer below keeps it as full as it can
+uint8_t ring[16384];
+// stream bytes produced so far, each byte is the low byte of its stream offset so the receiver can check it
+uint32_t produced = 0;
+uint8_t chunk[512];
+
+// longest single update() call
+uint32_t maxUpdateTime = 0;
+
+void setup()
+{
+    Serial.begin(9600);
+    if (!radio.begin(CONFIG_422Mc110_2GFSK_500000U, sizeof(CONFIG_422Mc110_2GFSK_500000U)))
+    {
+        Serial.println("Error: radio failed to begin");
+        Serial.flush();
+        while (1)
+            ;
+    }
+    Serial.println("Radio began successfully");
+
+    // back to back frames of the maximum length, receive with testRXStream.cpp
+    if (!radio.startStream(ring, sizeof(ring)))
+    {
+        Serial.println("Error: stream failed to start");
+        Serial.flush();
+        while (1)
+            ;
+    }
+}
+
+void loop()
+{
+    // stand in for a camera, produce data as fast as the radio takes it
+    uint16_t n = radio.streamSpace();
+    if (n > sizeof(chunk))
+        n = sizeof(chunk);
+    for (uint16_t i = 0; i < n; i++)
+        chunk[i] = (uint8_t)(produced + i);
+    produced += radio.writeStream(chunk, n);
+
+    if (millis() - timer > 2000)
+    {
+        uint32_t elapsed = millis() - timer;
+        timer = millis();
+        // copy so the counters don't change while printing
+        Si4463Stats s = radio.stats();
+        Serial.print("Frames: ");
+        Serial.print(s.txPackets);
+        Serial.print(" | Bytes: ");
+        Serial.print(s.txBytes);
+        Serial.print(" | Rate: ");
+        Serial.print(s.txBytes * 8.0 / elapsed);
+        Serial.print(" kbps | Underflows: ");
+        Serial.print(s.txUnderflows);
+        Serial.print(" | Max update() (us): ");
+        Serial.println(maxUpdateTime);
+        radio.resetStats();
+        maxUpdateTime = 0;
+    }
+
+    // need to call as fast as possible every loop
+    uint32_t start = micros();
+    radio.update();
+    uint32_t elapsed = micros() - start;
+    if (elapsed > maxUpdateTime)
+        maxUpdateTime = elapsed;
+}
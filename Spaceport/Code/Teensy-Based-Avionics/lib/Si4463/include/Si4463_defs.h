@@ -15,6 +15,19 @@ enum Si4463State : uint8_t
     STATE_RX_COMPLETE, // finished RX
 };
 
+// stages of the non-blocking bring up, see Si4463::startBegin()
+enum Si4463BeginStage : uint8_t
+{
+    BEGIN_IDLE,     // startBegin() hasn't been called
+    BEGIN_WAKE,     // waiting for the chip to come out of power on reset
+    BEGIN_NOP,      // waiting for the chip to respond to the first SPI command
+    BEGIN_POWER_UP, // waiting for POWER_UP to finish
+    BEGIN_WDS,      // the part number checked, the WDS config is next
+    BEGIN_MODEM,    // the WDS config sent, the modem, power, pin and packet config is next
+    BEGIN_DONE,     // the radio is configured and idle
+    BEGIN_FAILED,   // the radio did not respond
+};
+
 // modulations
 enum Si4463Mod : uint8_t
 {
@@ -52,22 +52,7 @@ Si4463::~Si4463()
 
 bool Si4463::begin()
 {
-    // set pins for correct modes
-    pinMode(_cs, OUTPUT);
-    digitalWrite(_cs, HIGH);
-    pinMode(_sdn, OUTPUT);
-    pinMode(_irq, INPUT);
-    pinMode(_gp0, INPUT);
-    pinMode(_gp1, INPUT);
-    pinMode(_gp2, INPUT);
-    pinMode(_gp3, INPUT);
-    this->_cts = this->_irq;
-
-    this->spi->begin();
-    this->spi->setClockDivider(SPI_CLOCK_DIV32);
-
-    if (!this->shutdown(true))
-        return false;
+    this->setupPins();
     delayMicroseconds(10);
     if (!this->shutdown(false))
         return false;
@@ -75,76 +60,7 @@ bool Si4463::begin()
     // complete power on sequence
     this->powerOn();
 
-    // clear pending interrupts
-    uint8_t cIntArgs[3] = {0, 0, 0};
-    uint8_t rIntArgs[8] = {};
-    sendCommand(C_GET_INT_STATUS, 3, cIntArgs, 8, rIntArgs);
-    // Serial.println("INTERRUPTS");
-    //  for (int i = 0; i < 8; i++)
-    //  {
-    //      Serial.println(rIntArgs[i], BIN);
-    //  }
-
-    // check part info to make sure proper communication has been established
-    uint8_t args[8] = {0};
-    this->sendCommandR(C_PART_INFO, 8, args);
-    // Serial.println("PART_INFO");
-    // for (int i = 0; i < 8; i++)
-    // {
-    //     Serial.println(args[i], HEX);
-    // }
-
-    uint16_t partNo = 0;
-    from_bytes(partNo, 1, 0, args);
-    if (partNo != PART_NO)
-        return false; // ERROR: did not receive the correct part number
-
-#ifndef RF4463F30
-    // set the global config, this is the defaults, but apparently a reserved field needs to be set manually
-    this->setProperty(G_GLOBAL, P_GLOBAL_CONFIG, 0b01010000);
-
-    // set clock config
-    this->setProperty(G_GLOBAL, P_GLOBAL_XO_TUNE, 0x00);
-    this->setProperty(G_GLOBAL, P_GLOBAL_CLK_CFG, 0x00);
-#else
-    // rf4463 settings
-    this->setProperty(G_GLOBAL, P_GLOBAL_CONFIG, 0b01110000);
-    this->setProperty(G_GLOBAL, P_GLOBAL_XO_TUNE, 0x62); // from rf4463f30 datasheet
-#endif
-
-    // disable interrupts
-    this->setProperty(G_INT_CTL, P_INT_CTL_ENABLE, 0x00);
-
-    // set TX and RX thresholds
-    this->setTXThreshold(TX_THRESH);
-    this->setRXThreshold(RX_THRESH);
-
-    // Set properties from WDS first
-    this->applyRadioConfig();
-    // set modem (frequency related) config
-    this->setModemConfig(this->mod, this->dataRate, this->freq);
-    // set power level (127 = ~20 dBm)
-    this->setPower(this->pwr);
-    // turn on AFC
-    this->setAFC(true);
-
-    // set defaults for gpio pins
-    this->setPins(PIN_TX_FIFO_EMPTY, PIN_RX_FIFO_FULL, PIN_RX_STATE, PIN_TX_STATE, PIN_TX_STATE, false);
-    this->useSPICTS = false;
-
-    // set defaults for FRRs
-    this->setFRRs(FRR_CURRENT_STATE, FRR_LATCHED_RSSI, FRR_INT_MODEM_PEND, FRR_INT_PH_STATUS);
-
-    this->setPacketConfig(this->mod, this->preambleLen, this->preambleThresh);
-
-    // TODO: needs update
-    // this->performIRCAL();
-
-    // enter idle state
-    uint8_t cIdleArgs[1] = {0b00000011};
-    this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
-
-    return true;
+    return this->configure();
 }
 
 bool Si4463::begin(const uint8_t *config, uint32_t length)
@@ -155,6 +71,77 @@ bool Si4463::begin(const uint8_t *config, uint32_t length)
     return this->begin();
 }
 
+void Si4463::startBegin()
+{
+    this->setupPins();
+    // the reset pulse is too short to be worth returning for, the power on reset after it runs without us
+    delayMicroseconds(10);
+    digitalWrite(this->_sdn, LOW);
+    this->beginTimer = millis();
+    this->beginStage = BEGIN_WAKE;
+}
+
+void Si4463::startBegin(const uint8_t *config, uint32_t length)
+{
+    this->setRadioConfig(config, length);
+    this->startBegin();
+}
+
+Si4463BeginStage Si4463::beginStep()
+{
+    // same sequence and timeouts as shutdown(false), powerOn() and configure(), but returns instead of spinning
+    switch (this->beginStage)
+    {
+    case BEGIN_WAKE:
+        if (this->gpio1())
+        {
+            this->spi_write(C_NOP, 0, {});
+            this->beginTimer = millis();
+            this->beginStage = BEGIN_NOP;
+        }
+        else if (millis() - this->beginTimer >= 10)
+        {
+            Serial.println("ERROR: chip failed to wake up");
+            this->beginStage = BEGIN_FAILED;
+        }
+        break;
+    case BEGIN_NOP:
+        if (this->gpio1())
+        {
+            this->sendPowerUp();
+            this->beginTimer = millis();
+            this->beginStage = BEGIN_POWER_UP;
+        }
+        else if (millis() - this->beginTimer >= 100)
+        {
+            Serial.println("ERROR: chip did not respond to SPI");
+            this->beginStage = BEGIN_FAILED;
+        }
+        break;
+    case BEGIN_POWER_UP:
+        if (this->checkCTS())
+            this->beginStage = this->configureChip() ? BEGIN_WDS : BEGIN_FAILED;
+        else if (millis() - this->beginTimer >= Si4463::CTS_TIMEOUT)
+        {
+            Serial.println("ERROR: CTS timeout after POWER_UP");
+            this->beginStage = BEGIN_FAILED;
+        }
+        break;
+    // the configuration is a run of commands that each wait on CTS, split where it's cheap to so no step is too long
+    case BEGIN_WDS:
+        this->applyRadioConfig();
+        this->beginStage = BEGIN_MODEM;
+        break;
+    case BEGIN_MODEM:
+        this->configureModem();
+        this->beginStage = BEGIN_DONE;
+        break;
+    default:
+        break;
+    }
+    return this->beginStage;
+}
+
 bool Si4463::tx(const uint8_t *message, int len)
 {
     // make sure the packet isn't too long
@@ -1096,7 +1083,12 @@ void Si4463::powerOn()
 {
     // must wait for CTS before sending power up command
     this->waitCTS();
+    this->sendPowerUp();
+    this->waitCTS();
+}
 
+void Si4463::sendPowerUp()
+{
     uint8_t BOOT_OPTIONS = 0b00000001;
 #ifndef RF4463F30
     uint8_t XTAL_OPTIONS = 0b00000001; // assume external crystal (need to change if we have no external crystal)
@@ -1112,7 +1104,7 @@ void Si4463::powerOn()
     };
     to_bytes(XO_FREQ, 2, 0, options);
 
-    this->sendCommandC(C_POWER_UP, 6, options);
+    this->spi_write(C_POWER_UP, 6, options);
 }
 
 void Si4463::performIRCAL()
@@ -1399,6 +1391,110 @@ void Si4463::to_bytes(uint64_t val, uint8_t pos, uint8_t bytePos, uint8_t *arr,
     }
 }
 
+bool Si4463::configure()
+{
+    if (!this->configureChip())
+        return false;
+    // Set properties from WDS first
+    this->applyRadioConfig();
+    this->configureModem();
+    return true;
+}
+
+bool Si4463::configureChip()
+{
+    // clear pending interrupts
+    uint8_t cIntArgs[3] = {0, 0, 0};
+    uint8_t rIntArgs[8] = {};
+    sendCommand(C_GET_INT_STATUS, 3, cIntArgs, 8, rIntArgs);
+    // Serial.println("INTERRUPTS");
+    //  for (int i = 0; i < 8; i++)
+    //  {
+    //      Serial.println(rIntArgs[i], BIN);
+    //  }
+
+    // check part info to make sure proper communication has been established
+    uint8_t args[8] = {0};
+    this->sendCommandR(C_PART_INFO, 8, args);
+    // Serial.println("PART_INFO");
+    // for (int i = 0; i < 8; i++)
+    // {
+    //     Serial.println(args[i], HEX);
+    // }
+
+    uint16_t partNo = 0;
+    from_bytes(partNo, 1, 0, args);
+    if (partNo != PART_NO)
+        return false; // ERROR: did not receive the correct part number
+
+#ifndef RF4463F30
+    // set the global config, this is the defaults, but apparently a reserved field needs to be set manually
+    this->setProperty(G_GLOBAL, P_GLOBAL_CONFIG, 0b01010000);
+
+    // set clock config
+    this->setProperty(G_GLOBAL, P_GLOBAL_XO_TUNE, 0x00);
+    this->setProperty(G_GLOBAL, P_GLOBAL_CLK_CFG, 0x00);
+#else
+    // rf4463 settings
+    this->setProperty(G_GLOBAL, P_GLOBAL_CONFIG, 0b01110000);
+    this->setProperty(G_GLOBAL, P_GLOBAL_XO_TUNE, 0x62); // from rf4463f30 datasheet
+#endif
+
+    // disable interrupts
+    this->setProperty(G_INT_CTL, P_INT_CTL_ENABLE, 0x00);
+
+    // set TX and RX thresholds
+    this->setTXThreshold(TX_THRESH);
+    this->setRXThreshold(RX_THRESH);
+    return true;
+}
+
+void Si4463::configureModem()
+{
+    // set modem (frequency related) config
+    this->setModemConfig(this->mod, this->dataRate, this->freq);
+    // set power level (127 = ~20 dBm)
+    this->setPower(this->pwr);
+    // turn on AFC
+    this->setAFC(true);
+
+    // set defaults for gpio pins
+    this->setPins(PIN_TX_FIFO_EMPTY, PIN_RX_FIFO_FULL, PIN_RX_STATE, PIN_TX_STATE, PIN_TX_STATE, false);
+    this->useSPICTS = false;
+
+    // set defaults for FRRs
+    this->setFRRs(FRR_CURRENT_STATE, FRR_LATCHED_RSSI, FRR_INT_MODEM_PEND, FRR_INT_PH_STATUS);
+
+    this->setPacketConfig(this->mod, this->preambleLen, this->preambleThresh);
+
+    // TODO: needs update
+    // this->performIRCAL();
+
+    // enter idle state
+    uint8_t cIdleArgs[1] = {0b00000011};
+    this->sendCommandC(C_CHANGE_STATE, 1, cIdleArgs);
+}
+
+void Si4463::setupPins()
+{
+    // set pins for correct modes
+    pinMode(_cs, OUTPUT);
+    digitalWrite(_cs, HIGH);
+    pinMode(_sdn, OUTPUT);
+    pinMode(_irq, INPUT);
+    pinMode(_gp0, INPUT);
+    pinMode(_gp1, INPUT);
+    pinMode(_gp2, INPUT);
+    pinMode(_gp3, INPUT);
+    this->_cts = this->_irq;
+
+    this->spi->begin();
+    this->spi->setClockDivider(SPI_CLOCK_DIV32);
+
+    // hold the chip in reset, it restarts when SDN goes low
+    this->shutdown(true);
+}
+
 void Si4463::applyRadioConfig()
 {
     // TODO: maybe add checking?
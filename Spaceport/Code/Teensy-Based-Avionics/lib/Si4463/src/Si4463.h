@@ -182,6 +182,24 @@ public:
     */
     bool begin(const uint8_t *config, uint32_t length);
     /*
+    Starts the same bring up as begin() without blocking, beginStep() must then be called until it returns BEGIN_DONE or BEGIN_FAILED
+    The chip is released from reset before returning, so its power on reset runs while the caller does other work. The wake, NOP and
+    POWER_UP waits after it are polled instead of spun on
+    */
+    void startBegin();
+    /*
+    Wraps setting a user specified WDS config before startBegin(), rather than using the default
+    - config : the configuration array (from header file)
+    - length : the length of the configuration array
+    */
+    void startBegin(const uint8_t *config, uint32_t length);
+    /*
+    Advances the bring up started by startBegin() by at most one stage. Once POWER_UP has finished the configuration is sent over
+    three calls (part check and thresholds, the WDS config, then the modem config), each blocking on its commands' CTS waits
+    Returns: the current stage of the bring up
+    */
+    Si4463BeginStage beginStep();
+    /*
     Similar to tx(), but starts transmitting without all the bytes available yet
     Remaining bytes need to be made available via writeTXBuf()
     - data : the data to start transmitting with
@@ -364,6 +382,10 @@ public:
     */
     void powerOn();
     /*
+    Sends the POWER_UP command without waiting for it to finish, used by powerOn() and beginStep()
+    */
+    void sendPowerUp();
+    /*
     Completes the Image Rejection Calibration sequence, currently non-functional
     */
     void performIRCAL();
@@ -449,6 +471,10 @@ private:
     bool RXFullFlag = false;
     // force use of SPI CTS until GPIO is setup
     bool useSPICTS = true;
+    // the stage of the non-blocking bring up
+    Si4463BeginStage beginStage = BEGIN_IDLE;
+    // when the current bring up stage started, ms
+    uint32_t beginTimer = 0;
 
     // abstractions of low level SPI operations
     /*
@@ -518,6 +544,24 @@ private:
     Applies the config from WDS from a header file generated by compileHeaders.py
     */
     void applyWDSConfig(bool applyDefault = true);
+    /*
+    Sets up the pins and SPI bus and puts the chip into shutdown, the first step of begin()
+    */
+    void setupPins();
+    /*
+    Checks communication with the powered up chip and sends the hardware configuration, the last step of begin()
+    Returns: whether the radio responded with the correct part number
+    */
+    bool configure();
+    /*
+    The first part of configure(), clears interrupts, checks the part number and sets the global config and FIFO thresholds
+    Returns: whether the radio responded with the correct part number
+    */
+    bool configureChip();
+    /*
+    The last part of configure(), after the WDS config: modem, power, AFC, pins, FRRs and packet config, then idle
+    */
+    void configureModem();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "AttitudeFilter.h"
+#include <math.h>
+
+namespace mmfs {
+
+constexpr double AttitudeFilter::GRAVITY;
+constexpr double AttitudeFilter::ACCEL_GATE;
+constexpr double AttitudeFilter::MAX_BIAS;
+
+static void cross(const double *a, const double *b, double *out) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static double dot(const double *a, const double *b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+// scales v to unit length, returns false and leaves it alone if it's zero
+static bool normalize(double *v) {
+    double n = sqrt(dot(v, v));
+    if (!(n > 0))
+        return false;
+    double inv = 1 / n;
+    v[0] *= inv;
+    v[1] *= inv;
+    v[2] *= inv;
+    return true;
+}
+
+AttitudeFilter::AttitudeFilter(double kp, double ki) : kp(kp), ki(ki) {}
+
+void AttitudeFilter::initialize() {
+    q[0] = 1;
+    q[1] = q[2] = q[3] = 0;
+    integral[0] = integral[1] = integral[2] = 0;
+    aligned = false;
+}
+
+void AttitudeFilter::getGyroBias(double *bias) const {
+    for (int i = 0; i < 3; i++)
+        bias[i] = -integral[i];
+}
+
+void AttitudeFilter::getEuler(double *euler) const {
+    const double w = q[0], x = q[1], y = q[2], z = q[3];
+    const double toDeg = 180 / M_PI;
+    double sinPitch = 2 * (w * y - z * x);
+    sinPitch = sinPitch > 1 ? 1 : (sinPitch < -1 ? -1 : sinPitch);
+    euler[0] = atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y)) * toDeg;
+    euler[1] = asin(sinPitch) * toDeg;
+    euler[2] = atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z)) * toDeg;
+}
+
+// v + 2w (u x v) + 2 u x (u x v) with u the vector part, cheaper than the rotation matrix for one vector
+void AttitudeFilter::rotate(const double *body, double *earth) const {
+    const double *u = q + 1;
+    double t[3], c[3];
+    cross(u, body, t);
+    for (int i = 0; i < 3; i++)
+        t[i] *= 2;
+    cross(u, t, c);
+    for (int i = 0; i < 3; i++)
+        earth[i] = body[i] + q[0] * t[i] + c[i];
+}
+
+void AttitudeFilter::rotateInverse(const double *earth, double *body) const {
+    const double u[3] = {-q[1], -q[2], -q[3]};
+    double t[3], c[3];
+    cross(u, earth, t);
+    for (int i = 0; i < 3; i++)
+        t[i] *= 2;
+    cross(u, t, c);
+    for (int i = 0; i < 3; i++)
+        body[i] = earth[i] + q[0] * t[i] + c[i];
+}
+
+void AttitudeFilter::getLinearAcceleration(const double *accel, double *earth) const {
+    if (!aligned) {
+        earth[0] = earth[1] = earth[2] = 0;
+        return;
+    }
+    rotate(accel, earth);
+    earth[2] -= GRAVITY;
+}
+
+// Starts from the attitude the accelerometer and magnetometer give directly instead of waiting for the feedback to
+// converge. The rows of the body to earth rotation are east, north and up seen from the body.
+void AttitudeFilter::align(const double *accel, const double *mag) {
+    double up[3] = {accel[0], accel[1], accel[2]};
+    if (!normalize(up))
+        return;
+    double east[3];
+    if (mag)
+        cross(mag, up, east);
+    if (!mag || !normalize(east)) {
+        // no heading, any horizontal direction will do
+        const double x[3] = {1, 0, 0}, y[3] = {0, 1, 0};
+        cross(fabs(up[0]) < 0.9 ? x : y, up, east);
+        normalize(east);
+    }
+    double north[3];
+    cross(up, east, north);
+
+    const double *r[3] = {east, north, up};
+    double trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0) {
+        double s = sqrt(trace + 1) * 2;
+        q[0] = 0.25 * s;
+        q[1] = (r[2][1] - r[1][2]) / s;
+        q[2] = (r[0][2] - r[2][0]) / s;
+        q[3] = (r[1][0] - r[0][1]) / s;
+    } else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        double s = sqrt(1 + r[0][0] - r[1][1] - r[2][2]) * 2;
+        q[0] = (r[2][1] - r[1][2]) / s;
+        q[1] = 0.25 * s;
+        q[2] = (r[0][1] + r[1][0]) / s;
+        q[3] = (r[0][2] + r[2][0]) / s;
+    } else if (r[1][1] > r[2][2]) {
+        double s = sqrt(1 + r[1][1] - r[0][0] - r[2][2]) * 2;
+        q[0] = (r[0][2] - r[2][0]) / s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = 0.25 * s;
+        q[3] = (r[1][2] + r[2][1]) / s;
+    } else {
+        double s = sqrt(1 + r[2][2] - r[0][0] - r[1][1]) * 2;
+        q[0] = (r[1][0] - r[0][1]) / s;
+        q[1] = (r[0][2] + r[2][0]) / s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+        q[3] = 0.25 * s;
+    }
+    aligned = true;
+}
+
+void AttitudeFilter::update(double dt, const double *gyro, const double *accel, const double *mag) {
+    double a[3] = {accel[0], accel[1], accel[2]};
+    double aNorm = sqrt(dot(a, a));
+    bool accelOK = fabs(aNorm - GRAVITY) < ACCEL_GATE * GRAVITY;
+
+    // Nothing to correct before there's an attitude, the first reading in the gate aligns it. Running the feedback on
+    // the initial identity would wind the bias integral up against a heading that was never measured.
+    if (!aligned) {
+        if (accelOK)
+            align(accel, mag);
+        return;
+    }
+
+    // body up as the filter sees it, the last row of the rotation matrix
+    const double w = q[0], x = q[1], y = q[2], z = q[3];
+    const double up[3] = {2 * (x * z - w * y), 2 * (y * z + w * x), w * w - x * x - y * y + z * z};
+
+    // rotation that would carry the estimated directions onto the measured ones, in the body frame
+    double e[3] = {0, 0, 0};
+    if (accelOK) {
+        for (int i = 0; i < 3; i++)
+            a[i] /= aNorm;
+        cross(a, up, e);
+    }
+    double m[3] = {0, 0, 0};
+    if (mag) {
+        m[0] = mag[0];
+        m[1] = mag[1];
+        m[2] = mag[2];
+    }
+    if (mag && normalize(m)) {
+        // In the earth frame the horizontal part of the field should point north, the sine of the angle it's off by is
+        // the heading error. Only the horizontal part counts, so a steep field still corrects at full gain.
+        double h[3];
+        rotate(m, h);
+        double horizontal = sqrt(h[0] * h[0] + h[1] * h[1]);
+        if (horizontal > 0.05) {
+            double heading = h[0] / horizontal;
+            for (int i = 0; i < 3; i++)
+                e[i] += heading * up[i];
+        }
+    }
+
+    double omega[3];
+    for (int i = 0; i < 3; i++) {
+        if (ki > 0) {
+            integral[i] += ki * e[i] * dt;
+            integral[i] = integral[i] > MAX_BIAS ? MAX_BIAS : (integral[i] < -MAX_BIAS ? -MAX_BIAS : integral[i]);
+        }
+        omega[i] = gyro[i] + integral[i] + kp * e[i];
+    }
+
+    // q += q * (0, omega) * dt / 2
+    double h = 0.5 * dt;
+    double nw = w + h * (-x * omega[0] - y * omega[1] - z * omega[2]);
+    double nx = x + h * (w * omega[0] + y * omega[2] - z * omega[1]);
+    double ny = y + h * (w * omega[1] - x * omega[2] + z * omega[0]);
+    double nz = z + h * (w * omega[2] + x * omega[1] - y * omega[0]);
+    double inv = 1 / sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+    q[0] = nw * inv;
+    q[1] = nx * inv;
+    q[2] = ny * inv;
+    q[3] = nz * inv;
+}
+
+} // namespace mmfs
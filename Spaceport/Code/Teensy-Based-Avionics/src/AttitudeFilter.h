@@ -0,0 +1,63 @@
+#ifndef ATTITUDE_FILTER_H
+#define ATTITUDE_FILTER_H
+
+namespace mmfs
+{
+
+    // Quaternion attitude from the gyro, accelerometer and magnetometer, meant to run on every IMU sample. It's a
+    // Mahony style complementary filter: the gyro is integrated and the drift is pulled out with a proportional and
+    // integral feedback from the error between where the filter thinks up and north are and where the accelerometer
+    // and magnetometer see them. The state is a quaternion and a gyro bias, so a step does no heap allocation and no
+    // matrix math.
+    // - The accelerometer only measures up when the rocket isn't accelerating, so it's ignored whenever its magnitude is
+    //   more than ACCEL_GATE away from 1 g (boost, deployment).
+    // - The magnetometer only corrects heading, it never tilts the estimate.
+    // The earth frame is x east, y magnetic north, z up, and the quaternion rotates body vectors into it.
+    class AttitudeFilter
+    {
+    public:
+        static constexpr double GRAVITY = 9.80665;    // m/s^2
+        static constexpr double ACCEL_GATE = 0.1;     // fraction of 1 g
+        static constexpr double MAX_BIAS = 0.1;       // rad/s, the bias estimate is limited to this per axis
+
+        // kp (1/s) sets how fast the estimate is pulled toward the accelerometer and magnetometer, ki (1/s^2) how fast
+        // the gyro bias is learned
+        AttitudeFilter(double kp = 1.0, double ki = 0.05);
+
+        // forgets the attitude and bias, the next update() aligns to the accelerometer and magnetometer again
+        void initialize();
+
+        // one IMU sample, dt in s
+        // - gyro : rad/s
+        // - accel : m/s^2, specific force (reads +1 g up when at rest)
+        // - mag : any units, nullptr if there's no reading
+        void update(double dt, const double *gyro, const double *accel, const double *mag);
+
+        bool isAligned() const { return aligned; }
+        // w, x, y, z
+        const double *getQuaternion() const { return q; }
+        // rad/s per body axis
+        void getGyroBias(double *bias) const;
+        // roll, pitch, yaw in degrees (ZYX), yaw from east toward north
+        void getEuler(double *euler) const;
+        // body to earth
+        void rotate(const double *body, double *earth) const;
+        // earth to body
+        void rotateInverse(const double *earth, double *body) const;
+        // an accelerometer reading (specific force) as the acceleration in the earth frame, gravity taken out. Zeros
+        // until the filter is aligned, a reading in no frame at all would integrate the 1 g into a drift
+        void getLinearAcceleration(const double *accel, double *earth) const;
+
+    private:
+        void align(const double *accel, const double *mag);
+
+        double kp;
+        double ki;
+        double q[4] = {1, 0, 0, 0};
+        double integral[3] = {0}; // integral feedback, minus the gyro bias
+        bool aligned = false;
+    };
+
+} // namespace mmfs
+
+#endif // ATTITUDE_FILTER_H
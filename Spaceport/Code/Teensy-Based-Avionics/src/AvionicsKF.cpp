@@ -2,61 +2,196 @@
 
 namespace mmfs {
 
-// Define the measurement size, control size, and state size
-AvionicsKF::AvionicsKF() : LinearKalmanFilter(3, 3, 6) {}
-
-Matrix AvionicsKF::getF(double dt) {
-    double *data = new double[36]{
-        1.0, 0, 0, dt, 0, 0,
-        0, 1.0, 0, 0, dt, 0,
-        0, 0, 1.0, 0, 0, dt,
-        0, 0, 0, 1.0, 0, 0,
-        0, 0, 0, 0, 1.0, 0,
-        0, 0, 0, 0, 0, 1.0
-    };
-    return Matrix(6, 6, data);
-}
-
-Matrix AvionicsKF::getG(double dt) {
-    double *data = new double[18]{
-        0.5 * dt * dt, 0, 0,
-        0, 0.5 * dt * dt, 0,
-        0, 0, 0.5 * dt * dt,
-        dt, 0, 0,
-        0, dt, 0,
-        0, 0, dt
-    };
-    return Matrix(6, 3, data);
-}
-
-Matrix AvionicsKF::getH() {
-    double *data = new double[18]{
-        1.0, 0, 0, 0, 0, 0,
-        0, 1.0, 0, 0, 0, 0,
-        0, 0, 1.0, 0, 0, 0
-    };
-    return Matrix(3, 6, data);
-}
-
-Matrix AvionicsKF::getR() {
-    double *data = new double[9]{
-        1.0, 0, 0,
-        0, 1.0, 0,
-        0, 0, 0.5
-    };
-    return Matrix(3, 3, data);
-}
-
-Matrix AvionicsKF::getQ(double dt) {
-    double *data = new double[36]{
-        0.1, 0, 0, 0, 0, 0,
-        0, 0.1, 0, 0, 0, 0,
-        0, 0, 0.1, 0, 0, 0,
-        0, 0, 0, 0.1, 0, 0,
-        0, 0, 0, 0, 0.1, 0,
-        0, 0, 0, 0, 0, 0.1
-    };
-    return Matrix(6, 6, data);
+constexpr StaticMatrix<AvionicsKF::MEAS_SIZE, AvionicsKF::STATE_SIZE> AvionicsKF::H;
+constexpr StaticMatrix<AvionicsKF::MEAS_SIZE, AvionicsKF::MEAS_SIZE> AvionicsKF::R;
+constexpr AvionicsKF::StateMatrix AvionicsKF::Q;
+constexpr double AvionicsKF::Q_INTERVAL;
+
+// the decoupled mode relies on every axis being independent: H picks out each position and R and Q are diagonal
+static constexpr bool isAxisDecoupled() {
+    for (int i = 0; i < AvionicsKF::MEAS_SIZE; i++)
+        for (int j = 0; j < AvionicsKF::STATE_SIZE; j++)
+            if (AvionicsKF::H(i, j) != (i == j ? 1.0 : 0.0))
+                return false;
+    for (int i = 0; i < AvionicsKF::MEAS_SIZE; i++)
+        for (int j = 0; j < AvionicsKF::MEAS_SIZE; j++)
+            if (i != j && AvionicsKF::R(i, j) != 0)
+                return false;
+    for (int i = 0; i < AvionicsKF::STATE_SIZE; i++)
+        for (int j = 0; j < AvionicsKF::STATE_SIZE; j++)
+            if (i != j && AvionicsKF::Q(i, j) != 0)
+                return false;
+    return true;
+}
+static_assert(isAxisDecoupled(), "AvionicsKF's decoupled mode needs H = [I 0] and diagonal R and Q");
+
+AvionicsKF::AvionicsKF(AvionicsKFMode mode) : mode(mode) { initialize(); }
+
+void AvionicsKF::initialize() {
+    P = StateMatrix::identity();
+    for (int i = 0; i < MEAS_SIZE; i++)
+        axes[i] = {1.0, 0, 1.0};
+}
+
+void AvionicsKF::setMode(AvionicsKFMode newMode) {
+    if (newMode == mode)
+        return;
+    if (newMode == KF_FULL)
+        P = getP();
+    else
+        for (int i = 0; i < MEAS_SIZE; i++)
+            axes[i] = {P(i, i), P(i, i + MEAS_SIZE), P(i + MEAS_SIZE, i + MEAS_SIZE)};
+    mode = newMode;
+}
+
+AvionicsKF::StateMatrix AvionicsKF::getP() const {
+    if (mode == KF_FULL)
+        return P;
+    StateMatrix out = StateMatrix::zeros();
+    for (int i = 0; i < MEAS_SIZE; i++) {
+        out(i, i) = axes[i].p00;
+        out(i, i + MEAS_SIZE) = out(i + MEAS_SIZE, i) = axes[i].p01;
+        out(i + MEAS_SIZE, i + MEAS_SIZE) = axes[i].p11;
+    }
+    return out;
+}
+
+// only the dt terms change, the identity and zeros are set once
+void AvionicsKF::updateF(double dt) {
+    F(0, 3) = dt;
+    F(1, 4) = dt;
+    F(2, 5) = dt;
+}
+
+void AvionicsKF::updateG(double dt) {
+    for (int i = 0; i < CTRL_SIZE; i++) {
+        G(i, i) = 0.5 * dt * dt;
+        G(i + CTRL_SIZE, i) = dt;
+    }
+}
+
+void AvionicsKF::iterate(double dt, double *state, const double *measurement, const double *control) {
+    if (mode == KF_DECOUPLED)
+        iterateDecoupled(dt, state, measurement, control);
+    else
+        iterateFull(dt, state, measurement, control);
+}
+
+void AvionicsKF::iterateFull(double dt, double *state, const double *measurement, const double *control) {
+    updateF(dt);
+    updateG(dt);
+
+    StaticMatrix<STATE_SIZE, 1> X;
+    StaticMatrix<CTRL_SIZE, 1> U;
+    StaticMatrix<MEAS_SIZE, 1> Z;
+    for (int i = 0; i < STATE_SIZE; i++)
+        X.data[i] = state[i];
+    for (int i = 0; i < CTRL_SIZE; i++)
+        U.data[i] = control[i];
+    for (int i = 0; i < MEAS_SIZE; i++)
+        Z.data[i] = measurement[i];
+
+    // predict. The state is one fused loop into X (see MatrixExpr.h). The covariance stays on the eager operators: P is
+    // both the destination and inside F P, so the fused chain needs the same 6x6 temporary and measured slower (0.91x)
+    X = lazy(F) * X + lazy(G) * U;
+    P = F * P * F.transpose() + Q;
+
+    // update, K = P Ht S^-1 is found by solving K S = P Ht instead of inverting S. R keeps S positive definite so the
+    // factorization only fails on garbage input, keep the prediction if it does.
+    StaticMatrix<STATE_SIZE, MEAS_SIZE> K;
+    StaticMatrix<MEAS_SIZE, MEAS_SIZE> S;
+    K = lazy(P) * transpose(H);
+    S = lazy(H) * K + R;
+    if (choleskyFactor(S)) {
+        choleskySolveRight(S, K);
+        X += lazy(K) * (Z - lazy(H) * X);
+        // (I - K H) P written as P - K (H P), H P is only 3 rows and P is updated in place
+        P -= lazy(K) * (lazy(H) * P);
+    }
+
+    for (int i = 0; i < STATE_SIZE; i++)
+        state[i] = X.data[i];
+}
+
+// the full filter written out for one axis, the innovation is a scalar so the gain is a division
+void AvionicsKF::iterateDecoupled(double dt, double *state, const double *measurement, const double *control) {
+    predictDecoupled(dt, state, control, 1.0);
+    for (int i = 0; i < MEAS_SIZE; i++)
+        updateDecoupled(i, state, measurement[i]);
+}
+
+void AvionicsKF::predict(double dt, double *state, const double *control) {
+    double qScale = dt / Q_INTERVAL;
+    if (mode == KF_DECOUPLED) {
+        predictDecoupled(dt, state, control, qScale);
+        return;
+    }
+
+    updateF(dt);
+    updateG(dt);
+    StaticMatrix<STATE_SIZE, 1> X;
+    StaticMatrix<CTRL_SIZE, 1> U;
+    for (int i = 0; i < STATE_SIZE; i++)
+        X.data[i] = state[i];
+    for (int i = 0; i < CTRL_SIZE; i++)
+        U.data[i] = control[i];
+    X = lazy(F) * X + lazy(G) * U;
+    P = F * P * F.transpose() + Q * qScale;
+    for (int i = 0; i < STATE_SIZE; i++)
+        state[i] = X.data[i];
+}
+
+// with diagonal R, one scalar update per axis in sequence is the same as the batch update
+void AvionicsKF::update(int axis, double *state, double measurement) {
+    if (mode == KF_DECOUPLED) {
+        updateDecoupled(axis, state, measurement);
+        return;
+    }
+
+    // H only picks out this axis' position, so PHt is a column of P and the innovation covariance is a scalar
+    double s = P(axis, axis) + R(axis, axis);
+    if (s <= 0)
+        return;
+    double K[STATE_SIZE];
+    double row[STATE_SIZE];
+    for (int i = 0; i < STATE_SIZE; i++) {
+        K[i] = P(i, axis) / s;
+        row[i] = P(axis, i);
+    }
+    double y = measurement - state[axis];
+    for (int i = 0; i < STATE_SIZE; i++) {
+        state[i] += K[i] * y;
+        for (int j = 0; j < STATE_SIZE; j++)
+            P(i, j) -= K[i] * row[j];
+    }
+}
+
+void AvionicsKF::predictDecoupled(double dt, double *state, const double *control, double qScale) {
+    for (int i = 0; i < MEAS_SIZE; i++) {
+        AxisCovariance &c = axes[i];
+        double &pos = state[i];
+        double &vel = state[i + MEAS_SIZE];
+        pos += vel * dt + 0.5 * dt * dt * control[i];
+        vel += dt * control[i];
+        c.p00 = c.p00 + dt * (2 * c.p01 + dt * c.p11) + Q(i, i) * qScale;
+        c.p01 = c.p01 + dt * c.p11;
+        c.p11 = c.p11 + Q(i + MEAS_SIZE, i + MEAS_SIZE) * qScale;
+    }
+}
+
+void AvionicsKF::updateDecoupled(int axis, double *state, double measurement) {
+    AxisCovariance &c = axes[axis];
+    double s = c.p00 + R(axis, axis);
+    if (s <= 0)
+        return;
+    double k0 = c.p00 / s;
+    double k1 = c.p01 / s;
+    double y = measurement - state[axis];
+    state[axis] += k0 * y;
+    state[axis + MEAS_SIZE] += k1 * y;
+    c.p11 = c.p11 - k1 * c.p01;
+    c.p00 = (1 - k0) * c.p00;
+    c.p01 = (1 - k0) * c.p01;
 }
 
 } // namespace mmfs
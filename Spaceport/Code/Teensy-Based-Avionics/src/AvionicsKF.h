@@ -1,24 +1,94 @@
 #ifndef AVIONICS_KF_H
 #define AVIONICS_KF_H
 
-#include "../src/Filters/LinearKalmanFilter.h"
+#include "StaticMatrix.h"
 
 namespace mmfs
 {
 
-    class AvionicsKF : public LinearKalmanFilter
+    enum AvionicsKFMode
+    {
+        KF_FULL,      // the 6 state filter with full matrix products and a Cholesky solve for the gain
+        KF_DECOUPLED, // three independent 2 state position/velocity filters updated in closed form
+    };
+
+    // Position/velocity Kalman filter for the avionics state, with GPS/barometer position as the measurement and the
+    // gravity free earth frame acceleration as the control input, both in the GPS displacement's axes. Every matrix is
+    // fixed size and owned by the filter, so a step does no heap allocation; F and G are rewritten in place for each dt
+    // and H, R and Q are compile time constants. The full mode's state predict, gain and covariance update are lazy
+    // expressions evaluated straight into their destinations, the covariance predict is eager.
+    // Every matrix is block diagonal per axis, so the decoupled mode gives the same estimate as the full one for a
+    // fraction of the work, it is the default.
+    class AvionicsKF
     {
     public:
-        AvionicsKF();
-        ~AvionicsKF() = default;
-
-        // Override getter methods to provide subteam-specific matrix implementations
-        void initialize() override {};
-        Matrix getF(double dt) override;
-        Matrix getG(double dt) override;
-        Matrix getH() override;
-        Matrix getR() override;
-        Matrix getQ(double dt) override;
+        static constexpr int MEAS_SIZE = 3;
+        static constexpr int CTRL_SIZE = 3;
+        static constexpr int STATE_SIZE = 6;
+
+        typedef StaticMatrix<STATE_SIZE, STATE_SIZE> StateMatrix;
+
+        AvionicsKF(AvionicsKFMode mode = KF_DECOUPLED);
+
+        // resets the covariance
+        void initialize();
+
+        // the covariance carries over, so the mode can be changed between steps
+        void setMode(AvionicsKFMode mode);
+        AvionicsKFMode getMode() const { return mode; }
+
+        // runs one predict and update step, state is read as the previous estimate and overwritten with the new one
+        // - state : px, py, pz, vx, vy, vz
+        // - measurement : px, py, pz
+        // - control : ax, ay, az
+        void iterate(double dt, double *state, const double *measurement, const double *control);
+
+        // Split steps for running at different rates: predict() at the IMU rate and update() with each new
+        // GPS/barometer sample. Unlike iterate(), predict() scales Q by dt / Q_INTERVAL so the covariance grows at
+        // the same rate per second however often it runs.
+        void predict(double dt, double *state, const double *control);
+        // scalar position update on one axis (0-2 for x, y, z), no matrix inverse in either mode
+        void update(int axis, double *state, double measurement);
+
+        StateMatrix getP() const;
+
+        static constexpr StaticMatrix<MEAS_SIZE, STATE_SIZE> H = {{
+            1.0, 0, 0, 0, 0, 0,
+            0, 1.0, 0, 0, 0, 0,
+            0, 0, 1.0, 0, 0, 0,
+        }};
+        static constexpr StaticMatrix<MEAS_SIZE, MEAS_SIZE> R = {{
+            1.0, 0, 0,
+            0, 1.0, 0,
+            0, 0, 0.5,
+        }};
+        static constexpr StateMatrix Q = StateMatrix::diagonal(0.1);
+        // Q was tuned for one iterate() per 10 Hz update
+        static constexpr double Q_INTERVAL = 0.1;
+
+    private:
+        // covariance of one axis, [p00 p01; p01 p11] over position and velocity
+        struct AxisCovariance
+        {
+            double p00;
+            double p01;
+            double p11;
+        };
+
+        void iterateFull(double dt, double *state, const double *measurement, const double *control);
+        void iterateDecoupled(double dt, double *state, const double *measurement, const double *control);
+        void predictDecoupled(double dt, double *state, const double *control, double qScale);
+        void updateDecoupled(int axis, double *state, double measurement);
+        void updateF(double dt);
+        void updateG(double dt);
+
+        AvionicsKFMode mode;
+        // only the decoupled mode's covariance is kept up to date in that mode, and only P in the full mode
+        AxisCovariance axes[MEAS_SIZE];
+
+        StateMatrix F = StateMatrix::identity();
+        StaticMatrix<STATE_SIZE, CTRL_SIZE> G = StaticMatrix<STATE_SIZE, CTRL_SIZE>::zeros();
+        StateMatrix P;
     };
 
 } // namespace mmfs
@@ -0,0 +1,81 @@
+#include "AvionicsScheduler.h"
+
+bool AvionicsScheduler::addTask(const char *name, TaskFn run, uint32_t period, uint32_t deadline, uint8_t priority, uint32_t offset)
+{
+    if (numTasks == MAX_TASKS || period == 0)
+        return false;
+    tasks[numTasks++] = {name, run, period, deadline, priority, offset, 0, 0, 0, 0, 0, 0};
+    return true;
+}
+
+bool AvionicsScheduler::update()
+{
+    uint32_t now = micros();
+    // release everything relative to the first update, setup() can take a while
+    if (!started)
+    {
+        started = true;
+        for (int i = 0; i < numTasks; i++)
+            tasks[i].release += now;
+    }
+
+    // times are compared as differences so micros() can wrap
+    SchedulerTask *next = nullptr;
+    for (int i = 0; i < numTasks; i++)
+    {
+        SchedulerTask &t = tasks[i];
+        if ((int32_t)(now - t.release) < 0)
+            continue;
+        if (next == nullptr || t.priority < next->priority ||
+            (t.priority == next->priority && (int32_t)((t.release + t.deadline) - (next->release + next->deadline)) < 0))
+            next = &t;
+    }
+    if (next == nullptr)
+        return false;
+
+    uint32_t start = micros();
+    next->run();
+    uint32_t end = micros();
+
+    uint32_t jitter = start - next->release;
+    uint32_t duration = end - start;
+    next->runs++;
+    next->totalJitter += jitter;
+    if (jitter > next->maxJitter)
+        next->maxJitter = jitter;
+    if (duration > next->maxDuration)
+        next->maxDuration = duration;
+    if (end - next->release > next->deadline)
+        next->overruns++;
+
+    // fixed rate, but releases that were missed entirely are dropped instead of run back to back
+    next->release += next->period;
+    while ((int32_t)(end - next->release) >= 0)
+    {
+        next->release += next->period;
+        next->skipped++;
+    }
+    return true;
+}
+
+void AvionicsScheduler::resetStats()
+{
+    for (int i = 0; i < numTasks; i++)
+    {
+        SchedulerTask &t = tasks[i];
+        t.runs = t.overruns = t.skipped = t.maxJitter = t.maxDuration = 0;
+        t.totalJitter = 0;
+    }
+}
+
+void AvionicsScheduler::printStats()
+{
+    Serial.println("Task            Runs  Overrun  Skipped  AvgJit(us)  MaxJit(us)  MaxDur(us)");
+    for (int i = 0; i < numTasks; i++)
+    {
+        const SchedulerTask &t = tasks[i];
+        Serial.printf("%-14s %5lu %8lu %8lu %11lu %11lu %11lu\n", t.name, (unsigned long)t.runs, (unsigned long)t.overruns,
+                      (unsigned long)t.skipped, (unsigned long)(t.runs > 0 ? t.totalJitter / t.runs : 0),
+                      (unsigned long)t.maxJitter, (unsigned long)t.maxDuration);
+    }
+}
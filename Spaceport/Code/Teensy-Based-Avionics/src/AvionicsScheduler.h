@@ -0,0 +1,50 @@
+#ifndef AVIONICSSCHEDULER_H
+#define AVIONICSSCHEDULER_H
+
+#include <Arduino.h>
+
+typedef void (*TaskFn)();
+
+struct SchedulerTask
+{
+    const char *name;
+    TaskFn run;
+    uint32_t period;   // us between releases
+    uint32_t deadline; // us after release the task has to finish by
+    uint8_t priority;  // 0 is the most urgent
+    uint32_t release;  // next release time (us)
+
+    // stats since the last resetStats()
+    uint32_t runs;
+    uint32_t overruns;     // runs that finished after their deadline
+    uint32_t skipped;      // releases dropped because the task was still behind
+    uint32_t maxJitter;    // us from release to start
+    uint64_t totalJitter;  // us
+    uint32_t maxDuration;  // us
+};
+
+// Cooperative scheduler for the main loop, each update() runs the most urgent released task
+// so a slow task only delays the others until it returns, then the high priority tasks go first.
+// It is non-preemptive: one task per loop() pass and a running task is never interrupted, so a
+// deadline is only measured. A task that finishes late is counted as an overrun, nothing stops it.
+class AvionicsScheduler
+{
+public:
+    static const uint8_t MAX_TASKS = 12;
+
+    // offset delays the first release relative to the others, releases start on the first update()
+    bool addTask(const char *name, TaskFn run, uint32_t period, uint32_t deadline, uint8_t priority, uint32_t offset = 0);
+    // runs the released task with the highest priority, then earliest deadline, returns whether one ran
+    bool update();
+    void resetStats();
+    void printStats();
+    int getNumTasks() const { return numTasks; }
+    const SchedulerTask &getTask(int i) const { return tasks[i]; }
+
+private:
+    SchedulerTask tasks[MAX_TASKS];
+    int numTasks = 0;
+    bool started = false;
+};
+
+#endif // AVIONICSSCHEDULER_H
@@ -3,18 +3,262 @@
 
 using namespace mmfs;
 
-AvionicsState::AvionicsState(Sensor **sensors, int numSensors, LinearKalmanFilter *kfilter) : State(sensors, numSensors, kfilter)
+// the filter is run here instead of by State, whose LinearKalmanFilter path builds heap Matrix objects every update
+// the attitude filter is optional, without it orientation is whatever State sets
+// apogee waits 25 s after coasting, the same as determineStage()
+AvionicsState::AvionicsState(Sensor **sensors, int numSensors, AvionicsKF *kfilter, AttitudeFilter *afilter) : State(sensors, numSensors, nullptr), kfilter(kfilter), afilter(afilter), events(25)
 {
     stage = 0;
     timeOfLaunch = 0;
     timeOfLastStage = 0;
     insertColumn(1, INT, &stage, "Stage");
     consecutiveNegativeBaroVelocity = 0;
+    if (afilter)
+    {
+        addColumn(DOUBLE, &attitude[0], "Roll (deg)");
+        addColumn(DOUBLE, &attitude[1], "Pitch (deg)");
+        addColumn(DOUBLE, &attitude[2], "Yaw (deg)");
+    }
 }
 
 void AvionicsState::updateVariables() {
     State::updateVariables();
     imuVelocity += acceleration.magnitude() * UPDATE_INTERVAL;
+    // the attitude goes first, updateFilter() takes its control input from it
+    if (afilter && !highRateEstimator)
+    {
+        IMU *imu = reinterpret_cast<IMU *>(getSensor("IMU"_i));
+        double dt = lastAttitudeTime > 0 ? currentTime - lastAttitudeTime : 0;
+        lastAttitudeTime = currentTime;
+        if (sensorOK(imu))
+            updateAttitude(imu, dt);
+    }
+    if (kfilter && highRateEstimator && estimatorRan)
+    {
+        // the estimate is kept by updateEstimator(), put it back over whatever State set
+        position = Vector<3>(filterState[0], filterState[1], filterState[2]);
+        velocity = Vector<3>(filterState[3], filterState[4], filterState[5]);
+        lastFilterTime = currentTime;
+    }
+    else if (kfilter)
+    {
+        // also the fallback while updateEstimator() is skipping samples (IMU dropout), so the estimate keeps moving
+        updateFilter();
+        // updateEstimator() predicts from here when it picks back up instead of over the time just covered
+        if (highRateEstimator)
+            lastEstimatorTime = micros();
+    }
+    estimatorRan = false;
+
+    if (afilter && afilter->isAligned())
+    {
+        const double *q = afilter->getQuaternion();
+        orientation = Quaternion(q[0], q[1], q[2], q[3]);
+    }
+}
+
+void AvionicsState::updateEstimator()
+{
+    IMU *imu = reinterpret_cast<IMU *>(getSensor("IMU"_i));
+    if (!kfilter || !highRateEstimator || !sensorOK(imu))
+        return;
+    GPS *gps = reinterpret_cast<GPS *>(getSensor("GPS"_i));
+    Barometer *baro = reinterpret_cast<Barometer *>(getSensor("Barometer"_i));
+
+    uint32_t now = micros();
+    double dt = lastEstimatorTime != 0 ? (now - lastEstimatorTime) / 1e6 : 0;
+    lastEstimatorTime = now;
+    double time = millis() / 1000.0;
+    estimatorRan = true;
+
+    // only a fresh sample from the chip, IMU::update()'s processing (bias windows, orientation, global acceleration)
+    // assumes it runs once per state update and is left to sys.update()
+    imu->read();
+    if (afilter)
+        updateAttitude(imu, dt);
+
+    // the detector checks the same signals as determineStage(), the earth frame reading with gravity still in it
+    double detected[3];
+    if (afilter && afilter->isAligned())
+    {
+        // the sample into the earth frame with this rate's attitude
+        Vector<3> a = imu->getAcceleration();
+        double body[3] = {a.x(), a.y(), a.z()};
+        afilter->rotate(body, detected);
+    }
+    else
+    {
+        // no attitude at this rate, the global acceleration from the last state update is the best there is
+        Vector<3> a = imu->getAccelerationGlobal();
+        detected[0] = a.x();
+        detected[1] = a.y();
+        detected[2] = a.z();
+    }
+    onFlightEvent(events.imuSample(time, detected), time);
+
+    double inputs[AvionicsKF::CTRL_SIZE];
+    controlInput(imu, inputs);
+    kfilter->predict(dt, filterState, inputs);
+
+    // GPS and barometer samples come in much slower than the IMU, a value that hasn't changed was already applied
+    if (sensorOK(gps))
+    {
+        Vector<3> disp = gps->getDisplacement();
+        if (disp.x() != lastGPS[0] || disp.y() != lastGPS[1])
+        {
+            kfilter->update(0, filterState, disp.x());
+            kfilter->update(1, filterState, disp.y());
+            lastGPS[0] = disp.x();
+            lastGPS[1] = disp.y();
+        }
+    }
+    if (sensorOK(baro) && baro->getAGLAltM() != lastBaro)
+    {
+        lastBaro = baro->getAGLAltM();
+        kfilter->update(2, filterState, lastBaro);
+        onFlightEvent(events.baroSample(time, lastBaro), time);
+    }
+
+    position = Vector<3>(filterState[0], filterState[1], filterState[2]);
+    velocity = Vector<3>(filterState[3], filterState[4], filterState[5]);
+}
+
+// one IMU sample into the attitude filter, every sample when the high rate estimator is on
+void AvionicsState::updateAttitude(IMU *imu, double dt)
+{
+    Vector<3> w = imu->getAngularVelocity();
+    Vector<3> a = imu->getAcceleration();
+    Vector<3> m = imu->getMagField();
+    double gyro[3] = {w.x(), w.y(), w.z()};
+    double accel[3] = {a.x(), a.y(), a.z()};
+    double mag[3] = {m.x(), m.y(), m.z()};
+    afilter->update(dt, gyro, accel, mag);
+    afilter->getEuler(attitude);
+}
+
+// The position filter's control input on every path, the latest IMU sample as the gravity free earth frame acceleration
+// from the attitude filter. The attitude filter's earth frame is x east, y north, so x and y are swapped into the order
+// of the GPS displacement, x from latitude (north) and y from longitude (east) like getPos(). Zeros without an aligned
+// attitude: MMFS's global acceleration still has gravity in it, in whatever frame its orientation is, so the filter
+// coasts on its velocity between measurements instead.
+void AvionicsState::controlInput(IMU *imu, double *inputs)
+{
+    double earth[3] = {0, 0, 0};
+    if (afilter && sensorOK(imu))
+    {
+        Vector<3> a = imu->getAcceleration();
+        double body[3] = {a.x(), a.y(), a.z()};
+        afilter->getLinearAcceleration(body, earth);
+    }
+    inputs[0] = earth[1];
+    inputs[1] = earth[0];
+    inputs[2] = earth[2];
+}
+
+void AvionicsState::updateFilter()
+{
+    GPS *gps = reinterpret_cast<GPS *>(getSensor("GPS"_i));
+    Barometer *baro = reinterpret_cast<Barometer *>(getSensor("Barometer"_i));
+    IMU *imu = reinterpret_cast<IMU *>(getSensor("IMU"_i));
+    double inputs[AvionicsKF::CTRL_SIZE];
+    controlInput(imu, inputs);
+
+    // nothing to predict from on the first update
+    double dt = lastFilterTime > 0 ? currentTime - lastFilterTime : 0;
+    lastFilterTime = currentTime;
+
+    if (sensorOK(gps) && sensorOK(baro))
+    {
+        // gps x y, barometer z
+        double measurements[AvionicsKF::MEAS_SIZE] = {
+            gps->getDisplacement().x(),
+            gps->getDisplacement().y(),
+            baro->getAGLAltM(),
+        };
+        kfilter->iterate(dt, filterState, measurements, inputs);
+    }
+    else
+    {
+        // an axis without a working sensor is only predicted, a 0 m measurement would pull it back to the pad
+        kfilter->predict(dt, filterState, inputs);
+        if (sensorOK(gps))
+        {
+            kfilter->update(0, filterState, gps->getDisplacement().x());
+            kfilter->update(1, filterState, gps->getDisplacement().y());
+        }
+        if (sensorOK(baro))
+            kfilter->update(2, filterState, baro->getAGLAltM());
+    }
+
+    // already applied, so updateEstimator() doesn't apply them again if it takes over
+    if (sensorOK(gps))
+    {
+        lastGPS[0] = gps->getDisplacement().x();
+        lastGPS[1] = gps->getDisplacement().y();
+    }
+    if (sensorOK(baro))
+        lastBaro = baro->getAGLAltM();
+
+    position = Vector<3>(filterState[0], filterState[1], filterState[2]);
+    velocity = Vector<3>(filterState[3], filterState[4], filterState[5]);
+}
+
+// launch, burnout and apogee as soon as the detector confirms them on a sample, determineStage() handles the rest
+void AvionicsState::onFlightEvent(FlightEvent event, double time)
+{
+    if (event == FLIGHT_EVENT_LAUNCH && stage == 0)
+        launch(time);
+    else if (event == FLIGHT_EVENT_BURNOUT && stage == 1)
+        coast(time);
+    else if (event == FLIGHT_EVENT_APOGEE && stage == 2)
+        apogee(time);
+}
+
+void AvionicsState::launch(double time)
+{
+    events.advanceTo(FLIGHT_EVENT_LAUNCH, time);
+    double timeSinceLaunch = time - timeOfLaunch;
+    getLogger().setRecordMode(FLIGHT);
+    bb.aonoff(BUZZER, 200);
+    stage = 1;
+    timeOfLaunch = time;
+    timeOfLastStage = time;
+    getLogger().recordLogData(INFO_, 100, "Launch detected at %.2f seconds.", timeSinceLaunch);
+    //getLogger().recordLogData(INFO_, "Printing static data.");
+    for (int i = 0; i < maxNumSensors; i++)
+    {
+        if (sensorOK(sensors[i]))
+        {
+            // char logData[200];
+            // snprintf(logData, 200, "%s: %s", sensors[i]->getName(), sensors[i]->getStaticDataString());
+            // getLogger().recordLogData(INFO_, logData);
+            sensors[i]->setBiasCorrectionMode(false);
+        }
+    }
+}
+
+void AvionicsState::coast(double time)
+{
+    events.advanceTo(FLIGHT_EVENT_BURNOUT, time);
+    bb.aonoff(BUZZER, 200, 2);
+    timeOfLastStage = time;
+    stage = 2;
+    getLogger().recordLogData(INFO_, 100, "Coasting detected at %.2f seconds.", time - timeOfLaunch);
+
+    // if (Serial8.availableForWrite() > 0) {
+    //     Serial8.println("0");
+    //     getLogger().recordLogData(INFO_, 100, "RotCam rotated to 0 degrees at %.2f seconds.", timeSinceLaunch);
+    // }
+}
+
+void AvionicsState::apogee(double time)
+{
+    events.advanceTo(FLIGHT_EVENT_APOGEE, time);
+    bb.aonoff(BUZZER, 200, 3);
+    getLogger().recordLogData(INFO_, 100, "Apogee detected at %.2f m.", position.z());
+    timeOfLastStage = time;
+    stage = 3;
+    getLogger().recordLogData(INFO_, 100, "Drogue conditions detected %.2f seconds.", time - timeOfLaunch);
 }
 
 void AvionicsState::determineStage()
@@ -32,7 +276,10 @@ void AvionicsState::determineStage()
     IMU *imu = reinterpret_cast<IMU *>(getSensor("IMU"_i));
     Barometer *baro = reinterpret_cast<Barometer *>(getSensor("Barometer"_i));
     // GPS *gps = reinterpret_cast<GPS *>(getSensor(GPS_));
-    if (stage == 0 &&
+    // launch, coast and apogee come from the event detector in updateEstimator() while it's running, these are the
+    // fallback at the state update rate
+    bool eventsAtSampleRate = kfilter && highRateEstimator && sensorOK(imu);
+    if (stage == 0 && !eventsAtSampleRate &&
         (sensorOK(imu) || sensorOK(baro)) &&
         (sensorOK(imu) ? abs(imu->getAccelerationGlobal().magnitude()) > 40 : true) 
         // (sensorOK(baro) ? baro->getAGLAltFt() > 10 : true)
@@ -44,44 +291,15 @@ void AvionicsState::determineStage()
 
     // essentially, if we have either sensor and they meet launch threshold, launch. Otherwise, it will never detect a launch.
     {
-        getLogger().setRecordMode(FLIGHT);
-        bb.aonoff(BUZZER, 200);
-        stage = 1;
-        timeOfLaunch = currentTime;
-        timeOfLastStage = currentTime;
-        getLogger().recordLogData(INFO_, 100, "Launch detected at %.2f seconds.", timeSinceLaunch);
-        //getLogger().recordLogData(INFO_, "Printing static data.");
-        for (int i = 0; i < maxNumSensors; i++)
-        {
-            if (sensorOK(sensors[i]))
-            {
-                // char logData[200];
-                // snprintf(logData, 200, "%s: %s", sensors[i]->getName(), sensors[i]->getStaticDataString());
-                // getLogger().recordLogData(INFO_, logData);
-                sensors[i]->setBiasCorrectionMode(false);
-            }
-        }
+        launch(currentTime);
     } // TODO: Add checks for each sensor being ok and decide what to do if they aren't.
-    else if (stage == 1 && abs(acceleration.z()) < 10)
+    else if (stage == 1 && !eventsAtSampleRate && abs(acceleration.z()) < 10)
     {
-        bb.aonoff(BUZZER, 200, 2);
-        timeOfLastStage = currentTime;
-        stage = 2;
-        getLogger().recordLogData(INFO_, 100, "Coasting detected at %.2f seconds.", timeSinceLaunch);
-
-        // if (Serial8.availableForWrite() > 0) {
-        //     Serial8.println("0");
-        //     getLogger().recordLogData(INFO_, 100, "RotCam rotated to 0 degrees at %.2f seconds.", timeSinceLaunch);
-        // }
+        coast(currentTime);
     }
-    else if (stage == 2 && consecutiveNegativeBaroVelocity > 5 && currentTime - timeOfLastStage > 25 /*&& imuVelocity > 102 */)
+    else if (stage == 2 && !eventsAtSampleRate && consecutiveNegativeBaroVelocity > 5 && currentTime - timeOfLastStage > 25 /*&& imuVelocity > 102 */)
     {
-        bb.aonoff(BUZZER, 200, 3);
-        getLogger().recordLogData(INFO_, 100, "Apogee detected at %.2f m.", position.z());
-        timeOfLastStage = currentTime;
-        stage = 3;
-        getLogger().recordLogData(INFO_, 100, "Drogue conditions detected %.2f seconds.", timeSinceLaunch);
-
+        apogee(currentTime);
     }
     else if (stage == 3 && baro->getAGLAltFt() < 1500 && currentTime - timeOfLastStage > 45)
     {
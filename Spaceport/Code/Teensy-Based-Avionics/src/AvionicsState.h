@@ -3,18 +3,48 @@
 
 // Platformio is such a fucking pile of trash
 #include "MMFS.h"
+#include "AvionicsKF.h"
+#include "AttitudeFilter.h"
+#include "FlightEventDetector.h"
 
 using namespace mmfs;
 class AvionicsState : public State
 {
 public:
-    AvionicsState(Sensor **sensors, int numSensors, LinearKalmanFilter *kfilter);
+    AvionicsState(Sensor **sensors, int numSensors, AvionicsKF *kfilter, AttitudeFilter *afilter = nullptr);
     void updateVariables() override;
     double getTimeSinceLastStage();
+    // run the filter from updateEstimator() instead of once per update
+    void setHighRateEstimator(bool enabled) { highRateEstimator = enabled; }
+    // reads a raw IMU sample and predicts, then applies any GPS/barometer samples that changed since the last call,
+    // meant to be called at the IMU's data rate. Only read() is called, IMU::update() stays at the state rate. The same
+    // samples go to the flight event detector, so launch, coast and apogee are raised from here.
+    void updateEstimator();
+    // roll, pitch, yaw in degrees from the attitude filter, zeros without one
+    const double *getAttitude() const { return attitude; }
 
 private:
     char stages[7][20] = {"Pre-Flight", "Boosting", "Coasting", "Drogue Descent", "Main Descent", "Post-Flight", "Dumped"};
     void determineStage() override;
+    void updateFilter();
+    void controlInput(IMU *imu, double *inputs);
+    void updateAttitude(IMU *imu, double dt);
+    void onFlightEvent(FlightEvent event, double time);
+    void launch(double time);
+    void coast(double time);
+    void apogee(double time);
+    AvionicsKF *kfilter;
+    AttitudeFilter *afilter;
+    double attitude[3] = {0};
+    double lastAttitudeTime = 0;
+    FlightEventDetector events;
+    double filterState[AvionicsKF::STATE_SIZE] = {0};
+    double lastFilterTime = 0;
+    bool highRateEstimator = false;
+    uint32_t lastEstimatorTime = 0; // us
+    bool estimatorRan = false; // since the last updateVariables()
+    double lastGPS[2] = {NAN, NAN};
+    double lastBaro = NAN;
     double timeOfLaunch;
     double timeOfLastStage;
     double imuVelocity;
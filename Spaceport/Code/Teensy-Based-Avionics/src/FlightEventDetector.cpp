@@ -0,0 +1,112 @@
+#include "FlightEventDetector.h"
+#include <math.h>
+
+namespace mmfs {
+
+constexpr double FlightEventDetector::GRAVITY;
+constexpr double FlightEventDetector::LAUNCH_ACCEL;
+constexpr double FlightEventDetector::LAUNCH_TIME;
+constexpr double FlightEventDetector::BURNOUT_ACCEL;
+constexpr double FlightEventDetector::BURNOUT_TIME;
+constexpr double FlightEventDetector::BARO_WINDOW;
+constexpr int FlightEventDetector::MAX_BARO_SAMPLES;
+constexpr double FlightEventDetector::APOGEE_TIME;
+
+FlightEventDetector::FlightEventDetector(double apogeeLockout) : apogeeLockout(apogeeLockout) { reset(); }
+
+void FlightEventDetector::reset() {
+    phase = PAD;
+    conditionStart = NAN;
+    for (int i = 0; i < 4; i++)
+        eventTimes[i] = NAN;
+    baroNewest = -1;
+    baroCount = 0;
+    velocity = 0;
+}
+
+// true once condition has held for hold s, any sample where it doesn't starts the wait over
+bool FlightEventDetector::persists(bool condition, double time, double hold) {
+    if (!condition) {
+        conditionStart = NAN;
+        return false;
+    }
+    if (isnan(conditionStart))
+        conditionStart = time;
+    return time - conditionStart >= hold;
+}
+
+// the phases follow the events in order, launch starts BOOST and so on
+void FlightEventDetector::advanceTo(FlightEvent event, double time) {
+    if (event == FLIGHT_EVENT_NONE || (int)phase >= (int)event)
+        return;
+    phase = (Phase)event;
+    conditionStart = NAN;
+    eventTimes[event] = time;
+}
+
+FlightEvent FlightEventDetector::raise(FlightEvent event, double time) {
+    advanceTo(event, time);
+    return event;
+}
+
+FlightEvent FlightEventDetector::imuSample(double time, const double *accel) {
+    double magnitude = sqrt(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    if (phase == PAD && persists(magnitude > LAUNCH_ACCEL, time, LAUNCH_TIME))
+        return raise(FLIGHT_EVENT_LAUNCH, time);
+    if (phase == BOOST && persists(fabs(accel[2]) < BURNOUT_ACCEL, time, BURNOUT_TIME))
+        return raise(FLIGHT_EVENT_BURNOUT, time);
+    return FLIGHT_EVENT_NONE;
+}
+
+FlightEvent FlightEventDetector::baroSample(double time, double altitude) {
+    baroNewest = (baroNewest + 1) % MAX_BARO_SAMPLES;
+    baroTimes[baroNewest] = time;
+    baroAltitudes[baroNewest] = altitude;
+    if (baroCount < MAX_BARO_SAMPLES)
+        baroCount++;
+    fitVelocity(time);
+
+    if (phase == COAST && time - eventTimes[FLIGHT_EVENT_BURNOUT] >= apogeeLockout &&
+        persists(velocity < 0, time, APOGEE_TIME))
+        return raise(FLIGHT_EVENT_APOGEE, time);
+    return FLIGHT_EVENT_NONE;
+}
+
+// Least squares line through the samples in the window. Times are taken from the newest sample so the sums stay small
+// however long the board has been on.
+void FlightEventDetector::fitVelocity(double time) {
+    // samples that have aged out of the window are dropped from the oldest end
+    while (baroCount > 0) {
+        int oldest = (baroNewest - baroCount + 1 + MAX_BARO_SAMPLES) % MAX_BARO_SAMPLES;
+        if (time - baroTimes[oldest] <= BARO_WINDOW)
+            break;
+        baroCount--;
+    }
+    if (baroCount < 3) {
+        velocity = 0;
+        return;
+    }
+
+    double sumT = 0, sumZ = 0;
+    for (int i = 0, j = baroNewest; i < baroCount; i++, j = (j - 1 + MAX_BARO_SAMPLES) % MAX_BARO_SAMPLES) {
+        sumT += baroTimes[j] - time;
+        sumZ += baroAltitudes[j];
+    }
+    double meanT = sumT / baroCount, meanZ = sumZ / baroCount;
+    double stt = 0, stz = 0;
+    for (int i = 0, j = baroNewest; i < baroCount; i++, j = (j - 1 + MAX_BARO_SAMPLES) % MAX_BARO_SAMPLES) {
+        double t = baroTimes[j] - time - meanT;
+        stt += t * t;
+        stz += t * (baroAltitudes[j] - meanZ);
+    }
+    if (!(stt > 0)) {
+        velocity = 0;
+        return;
+    }
+    velocity = stz / stt;
+    // the slope is the velocity in the middle of the window, meanT s ago
+    if (phase == COAST)
+        velocity += GRAVITY * meanT;
+}
+
+} // namespace mmfs
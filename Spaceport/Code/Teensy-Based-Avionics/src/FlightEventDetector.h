@@ -0,0 +1,86 @@
+#ifndef FLIGHT_EVENT_DETECTOR_H
+#define FLIGHT_EVENT_DETECTOR_H
+
+namespace mmfs
+{
+
+    enum FlightEvent
+    {
+        FLIGHT_EVENT_NONE,
+        FLIGHT_EVENT_LAUNCH,
+        FLIGHT_EVENT_BURNOUT,
+        FLIGHT_EVENT_APOGEE,
+    };
+
+    // Launch, burnout and apogee from the raw sample streams, meant to be fed every IMU and barometer sample as it comes
+    // in so an event is raised on the sample that confirms it instead of on the next state update.
+    // - Launch and burnout are the earth frame accelerometer reading crossing a threshold and staying past it for a minimum time,
+    //   so a single spike (a bump on the pad, a jolt at burnout) can't trigger them. They're the same signals the state
+    //   update checks: the magnitude for launch and the vertical component for burnout.
+    // - Apogee is the vertical velocity from a least squares line through the last BARO_WINDOW of barometer altitudes
+    //   staying below zero for APOGEE_TIME. While coasting the rocket is falling at least as fast as gravity, so the
+    //   fitted velocity is carried from the middle of the window to the newest sample with g, which takes out the half
+    //   window of lag a plain fit has and can only make the estimate late, never early.
+    // Times are in s on any clock that doesn't go backwards. Nothing is allocated, the barometer window is a fixed ring.
+    class FlightEventDetector
+    {
+    public:
+        static constexpr double GRAVITY = 9.80665;       // m/s^2
+        static constexpr double LAUNCH_ACCEL = 40;       // m/s^2, magnitude
+        static constexpr double LAUNCH_TIME = 0.05;      // s above LAUNCH_ACCEL
+        static constexpr double BURNOUT_ACCEL = 10;      // m/s^2, vertical either way
+        static constexpr double BURNOUT_TIME = 0.05;     // s below BURNOUT_ACCEL
+        static constexpr double BARO_WINDOW = 1.0;       // s of barometer samples in the velocity fit
+        static constexpr int MAX_BARO_SAMPLES = 32;      // the window is shortened if samples come faster than this
+        static constexpr double APOGEE_TIME = 0.2;       // s of negative velocity
+
+        // apogeeLockout is the time after burnout (s) before apogee can be called, for rockets whose barometer is
+        // unreliable through a transonic coast
+        explicit FlightEventDetector(double apogeeLockout = 0);
+
+        // back to waiting on the pad, the barometer window is cleared
+        void reset();
+        // for an event decided some other way, the detector carries on as if it had raised it, does nothing if it's
+        // already past it
+        void advanceTo(FlightEvent event, double time);
+
+        // accel is the accelerometer reading in the earth frame (x, y, z up) in m/s^2, gravity included like
+        // IMU::getAccelerationGlobal(), returns the event this sample confirmed
+        FlightEvent imuSample(double time, const double *accel);
+        // altitude in m, returns the event this sample confirmed
+        FlightEvent baroSample(double time, double altitude);
+
+        // m/s, 0 until there are enough barometer samples in the window
+        double getVerticalVelocity() const { return velocity; }
+        // when the event was raised, NAN if it hasn't been
+        double getEventTime(FlightEvent event) const { return eventTimes[event]; }
+
+    private:
+        // each phase starts with the event of the same value
+        enum Phase
+        {
+            PAD,
+            BOOST,
+            COAST,
+            DESCENT,
+        };
+
+        bool persists(bool condition, double time, double hold);
+        FlightEvent raise(FlightEvent event, double time);
+        void fitVelocity(double time);
+
+        double apogeeLockout;
+        Phase phase = PAD;
+        double conditionStart; // when the condition for the next event started holding, NAN if it isn't
+        double eventTimes[4];
+
+        double baroTimes[MAX_BARO_SAMPLES];
+        double baroAltitudes[MAX_BARO_SAMPLES];
+        int baroNewest = -1;
+        int baroCount = 0;
+        double velocity = 0;
+    };
+
+} // namespace mmfs
+
+#endif // FLIGHT_EVENT_DETECTOR_H
@@ -0,0 +1,379 @@
+#ifndef MATRIXEXPR_H
+#define MATRIXEXPR_H
+
+#include <type_traits>
+#include "StaticMatrix.h"
+
+/*
+Lazily evaluated StaticMatrix expressions. The StaticMatrix operators each return a finished matrix, so a chain like
+F * P * Ft + Q builds a temporary for every operator and copies the result at the end. Starting a chain with lazy()
+(or transpose() / identity()) instead builds a small tree of expression nodes that is only evaluated when it's assigned
+to a StaticMatrix with =, += or -=, one row at a time straight into the destination with the sums fused in:
+
+    P = lazy(F) * P * transpose(F) + Q;      // one temporary for F * P, written straight into P
+    P -= lazy(K) * (lazy(H) * P);            // H * P is evaluated once, P is then updated in place
+
+- Sums, differences and scaling cost nothing until the row is computed.
+- A product reads its operands many times per row, so an operand that isn't a plain or transposed matrix (a product,
+  a sum, ...) is evaluated once into a fixed size temporary on the stack when the expression is built.
+- If the destination is read anywhere other than at the element being written, the result goes through a temporary,
+  so P = lazy(F) * P is safe.
+Nodes hold references to the matrices and to each other, so an expression has to be assigned in the statement that
+builds it. Never keep one in an auto variable.
+*/
+
+namespace mmfs
+{
+
+    // Base of every expression node. E provides ROWS, COLS, Scalar and
+    // - row(r, out) : computes row r into out
+    // - reads(p) : whether the matrix with data p is read at all
+    // - readsAcross(p) : whether p is read at any element other than (r, c) when computing (r, c)
+    // Nodes with direct set can also be indexed with operator()(r, c) for about the cost of an array read.
+    template <typename E>
+    struct MatrixExpr
+    {
+        const E &self() const { return static_cast<const E &>(*this); }
+    };
+
+    template <typename E>
+    StaticMatrix<E::ROWS, E::COLS, typename E::Scalar> eval(const MatrixExpr<E> &e);
+
+    // a StaticMatrix as an expression leaf
+    template <int R, int C, typename T>
+    struct MatrixRef : MatrixExpr<MatrixRef<R, C, T>>
+    {
+        static constexpr int ROWS = R;
+        static constexpr int COLS = C;
+        static constexpr bool byValue = true;
+        static constexpr bool direct = true;
+        typedef T Scalar;
+
+        const StaticMatrix<R, C, T> &m;
+
+        MatrixRef(const StaticMatrix<R, C, T> &m) : m(m) {}
+        T operator()(int r, int c) const { return m(r, c); }
+        void row(int r, T *out) const
+        {
+            for (int c = 0; c < C; c++)
+                out[c] = m(r, c);
+        }
+        bool reads(const void *p) const { return m.data == p; }
+        bool readsAcross(const void *p) const { return false; }
+    };
+
+    template <int N, typename T>
+    struct IdentityExpr : MatrixExpr<IdentityExpr<N, T>>
+    {
+        static constexpr int ROWS = N;
+        static constexpr int COLS = N;
+        static constexpr bool byValue = true;
+        static constexpr bool direct = true;
+        typedef T Scalar;
+
+        T operator()(int r, int c) const { return r == c ? 1 : 0; }
+        void row(int r, T *out) const
+        {
+            for (int c = 0; c < N; c++)
+                out[c] = r == c ? 1 : 0;
+        }
+        bool reads(const void *p) const { return false; }
+        bool readsAcross(const void *p) const { return false; }
+    };
+
+    namespace expr
+    {
+        // Leaves are made inside the operators below and have to be copied, anything else is a temporary of the
+        // statement building the expression and lives until the assignment.
+        template <typename E>
+        using Nested = typename std::conditional<E::byValue, E, const E &>::type;
+
+        // what a StaticMatrix or an expression is as an operand
+        template <typename M, typename = void>
+        struct Operand
+        {
+            static constexpr bool valid = false;
+            static constexpr bool lazy = false;
+        };
+
+        template <int R, int C, typename T>
+        struct Operand<StaticMatrix<R, C, T>, void>
+        {
+            static constexpr bool valid = true;
+            static constexpr bool lazy = false;
+            typedef MatrixRef<R, C, T> type;
+            static type get(const StaticMatrix<R, C, T> &m) { return type(m); }
+        };
+
+        template <typename E>
+        struct Operand<E, typename std::enable_if<std::is_base_of<MatrixExpr<E>, E>::value>::type>
+        {
+            static constexpr bool valid = true;
+            static constexpr bool lazy = true;
+            typedef E type;
+            static const E &get(const E &e) { return e; }
+        };
+
+        // the free operators only take over when at least one side is an expression, StaticMatrix with StaticMatrix
+        // stays with the eager member operators
+        template <typename A, typename B>
+        using EnableLazy = typename std::enable_if<Operand<A>::valid && Operand<B>::valid &&
+                                                   (Operand<A>::lazy || Operand<B>::lazy)>::type;
+
+        template <typename A>
+        using OperandType = typename Operand<A>::type;
+
+        // an operand that is indexed element by element, read through if keep is set and evaluated once otherwise
+        template <typename E, bool keep>
+        struct Indexed
+        {
+            Nested<E> e;
+            Indexed(const E &e) : e(e) {}
+            typename E::Scalar operator()(int r, int c) const { return e(r, c); }
+            bool reads(const void *p) const { return e.reads(p); }
+        };
+
+        template <typename E>
+        struct Indexed<E, false>
+        {
+            StaticMatrix<E::ROWS, E::COLS, typename E::Scalar> m;
+            Indexed(const E &e) : m(eval(e)) {}
+            typename E::Scalar operator()(int r, int c) const { return m(r, c); }
+            bool reads(const void *p) const { return false; }
+        };
+    } // namespace expr
+
+    template <typename E>
+    struct Transposed : MatrixExpr<Transposed<E>>
+    {
+        static constexpr int ROWS = E::COLS;
+        static constexpr int COLS = E::ROWS;
+        static constexpr bool byValue = false;
+        static constexpr bool direct = true;
+        typedef typename E::Scalar Scalar;
+
+        expr::Indexed<E, E::direct> e;
+
+        Transposed(const E &e) : e(e) {}
+        Scalar operator()(int r, int c) const { return e(c, r); }
+        void row(int r, Scalar *out) const
+        {
+            for (int c = 0; c < COLS; c++)
+                out[c] = e(c, r);
+        }
+        bool reads(const void *p) const { return e.reads(p); }
+        bool readsAcross(const void *p) const { return e.reads(p); }
+    };
+
+    template <typename A, typename B>
+    struct Sum : MatrixExpr<Sum<A, B>>
+    {
+        static_assert(A::ROWS == B::ROWS && A::COLS == B::COLS, "matrix sum dimensions don't match");
+        static constexpr int ROWS = A::ROWS;
+        static constexpr int COLS = A::COLS;
+        static constexpr bool byValue = false;
+        static constexpr bool direct = false;
+        typedef typename A::Scalar Scalar;
+
+        expr::Nested<A> a;
+        expr::Nested<B> b;
+
+        Sum(const A &a, const B &b) : a(a), b(b) {}
+        void row(int r, Scalar *out) const
+        {
+            Scalar other[COLS];
+            a.row(r, out);
+            b.row(r, other);
+            for (int c = 0; c < COLS; c++)
+                out[c] += other[c];
+        }
+        bool reads(const void *p) const { return a.reads(p) || b.reads(p); }
+        bool readsAcross(const void *p) const { return a.readsAcross(p) || b.readsAcross(p); }
+    };
+
+    template <typename A, typename B>
+    struct Difference : MatrixExpr<Difference<A, B>>
+    {
+        static_assert(A::ROWS == B::ROWS && A::COLS == B::COLS, "matrix difference dimensions don't match");
+        static constexpr int ROWS = A::ROWS;
+        static constexpr int COLS = A::COLS;
+        static constexpr bool byValue = false;
+        static constexpr bool direct = false;
+        typedef typename A::Scalar Scalar;
+
+        expr::Nested<A> a;
+        expr::Nested<B> b;
+
+        Difference(const A &a, const B &b) : a(a), b(b) {}
+        void row(int r, Scalar *out) const
+        {
+            Scalar other[COLS];
+            a.row(r, out);
+            b.row(r, other);
+            for (int c = 0; c < COLS; c++)
+                out[c] -= other[c];
+        }
+        bool reads(const void *p) const { return a.reads(p) || b.reads(p); }
+        bool readsAcross(const void *p) const { return a.readsAcross(p) || b.readsAcross(p); }
+    };
+
+    template <typename E>
+    struct Scaled : MatrixExpr<Scaled<E>>
+    {
+        static constexpr int ROWS = E::ROWS;
+        static constexpr int COLS = E::COLS;
+        static constexpr bool byValue = false;
+        static constexpr bool direct = false;
+        typedef typename E::Scalar Scalar;
+
+        expr::Nested<E> e;
+        Scalar s;
+
+        Scaled(const E &e, Scalar s) : e(e), s(s) {}
+        void row(int r, Scalar *out) const
+        {
+            e.row(r, out);
+            for (int c = 0; c < COLS; c++)
+                out[c] *= s;
+        }
+        bool reads(const void *p) const { return e.reads(p); }
+        bool readsAcross(const void *p) const { return e.readsAcross(p); }
+    };
+
+    // each element is summed in a register in the same order as StaticMatrix's operator*, a transposed operand is read in
+    // place
+    template <typename A, typename B>
+    struct Product : MatrixExpr<Product<A, B>>
+    {
+        static_assert(A::COLS == B::ROWS, "matrix product dimensions don't match");
+        static constexpr int ROWS = A::ROWS;
+        static constexpr int COLS = B::COLS;
+        static constexpr bool byValue = false;
+        static constexpr bool direct = false;
+        typedef typename A::Scalar Scalar;
+
+        expr::Indexed<A, A::direct> a;
+        expr::Indexed<B, B::direct> b;
+
+        Product(const A &a, const B &b) : a(a), b(b) {}
+        void row(int r, Scalar *out) const
+        {
+            for (int c = 0; c < COLS; c++)
+            {
+                Scalar sum = 0;
+                for (int k = 0; k < A::COLS; k++)
+                    sum += a(r, k) * b(k, c);
+                out[c] = sum;
+            }
+        }
+        bool reads(const void *p) const { return a.reads(p) || b.reads(p); }
+        bool readsAcross(const void *p) const { return reads(p); }
+    };
+
+    // starts a lazy expression from a matrix
+    template <int R, int C, typename T>
+    MatrixRef<R, C, T> lazy(const StaticMatrix<R, C, T> &m) { return MatrixRef<R, C, T>(m); }
+
+    template <int R, int C, typename T>
+    Transposed<MatrixRef<R, C, T>> transpose(const StaticMatrix<R, C, T> &m) { return Transposed<MatrixRef<R, C, T>>(m); }
+
+    template <typename E>
+    Transposed<E> transpose(const MatrixExpr<E> &e) { return Transposed<E>(e.self()); }
+
+    template <int N, typename T = double>
+    IdentityExpr<N, T> identity() { return IdentityExpr<N, T>(); }
+
+    template <typename A, typename B, typename = expr::EnableLazy<A, B>>
+    Sum<expr::OperandType<A>, expr::OperandType<B>> operator+(const A &a, const B &b)
+    {
+        return Sum<expr::OperandType<A>, expr::OperandType<B>>(expr::Operand<A>::get(a), expr::Operand<B>::get(b));
+    }
+
+    template <typename A, typename B, typename = expr::EnableLazy<A, B>>
+    Difference<expr::OperandType<A>, expr::OperandType<B>> operator-(const A &a, const B &b)
+    {
+        return Difference<expr::OperandType<A>, expr::OperandType<B>>(expr::Operand<A>::get(a), expr::Operand<B>::get(b));
+    }
+
+    template <typename A, typename B, typename = expr::EnableLazy<A, B>>
+    Product<expr::OperandType<A>, expr::OperandType<B>> operator*(const A &a, const B &b)
+    {
+        return Product<expr::OperandType<A>, expr::OperandType<B>>(expr::Operand<A>::get(a), expr::Operand<B>::get(b));
+    }
+
+    template <typename E>
+    Scaled<E> operator*(const MatrixExpr<E> &e, typename E::Scalar s) { return Scaled<E>(e.self(), s); }
+
+    template <typename E>
+    Scaled<E> operator*(typename E::Scalar s, const MatrixExpr<E> &e) { return Scaled<E>(e.self(), s); }
+
+    // evaluates an expression into a new matrix
+
+    namespace expr
+    {
+        // Each row is computed into a local buffer before it's stored, so the compiler knows the stores can't change
+        // what the rest of the row reads. An element-wise read of the destination (P = P + Q) only sees its own row,
+        // which isn't stored yet.
+        template <int R, int C, typename T, typename E, typename Store>
+        inline void evaluate(StaticMatrix<R, C, T> &dest, const E &e, Store store)
+        {
+            static_assert(E::ROWS == R && E::COLS == C, "assigned expression dimensions don't match");
+            for (int r = 0; r < R; r++)
+            {
+                T row[C];
+                e.row(r, row);
+                for (int c = 0; c < C; c++)
+                    store(dest(r, c), row[c]);
+            }
+        }
+    } // namespace expr
+
+    // evaluates an expression into a new matrix
+    template <typename E>
+    StaticMatrix<E::ROWS, E::COLS, typename E::Scalar> eval(const MatrixExpr<E> &e)
+    {
+        StaticMatrix<E::ROWS, E::COLS, typename E::Scalar> out;
+        expr::evaluate(out, e.self(), [](typename E::Scalar &d, typename E::Scalar v)
+                       { d = v; });
+        return out;
+    }
+
+    // the StaticMatrix assignments declared in StaticMatrix.h, an expression that reads the destination anywhere but
+    // at the element being written is evaluated into a temporary first
+
+    template <int R, int C, typename T>
+    template <typename E>
+    StaticMatrix<R, C, T> &StaticMatrix<R, C, T>::operator=(const MatrixExpr<E> &expression)
+    {
+        if (expression.self().readsAcross(data))
+            return *this = eval(expression);
+        expr::evaluate(*this, expression.self(), [](T &d, T v)
+                       { d = v; });
+        return *this;
+    }
+
+    template <int R, int C, typename T>
+    template <typename E>
+    StaticMatrix<R, C, T> &StaticMatrix<R, C, T>::operator+=(const MatrixExpr<E> &expression)
+    {
+        if (expression.self().readsAcross(data))
+            return *this += eval(expression);
+        expr::evaluate(*this, expression.self(), [](T &d, T v)
+                       { d += v; });
+        return *this;
+    }
+
+    template <int R, int C, typename T>
+    template <typename E>
+    StaticMatrix<R, C, T> &StaticMatrix<R, C, T>::operator-=(const MatrixExpr<E> &expression)
+    {
+        if (expression.self().readsAcross(data))
+            return *this -= eval(expression);
+        expr::evaluate(*this, expression.self(), [](T &d, T v)
+                       { d -= v; });
+        return *this;
+    }
+
+} // namespace mmfs
+
+#endif // MATRIXEXPR_H
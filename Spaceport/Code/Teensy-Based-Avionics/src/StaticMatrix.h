@@ -0,0 +1,221 @@
+#ifndef STATICMATRIX_H
+#define STATICMATRIX_H
+
+#include <math.h>
+
+namespace mmfs
+{
+
+    template <typename E>
+    struct MatrixExpr;
+
+    // Row-major matrix with its dimensions fixed at compile time. The storage is a member array, so matrices live on the
+    // stack or in static storage and none of the operations touch the heap. Constant matrices can be constexpr. The
+    // element type is double unless given, float is there for comparing precision and speed. Lazy expressions from
+    // MatrixExpr.h can be assigned with =, += and -= to evaluate them straight into the matrix.
+    template <int R, int C, typename T = double>
+    struct StaticMatrix
+    {
+        T data[R * C];
+
+        static constexpr int rows() { return R; }
+        static constexpr int cols() { return C; }
+
+        T &operator()(int r, int c) { return data[r * C + c]; }
+        constexpr T operator()(int r, int c) const { return data[r * C + c]; }
+
+        static constexpr StaticMatrix zeros()
+        {
+            StaticMatrix m{};
+            return m;
+        }
+
+        static constexpr StaticMatrix diagonal(T v)
+        {
+            StaticMatrix m{};
+            for (int i = 0; i < R && i < C; i++)
+                m.data[i * C + i] = v;
+            return m;
+        }
+
+        static constexpr StaticMatrix identity() { return diagonal(1); }
+
+        StaticMatrix<C, R, T> transpose() const
+        {
+            StaticMatrix<C, R, T> t;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    t.data[j * R + i] = data[i * C + j];
+            return t;
+        }
+
+        template <int K>
+        StaticMatrix<R, K, T> operator*(const StaticMatrix<C, K, T> &other) const
+        {
+            StaticMatrix<R, K, T> out;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < K; j++)
+                {
+                    T sum = 0;
+                    for (int k = 0; k < C; k++)
+                        sum += data[i * C + k] * other.data[k * K + j];
+                    out.data[i * K + j] = sum;
+                }
+            return out;
+        }
+
+        StaticMatrix operator*(T s) const
+        {
+            StaticMatrix out;
+            for (int i = 0; i < R * C; i++)
+                out.data[i] = data[i] * s;
+            return out;
+        }
+
+        StaticMatrix operator+(const StaticMatrix &other) const
+        {
+            StaticMatrix out;
+            for (int i = 0; i < R * C; i++)
+                out.data[i] = data[i] + other.data[i];
+            return out;
+        }
+
+        StaticMatrix operator-(const StaticMatrix &other) const
+        {
+            StaticMatrix out;
+            for (int i = 0; i < R * C; i++)
+                out.data[i] = data[i] - other.data[i];
+            return out;
+        }
+
+        StaticMatrix &operator+=(const StaticMatrix &other)
+        {
+            for (int i = 0; i < R * C; i++)
+                data[i] += other.data[i];
+            return *this;
+        }
+
+        StaticMatrix &operator-=(const StaticMatrix &other)
+        {
+            for (int i = 0; i < R * C; i++)
+                data[i] -= other.data[i];
+            return *this;
+        }
+
+        // defined in MatrixExpr.h
+        template <typename E>
+        StaticMatrix &operator=(const MatrixExpr<E> &expression);
+        template <typename E>
+        StaticMatrix &operator+=(const MatrixExpr<E> &expression);
+        template <typename E>
+        StaticMatrix &operator-=(const MatrixExpr<E> &expression);
+    };
+
+    // Gauss-Jordan elimination with partial pivoting, returns false and leaves out unspecified if m is singular
+    template <int N, typename T>
+    bool invert(const StaticMatrix<N, N, T> &m, StaticMatrix<N, N, T> &out)
+    {
+        StaticMatrix<N, N, T> a = m;
+        out = StaticMatrix<N, N, T>::identity();
+        for (int col = 0; col < N; col++)
+        {
+            int pivot = col;
+            for (int r = col + 1; r < N; r++)
+                if (fabs(a(r, col)) > fabs(a(pivot, col)))
+                    pivot = r;
+            if (a(pivot, col) == 0)
+                return false;
+            if (pivot != col)
+                for (int c = 0; c < N; c++)
+                {
+                    T tmp = a(col, c);
+                    a(col, c) = a(pivot, c);
+                    a(pivot, c) = tmp;
+                    tmp = out(col, c);
+                    out(col, c) = out(pivot, c);
+                    out(pivot, c) = tmp;
+                }
+
+            T scale = 1 / a(col, col);
+            for (int c = 0; c < N; c++)
+            {
+                a(col, c) *= scale;
+                out(col, c) *= scale;
+            }
+            for (int r = 0; r < N; r++)
+            {
+                if (r == col || a(r, col) == 0)
+                    continue;
+                T f = a(r, col);
+                for (int c = 0; c < N; c++)
+                {
+                    a(r, c) -= f * a(col, c);
+                    out(r, c) -= f * out(col, c);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Factors a symmetric positive definite matrix into L Lt in place, L is left in the lower triangle and the upper
+    // triangle is not touched. Returns false if a is not positive definite.
+    template <int N, typename T>
+    bool choleskyFactor(StaticMatrix<N, N, T> &a)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            T d = a(j, j);
+            for (int k = 0; k < j; k++)
+                d -= a(j, k) * a(j, k);
+            if (!(d > 0))
+                return false;
+            d = sqrt(d);
+            a(j, j) = d;
+            T inv = 1 / d;
+            for (int i = j + 1; i < N; i++)
+            {
+                T sum = a(i, j);
+                for (int k = 0; k < j; k++)
+                    sum -= a(i, k) * a(j, k);
+                a(i, j) = sum * inv;
+            }
+        }
+        return true;
+    }
+
+    // Solves X A = B in place of B, with A already factored by choleskyFactor(). This is the form the Kalman gain
+    // K S = P Ht takes, each row of B is solved on its own and is contiguous so nothing needs transposing.
+    template <int N, int K, typename T>
+    void choleskySolveRight(const StaticMatrix<N, N, T> &l, StaticMatrix<K, N, T> &b)
+    {
+        T invDiag[N];
+        for (int i = 0; i < N; i++)
+            invDiag[i] = 1 / l(i, i);
+
+        for (int r = 0; r < K; r++)
+        {
+            T *row = &b.data[r * N];
+            // Y Lt = B
+            for (int j = 0; j < N; j++)
+            {
+                T sum = row[j];
+                for (int k = 0; k < j; k++)
+                    sum -= row[k] * l(j, k);
+                row[j] = sum * invDiag[j];
+            }
+            // X L = Y
+            for (int j = N - 1; j >= 0; j--)
+            {
+                T sum = row[j];
+                for (int k = j + 1; k < N; k++)
+                    sum -= row[k] * l(k, j);
+                row[j] = sum * invDiag[j];
+            }
+        }
+    }
+
+} // namespace mmfs
+
+#include "MatrixExpr.h"
+
+#endif // STATICMATRIX_H
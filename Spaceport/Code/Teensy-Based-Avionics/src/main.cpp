@@ -2,11 +2,13 @@
 #include <MMFS.h>
 #include "AvionicsState.h"
 #include "AvionicsKF.h"
+#include "AttitudeFilter.h"
 #include "AviEventListener.h"
 #include "Pi.h"
 #include "Si4463.h"
 #include "Radio/ESP32BluetoothRadio.h"
 #include "VoltageSensor.h"
+#include "AvionicsScheduler.h"
 
 #include "422Mc80_4GFSK_009600H.h"
 
@@ -22,7 +24,8 @@ VoltageSensor vsfc(A0, 330, 220, "Flight Computer Voltage");
 
 Sensor *s[] = {&m, &d, &b, &vsfc};
 AvionicsKF fk;
-AvionicsState t(s, sizeof(s) / 4, &fk);
+AttitudeFilter af;
+AvionicsState t(s, sizeof(s) / 4, &fk, &af);
 
 APRSConfig aprsConfigAvionics = {"KD3BBD", "ALL", "WIDE1-1", PositionWithoutTimestampWithoutAPRS, '\\', 'M'};
 uint8_t encoding[] = {7, 4, 4};
@@ -80,74 +83,28 @@ MMFSSystem sys(&a);
 
 AviEventLister listener;
 
-void setup()
-{
-    sys.init();
-    Serial8.begin(115200);
-    Serial2.begin(9600);
-    bb.aonoff(32, *(new BBPattern(200, 1)), true); // blink a status LED (until GPS fix)
-
-    if (btRad.begin())
-    {
-        bb.onoff(BUZZER, 500); // 1 x 0.5 sec beep for sucessful initialization
-        getLogger().recordLogData(INFO_, "Initialized Bluetooth");
-    }
-    else
-    {
-        bb.onoff(BUZZER, 1000, 3); // 3 x 2 sec beep for uncessful initialization
-        getLogger().recordLogData(ERROR_, "Initialized Bluetooth Failed");
-    }
-
-    if (radio.begin(CONFIG_422Mc80_4GFSK_009600H, sizeof(CONFIG_422Mc80_4GFSK_009600H)))
-    {
-        bb.onoff(BUZZER, 1000);
-        getLogger().recordLogData(ERROR_, "Radio initialized.");
-    }
-    else
-    {
-        bb.onoff(BUZZER, 200, 3);
-        getLogger().recordLogData(INFO_, "Radio failed to initialize.");
-    }
-
-    getLogger().recordLogData(INFO_, "Initialization Complete");
-}
-uint32_t avionicsTimer = millis();
-uint32_t airbrakeTimer = millis();
 bool sendAirbrake = false;
 
 void calcStuff();
 Message mess;
 APRSCmd cmd;
 
-double motorTimer = 0;
 int motorAngle = 0;
-void loop()
-{
-    double timeeee = millis();
-    if (millis() - motorTimer > 3000)
-    {
-        int mult = 1;
-        if (motorAngle >= 360)
-            mult = -1;
-        else
-            mult = 1;
-        motorAngle += (mult * 90);
-        Serial8.println(motorAngle);
-    }
+double motorTimer = 0;
 
-    if (btRad.isReady())
-        Serial.print(btRad.isReady());
-    // if (Serial2.available())
-    //     Serial.write(Serial2.read());
-    btRad.rx();
-    if (millis() > 44 * 1000 * 60 && !pi.isOn())
-    {
-        pi.setOn(true);
-    }
-    // if (millis() > 1 * 1000 * 60 && !pi.isRecording())
-    // {
-    //     pi.setRecording(true);
-    // }
+// whether the radio finished its bring up in setup()
+bool radioReady = false;
+
+// non-preemptive, runs one task per loop() and only counts deadline overruns, see AvionicsScheduler.h
+AvionicsScheduler scheduler;
+// when the last avionics telemetry packet was sent (ms), the airbrake relay is timed from it
+uint32_t telemetryTime = 0;
+
+// services the radio FIFOs, needs to run often enough that they never fill up or run dry
+void radioTask()
+{
+    if (!radioReady)
+        return;
     // if (radio.avail())
     // {
     //     radio.readRXBuf(mess.buf, mess.maxSize);
@@ -169,11 +126,16 @@ void loop()
     //         }
     //     }
     // }
+    radio.update();
+}
 
+void sensorTask()
+{
+    // MMFS limits the state update to its own rate (10 Hz)
     if (sys.update())
     {
         calcStuff();
-        if(!pi.isRecording() && t.getStage() > 0)
+        if (!pi.isRecording() && t.getStage() > 0)
             pi.setRecording(true);
         if (btRad.getReceiveSize() > 0)
         {
@@ -194,71 +156,146 @@ void loop()
             {
                 Serial.println("error");
             }
-            // Serial.write(asdf, i);
-            // Serial.println();
-            // for (int i = 0; i < msgAirbrake.size; i++)
-            // {
-            //     Serial.write((char *)msgAirbrake.buf, msgAirbrake.size);
-            // }
-            // Serial.println();
         }
     }
+}
+
+// steps the attitude filter and predicts at the IMU rate, and folds in new GPS/barometer samples as they arrive
+void estimatorTask()
+{
+    t.updateEstimator();
+}
 
-    if (millis() - avionicsTimer > 1000)
+void bluetoothTask()
+{
+    if (btRad.isReady())
+        Serial.print(btRad.isReady());
+    btRad.rx();
+}
+
+void telemetryTask()
+{
+    if (!radioReady)
+        return;
+    sendAirbrake = true;
+
+    const double *att = t.getAttitude();
+    double orient[3] = {att[0], att[1], att[2]};
+    APRSTelem aprs = APRSTelem(aprsConfigAvionics, m.getPos().x(), m.getPos().y(), d.getAGLAltFt(), t.getVelocity().z() * 3.28, m.getHeading(), orient, 0);
+
+    aprs.stateFlags.setEncoding(encoding, 3);
+    uint8_t arr[] = {(uint8_t)(int)d.getTemp(), (uint8_t)t.getStage(), (uint8_t)m.getFixQual()};
+    aprs.stateFlags.pack(arr);
+    msgAvionics.encode(&aprs);
+    radio.send(aprs);
+    telemetryTime = millis();
+}
+
+// relays the last airbrake message in the slot 300-400 ms after the avionics telemetry was sent, polled so the slot
+// follows the actual send rather than the telemetry task's release. A slot that was missed is dropped
+void airbrakeTask()
+{
+    if (!radioReady || !sendAirbrake)
+        return;
+    uint32_t sinceTelemetry = millis() - telemetryTime;
+    if (sinceTelemetry < 300)
+        return;
+    sendAirbrake = false;
+    if (sinceTelemetry < 400)
+        radio.tx(msgAirbrake.buf, msgAirbrake.size);
+}
+
+void piTask()
+{
+    if (millis() > 44 * 1000 * 60 && !pi.isOn())
     {
-        avionicsTimer = millis();
-        sendAirbrake = true;
-        // msg.clear();
-
-        double orient[3] = {b.getAngularVelocity().x(), b.getAngularVelocity().y(), b.getAngularVelocity().z()};
-        APRSTelem aprs = APRSTelem(aprsConfigAvionics, m.getPos().x(), m.getPos().y(), d.getAGLAltFt(), t.getVelocity().z() * 3.28, m.getHeading(), orient, 0);
-
-        aprs.stateFlags.setEncoding(encoding, 3);
-        uint8_t arr[] = {(uint8_t)(int)d.getTemp(), (uint8_t)t.getStage(), (uint8_t)m.getFixQual()};
-        aprs.stateFlags.pack(arr);
-        msgAvionics.encode(&aprs);
-        // Serial.print("sending");
-        radio.send(aprs);
-        // Serial.println("sending");
-
-        // Serial.printf("%d %ld\n", d.getTemp(), aprs.stateFlags.get());
-
-        // Serial.printf("%0.3f - Sent APRS Message; %f   |   %d\n", time / 1000.0, d.getAGLAltFt(), m.getFixQual());
-        // bb.aonoff(BUZZER, 50);
-        // Serial.write(msgAvionics.buf, msgAvionics.size);
-        // Serial.write('\n');
+        pi.setOn(true);
     }
-    if (sendAirbrake && millis() - avionicsTimer > 300 && millis() - avionicsTimer < 400 && millis())
+    // if (millis() > 1 * 1000 * 60 && !pi.isRecording())
+    // {
+    //     pi.setRecording(true);
+    // }
+}
+
+#ifdef SCHEDULER_STATS
+// prints how the tasks kept their deadlines, only for bench debugging (build with -DSCHEDULER_STATS)
+void statsTask()
+{
+    scheduler.printStats();
+    scheduler.resetStats();
+}
+#endif
+
+void setup()
+{
+    // releases the radio from reset first, so its power on reset runs during sys.init() and btRad.begin() instead of
+    // after them. Everything else starts in the same order as before
+    radio.startBegin(CONFIG_422Mc80_4GFSK_009600H, sizeof(CONFIG_422Mc80_4GFSK_009600H));
+
+    sys.init();
+    Serial8.begin(115200);
+    Serial2.begin(9600);
+    bb.aonoff(32, *(new BBPattern(200, 1)), true); // blink a status LED (until GPS fix)
+
+    if (btRad.begin())
     {
-        sendAirbrake = false;
-        // double orient[3] = {b.getAngularVelocity().x(), b.getAngularVelocity().y(), b.getAngularVelocity().z()};
-        // APRSTelem aprs = APRSTelem(aprsConfigAirbrake, m.getPos().x(), m.getPos().y(), d.getAGLAltFt(), t.getVelocity().z(), m.getHeading(), orient, 0);
-
-        // aprs.stateFlags.setEncoding(encoding, 3);
-        // uint8_t arr[] = {(uint8_t)(int)d.getTemp(), (uint8_t)t.getStage(), (uint8_t)m.getFixQual()};
-        // aprs.stateFlags.pack(arr);
-        // msgAvionics.encode(&aprs);
-        // radio.send(aprs);
-        radio.tx(msgAirbrake.buf, msgAirbrake.size);
-        // Serial.println("sending");
-        // Serial.println(msgAirbrake.size);
-        // Serial.write(msgAirbrake.buf, msgAirbrake.size);
-        // Serial.println();
-        // msgAirbrake.size = 0;
+        bb.onoff(BUZZER, 500); // 1 x 0.5 sec beep for sucessful initialization
+        getLogger().recordLogData(INFO_, "Initialized Bluetooth");
+    }
+    else
+    {
+        bb.onoff(BUZZER, 1000, 3); // 3 x 2 sec beep for uncessful initialization
+        getLogger().recordLogData(ERROR_, "Initialized Bluetooth Failed");
+    }
+
+    // the rest of radio.begin(), the power on reset has usually finished by now
+    Si4463BeginStage stage;
+    do
+        stage = radio.beginStep();
+    while (stage != BEGIN_DONE && stage != BEGIN_FAILED);
+    radioReady = stage == BEGIN_DONE;
+    if (radioReady)
+    {
+        bb.onoff(BUZZER, 1000);
+        getLogger().recordLogData(INFO_, "Radio initialized.");
+    }
+    else
+    {
+        bb.onoff(BUZZER, 200, 3);
+        getLogger().recordLogData(ERROR_, "Radio failed to initialize.");
     }
 
-    // char str[512];
-    // int i = snprintf(str, 512, "La %.7f Lo %.7f Al %.2f Hd %.2f Ql %d", 1.0, 1.0, 2.0, 360.0, 5);
-    // snprintf(str, 512, "1234567890123456789");
-    // btRad.tx("Hello", 5);
-    // btRad.tx((uint8_t *)str, strlen(str));
-    // Serial.printf("sent %d\n", strlen(str));
+    getLogger().recordLogData(INFO_, "Initialization Complete");
 
-    // /// printf("%f\n", baro1.getAGLAltFt());
+    t.setHighRateEstimator(true);
+    // name, task, period (us), deadline (us), priority, offset (us)
+    scheduler.addTask("Radio", radioTask, 500, 500, 0);
+    scheduler.addTask("Estimator", estimatorTask, 2500, 2500, 1);
+    scheduler.addTask("Sensors", sensorTask, 10000, 10000, 1);
+    scheduler.addTask("Telemetry", telemetryTask, 1000000, 20000, 1);
+    scheduler.addTask("Airbrake Relay", airbrakeTask, 10000, 10000, 1);
+    scheduler.addTask("Bluetooth", bluetoothTask, 10000, 10000, 2);
+    scheduler.addTask("Pi", piTask, 1000000, 1000000, 3);
+#ifdef SCHEDULER_STATS
+    scheduler.addTask("Stats", statsTask, 10000000, 1000000, 3);
+#endif
+}
 
-    radio.update();
-    if (millis() - timeeee > 30)
-        Serial.println(millis() - timeeee);
+void loop()
+{
+    // the motor is stepped on every pass once 3 s have passed, like before the scheduler, not as a task
+    if (millis() - motorTimer > 3000)
+    {
+        int mult = 1;
+        if (motorAngle >= 360)
+            mult = -1;
+        else
+            mult = 1;
+        motorAngle += (mult * 90);
+        Serial8.println(motorAngle);
+    }
+
+    scheduler.update();
 }
 int counter = 0;
 void calcStuff()
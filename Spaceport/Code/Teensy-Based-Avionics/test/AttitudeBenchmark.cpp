@@ -0,0 +1,83 @@
+// Times one AttitudeFilter step, the update and the control input AvionicsState takes from it on every IMU sample, counts
+// its heap activity and compares the worst step with a 5 us target. The target was picked from the estimator period, not
+// measured: this hasn't been run on a Teensy, so whether the filter fits is unverified until the output at the bottom of
+// this file is filled in from one
+// Build and upload with: pio run -e teensy41_ATTITUDE_BENCHMARK -t upload
+
+#include <Arduino.h>
+#include <math.h>
+#include "AttitudeFilter.h"
+#include "BenchUtils.h"
+
+using namespace mmfs;
+
+// 60 s on the pad and 10 s of flight at the estimator rate (400 Hz), a step has to fit in a small part of the 2500 us
+// period
+const int numSteps = 28000;
+const double dt = 0.0025;
+const double target = 5; // us per step, unverified
+
+// sitting on the pad with body -x up, then 2 s of boost and a roll through the coast, the gyro has a constant bias
+void makeSample(int i, double *gyro, double *accel, double *mag)
+{
+    double t = i * dt - 60;
+    double boost = t > 0 && t < 2 ? -70 : 0;
+    double g = t < 0 ? -9.81 : 0;
+    double roll = t > 0 ? 2 : 0;
+    double c = cos(roll * t), s = sin(roll * t);
+    gyro[0] = roll + 0.02 + noise(0.005);
+    gyro[1] = -0.015 + noise(0.005);
+    gyro[2] = 0.01 + noise(0.005);
+    accel[0] = g + boost + noise(0.05);
+    accel[1] = noise(0.05);
+    accel[2] = noise(0.05);
+    mag[0] = -40 + noise(0.5);
+    mag[1] = 20 * c + noise(0.5);
+    mag[2] = -20 * s + noise(0.5);
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    while (!Serial)
+        ;
+
+    enableCycleCounter();
+
+    AttitudeFilter filter;
+    uint32_t startAllocations = allocations;
+    uint32_t total = 0, worst = 0;
+    for (int i = 0; i < numSteps; i++)
+    {
+        double gyro[3], accel[3], mag[3], linear[3];
+        makeSample(i, gyro, accel, mag);
+        uint32_t start = ARM_DWT_CYCCNT;
+        filter.update(dt, gyro, accel, mag);
+        filter.getLinearAcceleration(accel, linear);
+        uint32_t cycles = ARM_DWT_CYCCNT - start;
+        total += cycles;
+        worst = max(worst, cycles);
+    }
+    uint32_t stepAllocations = allocations - startAllocations;
+
+    double mean = (double)total / numSteps / F_CPU_ACTUAL * 1e6;
+    double worstUs = (double)worst / F_CPU_ACTUAL * 1e6;
+    double bias[3], euler[3];
+    filter.getGyroBias(bias);
+    filter.getEuler(euler);
+
+    Serial.printf("%d steps of the attitude filter at %.0f Hz\n", numSteps, 1 / dt);
+    // the bias is learned on the pad, it should hold through the flight
+    Serial.printf("mean %.2f us (%.0f cycles), worst %.2f us (%lu cycles), %lu allocations\n", mean,
+                  (double)total / numSteps, worstUs, (unsigned long)worst, (unsigned long)stepAllocations);
+    Serial.printf("gyro bias %.4f %.4f %.4f rad/s (injected 0.0200 -0.0150 0.0100)\n", bias[0], bias[1], bias[2]);
+    Serial.printf("roll %.1f pitch %.1f yaw %.1f deg\n", euler[0], euler[1], euler[2]);
+    Serial.printf("target %.1f us: %s\n", target, worstUs <= target && stepAllocations == 0 ? "within" : "over");
+}
+
+void loop() {}
+
+/**
+ * Output on a Teensy 4.1 at 600 MHz:
+ * not recorded yet
+ */
@@ -0,0 +1,74 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+// The pieces every benchmark program needs: allocation counting, repeatable noise and the Teensy's cycle counter. Used
+// by test/KFBenchmark.cpp, test/AttitudeBenchmark.cpp and Kalman-Filter/Matrix-Benchmark. It replaces the global new and
+// delete, so only one file of a program can include it.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <new>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// every new/delete in the program goes through these so the allocations made by the code under test can be counted
+static volatile uint32_t allocations = 0;
+static volatile uint32_t allocatedBytes = 0;
+static volatile uint32_t frees = 0;
+
+void *operator new(size_t size)
+{
+    allocations++;
+    allocatedBytes += size;
+    return malloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    allocations++;
+    allocatedBytes += size;
+    return malloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (ptr)
+        frees++;
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    if (ptr)
+        frees++;
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t size) noexcept { operator delete[](ptr); }
+
+// deterministic pseudo random numbers so runs can be compared, returns the next state of the generator
+static uint32_t benchSeed = 1;
+static inline uint32_t benchNext()
+{
+    benchSeed = benchSeed * 1664525 + 1013904223;
+    return benchSeed;
+}
+
+// uniform in [-amplitude, amplitude)
+static inline double noise(double amplitude)
+{
+    return amplitude * ((int32_t)benchNext() / 2147483648.0);
+}
+
+#ifdef ARDUINO
+// the DWT cycle counter (ARM_DWT_CYCCNT) is off by default
+static inline void enableCycleCounter()
+{
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+}
+#endif
+
+#endif // BENCH_UTILS_H
@@ -0,0 +1,195 @@
+// Replays recorded flight logs through FlightEventDetector and prints when it raises each event next to when the flight
+// software that recorded the log changed stage
+// Build and run with: pio run -e native_EVENT_REPLAY && .pio/build/native_EVENT_REPLAY/program 22_FlightData.csv
+// -l <s> sets the apogee lockout after burnout (default 0)
+//
+// Each log is replayed twice:
+// - at the rows of the log, with the IMU and barometer sampled together at whatever rate it was recorded
+// - resampled to the flight rates, IMU at 400 Hz and barometer at 10 Hz, linearly interpolated between rows. This is the
+//   latency the detector has on the board, as far as the log can show it.
+// The apogee reference is the highest barometer altitude in the log.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "FlightEventDetector.h"
+
+using namespace mmfs;
+
+const double imuInterval = 0.0025;
+const double baroInterval = 0.1;
+
+struct FlightLog
+{
+    std::vector<double> time;
+    std::vector<double> stage;
+    std::vector<double> altitude;
+    std::vector<double> accel[3]; // earth frame, what the state update used
+};
+
+// index of the first column whose header contains name, -1 if there isn't one
+int findColumn(const std::vector<std::string> &header, const char *name)
+{
+    for (size_t i = 0; i < header.size(); i++)
+        if (header[i].find(name) != std::string::npos)
+            return (int)i;
+    return -1;
+}
+
+std::vector<std::string> splitLine(const char *line)
+{
+    std::vector<std::string> fields;
+    std::string field;
+    for (const char *c = line; *c && *c != '\n' && *c != '\r'; c++)
+    {
+        if (*c == ',')
+        {
+            fields.push_back(field);
+            field.clear();
+        }
+        else
+            field += *c;
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+bool loadLog(const char *path, FlightLog &log)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    char line[4096];
+    if (!fgets(line, sizeof(line), f))
+    {
+        fclose(f);
+        return false;
+    }
+    std::vector<std::string> header = splitLine(line);
+    int time = findColumn(header, "Time (s)"), stage = findColumn(header, "Stage"),
+        altitude = findColumn(header, "Alt AGL (m)"), ax = findColumn(header, "State - AX"),
+        ay = findColumn(header, "State - AY"), az = findColumn(header, "State - AZ");
+    if (time < 0 || stage < 0 || altitude < 0 || ax < 0 || ay < 0 || az < 0)
+    {
+        fclose(f);
+        return false;
+    }
+
+    int last = 0;
+    for (int column : {time, stage, altitude, ax, ay, az})
+        if (column > last)
+            last = column;
+    while (fgets(line, sizeof(line), f))
+    {
+        std::vector<std::string> row = splitLine(line);
+        if ((int)row.size() <= last)
+            continue; // cut off when the log was closed
+        log.time.push_back(atof(row[time].c_str()));
+        log.stage.push_back(atof(row[stage].c_str()));
+        log.altitude.push_back(atof(row[altitude].c_str()));
+        log.accel[0].push_back(atof(row[ax].c_str()));
+        log.accel[1].push_back(atof(row[ay].c_str()));
+        log.accel[2].push_back(atof(row[az].c_str()));
+    }
+    fclose(f);
+    return log.time.size() > 1;
+}
+
+double interpolate(const std::vector<double> &t, const std::vector<double> &v, size_t i, double time)
+{
+    double f = (time - t[i]) / (t[i + 1] - t[i]);
+    return v[i] + f * (v[i + 1] - v[i]);
+}
+
+void replayRows(const FlightLog &log, FlightEventDetector &detector)
+{
+    for (size_t i = 0; i < log.time.size(); i++)
+    {
+        double a[3] = {log.accel[0][i], log.accel[1][i], log.accel[2][i]};
+        detector.imuSample(log.time[i], a);
+        detector.baroSample(log.time[i], log.altitude[i]);
+    }
+}
+
+void replayResampled(const FlightLog &log, FlightEventDetector &detector)
+{
+    size_t row = 0;
+    double nextBaro = log.time[0];
+    for (double t = log.time[0]; t < log.time.back(); t += imuInterval)
+    {
+        while (log.time[row + 1] < t)
+            row++;
+        double a[3];
+        for (int j = 0; j < 3; j++)
+            a[j] = interpolate(log.time, log.accel[j], row, t);
+        detector.imuSample(t, a);
+        if (t >= nextBaro)
+        {
+            detector.baroSample(t, interpolate(log.time, log.altitude, row, t));
+            nextBaro += baroInterval;
+        }
+    }
+}
+
+// first row at or past stage, NAN if the log never gets there
+double recordedStage(const FlightLog &log, int stage)
+{
+    for (size_t i = 0; i < log.time.size(); i++)
+        if (log.stage[i] >= stage)
+            return log.time[i];
+    return NAN;
+}
+
+void printEvent(const char *name, double recorded, double rows, double resampled, double reference)
+{
+    printf("%-8s %10.3f %10.3f %10.3f", name, recorded, rows, resampled);
+    if (!isnan(reference))
+        printf("   %+7.3f %+7.3f %+7.3f", recorded - reference, rows - reference, resampled - reference);
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    double lockout = 0;
+    int replayed = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-l") && i + 1 < argc)
+        {
+            lockout = atof(argv[++i]);
+            continue;
+        }
+
+        FlightLog log;
+        if (!loadLog(argv[i], log))
+        {
+            printf("%s: couldn't read a flight log\n", argv[i]);
+            continue;
+        }
+        replayed++;
+
+        size_t highest = 0;
+        for (size_t j = 1; j < log.time.size(); j++)
+            if (log.altitude[j] > log.altitude[highest])
+                highest = j;
+        double apogee = log.time[highest];
+
+        FlightEventDetector rows(lockout), resampled(lockout);
+        replayRows(log, rows);
+        replayResampled(log, resampled);
+
+        printf("%s: %d rows from %.3f s to %.3f s, highest barometer altitude %.1f m at %.3f s, apogee lockout %.1f s\n",
+               argv[i], (int)log.time.size(), log.time[0], log.time.back(), log.altitude[highest], apogee, lockout);
+        printf("%-8s %10s %10s %10s   %s\n", "event", "recorded", "log rows", "400/10 Hz", "minus the highest altitude");
+        printEvent("launch", recordedStage(log, 1), rows.getEventTime(FLIGHT_EVENT_LAUNCH),
+                   resampled.getEventTime(FLIGHT_EVENT_LAUNCH), NAN);
+        printEvent("burnout", recordedStage(log, 2), rows.getEventTime(FLIGHT_EVENT_BURNOUT),
+                   resampled.getEventTime(FLIGHT_EVENT_BURNOUT), NAN);
+        printEvent("apogee", recordedStage(log, 3), rows.getEventTime(FLIGHT_EVENT_APOGEE),
+                   resampled.getEventTime(FLIGHT_EVENT_APOGEE), apogee);
+    }
+    return replayed > 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// Times one AvionicsKF step in each mode and counts its heap activity, next to the same filter built on MMFS's heap
+// Matrix LinearKalmanFilter (what AvionicsKF used to be)
+// Build and upload with: pio run -e teensy41_KF_BENCHMARK -t upload
+
+#include <Arduino.h>
+#include <MMFS.h>
+#include "AvionicsKF.h"
+#include "BenchUtils.h"
+
+using namespace mmfs;
+
+// the old AvionicsKF, a new heap Matrix from every getter
+class HeapKF : public LinearKalmanFilter
+{
+public:
+    HeapKF() : LinearKalmanFilter(3, 3, 6) {}
+    void initialize() override {}
+
+    Matrix getF(double dt) override
+    {
+        double *data = new double[36]{
+            1.0, 0, 0, dt, 0, 0,
+            0, 1.0, 0, 0, dt, 0,
+            0, 0, 1.0, 0, 0, dt,
+            0, 0, 0, 1.0, 0, 0,
+            0, 0, 0, 0, 1.0, 0,
+            0, 0, 0, 0, 0, 1.0};
+        return Matrix(6, 6, data);
+    }
+
+    Matrix getG(double dt) override
+    {
+        double *data = new double[18]{
+            0.5 * dt * dt, 0, 0,
+            0, 0.5 * dt * dt, 0,
+            0, 0, 0.5 * dt * dt,
+            dt, 0, 0,
+            0, dt, 0,
+            0, 0, dt};
+        return Matrix(6, 3, data);
+    }
+
+    Matrix getH() override
+    {
+        double *data = new double[18]{
+            1.0, 0, 0, 0, 0, 0,
+            0, 1.0, 0, 0, 0, 0,
+            0, 0, 1.0, 0, 0, 0};
+        return Matrix(3, 6, data);
+    }
+
+    Matrix getR() override
+    {
+        double *data = new double[9]{
+            1.0, 0, 0,
+            0, 1.0, 0,
+            0, 0, 0.5};
+        return Matrix(3, 3, data);
+    }
+
+    Matrix getQ(double dt) override
+    {
+        double *data = new double[36]{
+            0.1, 0, 0, 0, 0, 0,
+            0, 0.1, 0, 0, 0, 0,
+            0, 0, 0.1, 0, 0, 0,
+            0, 0, 0, 0.1, 0, 0,
+            0, 0, 0, 0, 0.1, 0,
+            0, 0, 0, 0, 0, 0.1};
+        return Matrix(6, 6, data);
+    }
+};
+
+// 10 s of a boost/coast profile at 100 Hz
+const int numSteps = 1000;
+const double dt = 0.01;
+
+double measurements[numSteps][3];
+double controls[numSteps][3];
+double heapStates[numSteps][6];
+double fixedStates[numSteps][6];
+double decoupledStates[numSteps][6];
+
+void makeFlight()
+{
+    double p[3] = {0}, v[3] = {0};
+    for (int i = 0; i < numSteps; i++)
+    {
+        double t = i * dt;
+        double a[3] = {0.3, -0.2, t < 2 ? 50.0 : -9.8};
+        for (int j = 0; j < 3; j++)
+        {
+            p[j] += v[j] * dt + 0.5 * a[j] * dt * dt;
+            v[j] += a[j] * dt;
+            controls[i][j] = a[j] + noise(0.5);
+            measurements[i][j] = p[j] + noise(j == 2 ? 1.0 : 3.0);
+        }
+    }
+}
+
+struct BenchResult
+{
+    uint32_t cycles;
+    uint32_t allocations;
+    uint32_t bytes;
+    uint32_t frees;
+};
+
+template <typename Step>
+BenchResult runBench(Step step)
+{
+    uint32_t startAllocations = allocations, startBytes = allocatedBytes, startFrees = frees;
+    uint32_t start = ARM_DWT_CYCCNT;
+    for (int i = 0; i < numSteps; i++)
+        step(i);
+    uint32_t cycles = ARM_DWT_CYCCNT - start;
+    return {cycles, allocations - startAllocations, allocatedBytes - startBytes, frees - startFrees};
+}
+
+void printResult(const char *name, const BenchResult &r)
+{
+    Serial.printf("%-10s %10.2f %10.0f %10.2f %10.1f %10.2f\n", name,
+                  (double)r.cycles / F_CPU_ACTUAL * 1e6 / numSteps, (double)r.cycles / numSteps,
+                  (double)r.allocations / numSteps, (double)r.bytes / numSteps, ((double)r.allocations - r.frees) / numSteps);
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    while (!Serial)
+        ;
+
+    enableCycleCounter();
+
+    makeFlight();
+
+    HeapKF heapKF;
+    double heapState[6] = {0};
+    BenchResult heap = runBench([&](int i)
+                                {
+        double *out = heapKF.iterate(dt, heapState, measurements[i], controls[i]);
+        for (int j = 0; j < 6; j++)
+            heapStates[i][j] = heapState[j] = out[j]; });
+
+    AvionicsKF fixedKF(KF_FULL);
+    double fixedState[6] = {0};
+    BenchResult fixed = runBench([&](int i)
+                                 {
+        fixedKF.iterate(dt, fixedState, measurements[i], controls[i]);
+        for (int j = 0; j < 6; j++)
+            fixedStates[i][j] = fixedState[j]; });
+
+    AvionicsKF decoupledKF(KF_DECOUPLED);
+    double decoupledState[6] = {0};
+    BenchResult decoupled = runBench([&](int i)
+                                     {
+        decoupledKF.iterate(dt, decoupledState, measurements[i], controls[i]);
+        for (int j = 0; j < 6; j++)
+            decoupledStates[i][j] = decoupledState[j]; });
+
+    // every filter should track the heap one to rounding
+    double maxDiff = 0;
+    double maxDecoupledDiff = 0;
+    for (int i = 0; i < numSteps; i++)
+        for (int j = 0; j < 6; j++)
+        {
+            maxDiff = max(maxDiff, fabs(heapStates[i][j] - fixedStates[i][j]));
+            maxDecoupledDiff = max(maxDecoupledDiff, fabs(heapStates[i][j] - decoupledStates[i][j]));
+        }
+
+    Serial.printf("%d steps of the 6 state filter\n", numSteps);
+    Serial.printf("%-10s %10s %10s %10s %10s %10s\n", "filter", "us/step", "cyc/step", "alloc/step", "B/step", "leak/step");
+    printResult("heap", heap);
+    printResult("fixed", fixed);
+    printResult("decoupled", decoupled);
+    Serial.printf("fixed: speedup %.1fx, max state difference %g\n", (double)heap.cycles / fixed.cycles, maxDiff);
+    Serial.printf("decoupled: speedup %.1fx, max state difference %g\n", (double)heap.cycles / decoupled.cycles, maxDecoupledDiff);
+}
+
+void loop() {}
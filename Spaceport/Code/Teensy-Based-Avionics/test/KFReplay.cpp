@@ -0,0 +1,314 @@
+// Replays recorded flight logs through AvionicsKF in both modes and checks them against the heap matrix filter AvionicsKF
+// replaced, exits nonzero if either mode's estimate drifts from it by more than the tolerance on any row
+// Build and run with: pio run -e native_KF_REPLAY && .pio/build/native_KF_REPLAY/program 22_FlightData.csv
+// -t <x> sets the tolerance on the state difference, relative to the state where it is above 1 (default 1e-6)
+//
+// Each row is one iterate() with the time since the previous row as dt, GPS displacement x/y and barometer AGL altitude
+// as the measurement and the logged earth frame acceleration as the control input. MMFS isn't built for the host, so the
+// reference is MMFS's LinearKalmanFilter::iterate() written out step for step on a minimal heap matrix: a new array for
+// every product, an explicit inverse for the gain and the Joseph form covariance update.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AvionicsKF.h"
+
+using namespace mmfs;
+
+// the operations of mmfs::Matrix that LinearKalmanFilter uses, every result is a new heap array
+class HeapMatrix
+{
+public:
+    HeapMatrix(int rows, int cols) : rows(rows), cols(cols), data(new double[rows * cols]()) {}
+    HeapMatrix(const HeapMatrix &other) : HeapMatrix(other.rows, other.cols)
+    {
+        memcpy(data, other.data, sizeof(double) * rows * cols);
+    }
+    HeapMatrix &operator=(const HeapMatrix &other)
+    {
+        HeapMatrix copy(other);
+        std::swap(rows, copy.rows);
+        std::swap(cols, copy.cols);
+        std::swap(data, copy.data);
+        return *this;
+    }
+    ~HeapMatrix() { delete[] data; }
+
+    static HeapMatrix ident(int n)
+    {
+        HeapMatrix m(n, n);
+        for (int i = 0; i < n; i++)
+            m(i, i) = 1;
+        return m;
+    }
+
+    double &operator()(int r, int c) { return data[r * cols + c]; }
+    double operator()(int r, int c) const { return data[r * cols + c]; }
+
+    HeapMatrix operator*(const HeapMatrix &other) const
+    {
+        HeapMatrix out(rows, other.cols);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < other.cols; j++)
+                for (int k = 0; k < cols; k++)
+                    out(i, j) += (*this)(i, k) * other(k, j);
+        return out;
+    }
+
+    HeapMatrix operator+(const HeapMatrix &other) const
+    {
+        HeapMatrix out(rows, cols);
+        for (int i = 0; i < rows * cols; i++)
+            out.data[i] = data[i] + other.data[i];
+        return out;
+    }
+
+    HeapMatrix operator-(const HeapMatrix &other) const
+    {
+        HeapMatrix out(rows, cols);
+        for (int i = 0; i < rows * cols; i++)
+            out.data[i] = data[i] - other.data[i];
+        return out;
+    }
+
+    HeapMatrix T() const
+    {
+        HeapMatrix out(cols, rows);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                out(j, i) = (*this)(i, j);
+        return out;
+    }
+
+    // Gauss-Jordan with partial pivoting
+    HeapMatrix inverse() const
+    {
+        HeapMatrix a(*this);
+        HeapMatrix inv = ident(rows);
+        for (int c = 0; c < rows; c++)
+        {
+            int pivot = c;
+            for (int r = c + 1; r < rows; r++)
+                if (fabs(a(r, c)) > fabs(a(pivot, c)))
+                    pivot = r;
+            for (int j = 0; j < cols; j++)
+            {
+                std::swap(a(c, j), a(pivot, j));
+                std::swap(inv(c, j), inv(pivot, j));
+            }
+            double d = a(c, c);
+            for (int j = 0; j < cols; j++)
+            {
+                a(c, j) /= d;
+                inv(c, j) /= d;
+            }
+            for (int r = 0; r < rows; r++)
+            {
+                if (r == c)
+                    continue;
+                double f = a(r, c);
+                for (int j = 0; j < cols; j++)
+                {
+                    a(r, j) -= f * a(c, j);
+                    inv(r, j) -= f * inv(c, j);
+                }
+            }
+        }
+        return inv;
+    }
+
+    int rows, cols;
+    double *data;
+};
+
+// the old AvionicsKF on LinearKalmanFilter, the same matrices as KFBenchmark's HeapKF
+class HeapKF
+{
+public:
+    HeapKF() : X(6, 1), P(HeapMatrix::ident(6)) {}
+
+    void iterate(double dt, double *state, const double *measurement, const double *control)
+    {
+        HeapMatrix F = HeapMatrix::ident(6), G(6, 3), H(3, 6), R(3, 3), Q(6, 6), U(3, 1), Z(3, 1);
+        for (int i = 0; i < 3; i++)
+        {
+            F(i, i + 3) = dt;
+            G(i, i) = 0.5 * dt * dt;
+            G(i + 3, i) = dt;
+            H(i, i) = 1.0;
+            R(i, i) = i == 2 ? 0.5 : 1.0;
+            U(i, 0) = control[i];
+            Z(i, 0) = measurement[i];
+        }
+        for (int i = 0; i < 6; i++)
+        {
+            Q(i, i) = 0.1;
+            X(i, 0) = state[i];
+        }
+
+        X = F * X + G * U;
+        P = F * P * F.T() + Q;
+        HeapMatrix K = P * H.T() * (H * P * H.T() + R).inverse();
+        X = X + K * (Z - H * X);
+        HeapMatrix I = HeapMatrix::ident(6);
+        P = (I - K * H) * P * (I - K * H).T() + K * R * K.T();
+
+        for (int i = 0; i < 6; i++)
+            state[i] = X(i, 0);
+    }
+
+private:
+    HeapMatrix X;
+    HeapMatrix P;
+};
+
+struct FlightLog
+{
+    std::vector<double> time;
+    std::vector<double> position[3]; // GPS x/y displacement and barometer AGL altitude
+    std::vector<double> accel[3];    // earth frame, what the state update used
+};
+
+// index of the first column whose header contains name, -1 if there isn't one
+int findColumn(const std::vector<std::string> &header, const char *name)
+{
+    for (size_t i = 0; i < header.size(); i++)
+        if (header[i].find(name) != std::string::npos)
+            return (int)i;
+    return -1;
+}
+
+std::vector<std::string> splitLine(const char *line)
+{
+    std::vector<std::string> fields;
+    std::string field;
+    for (const char *c = line; *c && *c != '\n' && *c != '\r'; c++)
+    {
+        if (*c == ',')
+        {
+            fields.push_back(field);
+            field.clear();
+        }
+        else
+            field += *c;
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+bool loadLog(const char *path, FlightLog &log)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    char line[4096];
+    if (!fgets(line, sizeof(line), f))
+    {
+        fclose(f);
+        return false;
+    }
+    std::vector<std::string> header = splitLine(line);
+    int columns[7] = {findColumn(header, "Time (s)"), findColumn(header, "Disp X (m)"), findColumn(header, "Disp Y (m)"),
+                      findColumn(header, "Alt AGL (m)"), findColumn(header, "State - AX"),
+                      findColumn(header, "State - AY"), findColumn(header, "State - AZ")};
+    int last = 0;
+    for (int column : columns)
+    {
+        if (column < 0)
+        {
+            fclose(f);
+            return false;
+        }
+        if (column > last)
+            last = column;
+    }
+
+    while (fgets(line, sizeof(line), f))
+    {
+        std::vector<std::string> row = splitLine(line);
+        if ((int)row.size() <= last)
+            continue; // cut off when the log was closed
+        log.time.push_back(atof(row[columns[0]].c_str()));
+        for (int j = 0; j < 3; j++)
+        {
+            log.position[j].push_back(atof(row[columns[1 + j]].c_str()));
+            log.accel[j].push_back(atof(row[columns[4 + j]].c_str()));
+        }
+    }
+    fclose(f);
+    return log.time.size() > 1;
+}
+
+int main(int argc, char **argv)
+{
+    double tolerance = 1e-6;
+    int replayed = 0;
+    bool failed = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+        {
+            tolerance = atof(argv[++i]);
+            continue;
+        }
+
+        FlightLog log;
+        if (!loadLog(argv[i], log))
+        {
+            printf("%s: couldn't read a flight log\n", argv[i]);
+            failed = true;
+            continue;
+        }
+        replayed++;
+
+        HeapKF heapKF;
+        AvionicsKF fullKF(KF_FULL), decoupledKF(KF_DECOUPLED);
+        double heapState[6] = {0}, fullState[6] = {0}, decoupledState[6] = {0};
+        double fullDiff = 0, decoupledDiff = 0;
+        size_t fullRow = 0, decoupledRow = 0;
+        for (size_t j = 1; j < log.time.size(); j++)
+        {
+            double dt = log.time[j] - log.time[j - 1];
+            double z[3] = {log.position[0][j], log.position[1][j], log.position[2][j]};
+            double u[3] = {log.accel[0][j], log.accel[1][j], log.accel[2][j]};
+            heapKF.iterate(dt, heapState, z, u);
+            fullKF.iterate(dt, fullState, z, u);
+            decoupledKF.iterate(dt, decoupledState, z, u);
+
+            // relative to the size of the state so a long flight doesn't need a looser tolerance, NAN fails too
+            for (int k = 0; k < 6; k++)
+            {
+                double scale = fmax(1.0, fabs(heapState[k]));
+                double full = fabs(fullState[k] - heapState[k]) / scale;
+                double decoupled = fabs(decoupledState[k] - heapState[k]) / scale;
+                if (!(full <= fullDiff))
+                {
+                    fullDiff = isnan(full) ? INFINITY : full;
+                    fullRow = j;
+                }
+                if (!(decoupled <= decoupledDiff))
+                {
+                    decoupledDiff = isnan(decoupled) ? INFINITY : decoupled;
+                    decoupledRow = j;
+                }
+            }
+        }
+
+        bool fullOk = fullDiff <= tolerance, decoupledOk = decoupledDiff <= tolerance;
+        failed |= !fullOk || !decoupledOk;
+        printf("%s: %d rows from %.3f s to %.3f s, final heap state p (%.2f, %.2f, %.2f) m v (%.2f, %.2f, %.2f) m/s\n",
+               argv[i], (int)log.time.size(), log.time[0], log.time.back(), heapState[0], heapState[1], heapState[2],
+               heapState[3], heapState[4], heapState[5]);
+        printf("%-10s %12s %10s %6s\n", "mode", "max diff", "at (s)", "");
+        printf("%-10s %12.3g %10.3f %6s\n", "full", fullDiff, log.time[fullRow], fullOk ? "ok" : "FAIL");
+        printf("%-10s %12.3g %10.3f %6s\n", "decoupled", decoupledDiff, log.time[decoupledRow], decoupledOk ? "ok" : "FAIL");
+    }
+    if (replayed == 0)
+        return 1;
+    printf("%s, tolerance %g\n", failed ? "FAILED" : "passed", tolerance);
+    return failed ? 1 : 0;
+}
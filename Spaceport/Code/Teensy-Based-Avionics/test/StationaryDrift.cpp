@@ -0,0 +1,107 @@
+// Feeds a stationary, tilted IMU through AttitudeFilter and AvionicsKF the way AvionicsState::updateEstimator() does and
+// checks that the position filter doesn't drift, exits nonzero if it does
+// Build and run with: pio run -e native_STATIONARY_DRIFT && .pio/build/native_STATIONARY_DRIFT/program
+//
+// Only predict() runs, no GPS or barometer, so anything left in the control input integrates straight into the
+// estimate. The IMU sits at roll 20, pitch -35, yaw 70 degrees at 400 Hz with noise on every axis:
+// - for the first 10 s the accelerometer reads 15% high, outside the attitude filter's gate, so it never aligns
+// - then it reads 1 g and the filter aligns on the first sample
+// Before alignment the control input has to be exactly zero. After it the estimate may only wander by the noise.
+
+#include <math.h>
+#include <stdio.h>
+#include "AttitudeFilter.h"
+#include "AvionicsKF.h"
+#include "BenchUtils.h"
+
+using namespace mmfs;
+
+const double dt = 0.0025;
+const double unalignedTime = 10;
+const double alignedTime = 60;
+
+// limits on |position| and |velocity| at the end of each phase
+const double unalignedLimit = 1e-9;
+const double alignedPositionLimit = 1.0;   // m
+const double alignedVelocityLimit = 0.05;  // m/s
+
+// body to earth (x east, y north, z up) for roll, pitch, yaw in degrees, ZYX like AttitudeFilter::getEuler()
+void rotation(double roll, double pitch, double yaw, double r[3][3])
+{
+    double cr = cos(roll * M_PI / 180), sr = sin(roll * M_PI / 180);
+    double cp = cos(pitch * M_PI / 180), sp = sin(pitch * M_PI / 180);
+    double cy = cos(yaw * M_PI / 180), sy = sin(yaw * M_PI / 180);
+    double m[3][3] = {{cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+                      {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+                      {-sp, cp * sr, cp * cr}};
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            r[i][j] = m[i][j];
+}
+
+bool check(const char *phase, const double *state, double positionLimit, double velocityLimit)
+{
+    double p = sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+    double v = sqrt(state[3] * state[3] + state[4] * state[4] + state[5] * state[5]);
+    bool ok = p <= positionLimit && v <= velocityLimit;
+    printf("%-10s p (%8.4f, %8.4f, %8.4f) m  v (%7.4f, %7.4f, %7.4f) m/s  |p| %.3g  |v| %.3g  %s\n", phase, state[0],
+           state[1], state[2], state[3], state[4], state[5], p, v, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main()
+{
+    double r[3][3];
+    rotation(20, -35, 70, r);
+    const double gravity[3] = {0, 0, AttitudeFilter::GRAVITY};
+    const double field[3] = {0, 20, -45}; // uT, north and down
+    double accel[3] = {0}, mag[3] = {0};
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+        {
+            accel[i] += r[j][i] * gravity[j];
+            mag[i] += r[j][i] * field[j];
+        }
+
+    AttitudeFilter af;
+    AvionicsKF kf;
+    double state[AvionicsKF::STATE_SIZE] = {0};
+    bool ok = true;
+    bool wasAligned = false;
+    int steps = (int)((unalignedTime + alignedTime) / dt);
+    for (int i = 0; i < steps; i++)
+    {
+        double scale = i * dt < unalignedTime ? 1.15 : 1.0;
+        double g[3], a[3], m[3];
+        for (int j = 0; j < 3; j++)
+        {
+            g[j] = noise(0.01);
+            a[j] = accel[j] * scale + noise(0.05);
+            m[j] = mag[j] + noise(0.5);
+        }
+
+        af.update(dt, g, a, m);
+        if (!wasAligned && af.isAligned())
+        {
+            wasAligned = true;
+            ok &= check("unaligned", state, unalignedLimit, unalignedLimit);
+        }
+
+        // AvionicsState::controlInput(), east/north into the GPS displacement's north/east
+        double earth[3], inputs[AvionicsKF::CTRL_SIZE];
+        af.getLinearAcceleration(a, earth);
+        inputs[0] = earth[1];
+        inputs[1] = earth[0];
+        inputs[2] = earth[2];
+        kf.predict(dt, state, inputs);
+    }
+    if (!wasAligned)
+    {
+        printf("the attitude filter never aligned\n");
+        ok = false;
+    }
+    ok &= check("aligned", state, alignedPositionLimit, alignedVelocityLimit);
+
+    printf("%s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}